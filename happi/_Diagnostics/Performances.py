@@ -52,6 +52,35 @@ def LinXYCurveMatrix2D(n, oversize=0):
 	A[o:-o, o:-o] = np.arange(n[0]*n[1]).reshape(n[0],n[1]).T
 	return A
 
+# Method to create a matrix containing the hindex of a 2D recursive coordinate bisection
+def RCBCurveMatrix2D(n, ncels, oversize=0):
+	import numpy as np
+	o = oversize
+	m = [int(np.log2(ni)) for ni in n]
+	# Sequence of cuts, as in RCBDomainDecomposition: each one halves the longest side (in cells)
+	length = [float(c) for c in ncels]
+	remaining = list(m)
+	cuts = []
+	while True:
+		longest = -1
+		for i in range(2):
+			if remaining[i] > 0 and (longest < 0 or length[i] > length[longest]):
+				longest = i
+		if longest < 0: break
+		cuts.append(longest)
+		length[longest] *= 0.5
+		remaining[longest] -= 1
+	# The bits of the coordinates, from the most significant, in the order of the cuts
+	coordinates = np.meshgrid(np.arange(n[0]), np.arange(n[1]))
+	bit = list(m)
+	index = np.zeros((n[1], n[0]), dtype="int64")
+	for i in cuts:
+		bit[i] -= 1
+		index = (index << 1) | ((coordinates[i] >> bit[i]) & 1)
+	A = np.zeros((n[1]+2*o, n[0]+2*o), dtype="uint32")
+	A[o:o+n[1], o:o+n[0]] = index
+	return A
+
 # Method to partition a matrix depending on a list of values
 def PartitionMatrix( matrix, listOfValues, oversize=0 ):
 	import numpy as np
@@ -369,6 +398,8 @@ class Performances(Diagnostic):
 						self._curvematrix = LinXYCurveMatrix2D(self._number_of_patches, oversize=1)
 					elif self.patch_arrangement == 'linearized_YX':
 						self._curvematrix = LinYXCurveMatrix2D(self._number_of_patches, oversize=1)
+					elif self.patch_arrangement == 'rcb':
+						self._curvematrix = RCBCurveMatrix2D(self._number_of_patches, self._ncels, oversize=1)
 					else:
 						print("Error: patch arrangement "+str(self.patch_arrangement)+" not implemented")
 						return []
@@ -52,7 +52,7 @@ class TrackParticles(ParticleList):
 		# -------------------------------------------------------------------
 		self.species  = species
 		self._h5items = {}
-		disorderedfiles = self._findFiles("TrackParticlesDisordered")
+		disorderedfiles = self._findDisorderedFiles()
 		
 		# Get x_moved and add moving_x in the list of properties
 		self._maxAvailableTime = 0
@@ -202,6 +202,73 @@ class TrackParticles(ParticleList):
 				+"Remove or backup the following file: " + orderedfile)
 		return False
 	
+	# Get the list of disordered files in all paths. An output with `layout="append"`
+	# is presented as a disordered file made of virtual datasets (see _appendView)
+	def _findDisorderedFiles(self):
+		files = []
+		pattern = self._re.compile("^TrackParticlesAppend_"+self._re.escape(self.species)+r"_\d+\.h5$")
+		for path in self._results_path:
+			file = path+self._os.sep+"TrackParticlesDisordered_"+self.species+".h5"
+			if self._os.path.isfile(file):
+				files += [file]
+				continue
+			appendfiles = [f for f in self._glob(path+self._os.sep+"TrackParticlesAppend_*.h5") if pattern.match(self._os.path.basename(f))]
+			if appendfiles:
+				files += [self._appendView(path, appendfiles)]
+		if not files:
+			raise Exception("No files TrackParticlesDisordered or TrackParticlesAppend found")
+		return files
+	
+	# Make a file with the same structure as TrackParticlesDisordered, where each iteration
+	# contains virtual datasets pointing to its records in the TrackParticlesAppend files.
+	# No data is copied, and the view is only rebuilt when new records have been appended.
+	def _appendView(self, path, appendfiles):
+		view = path+self._os.sep+"TrackParticlesAppendView_"+self.species+".h5"
+		if self._os.path.isfile(view) and self._os.path.getmtime(view) >= max(self._os.path.getmtime(f) for f in appendfiles):
+			return view
+		sources = [self._h5py.File(f, "r") for f in appendfiles]
+		try:
+			nfiles = sources[0].attrs["number_of_files"]
+			if len(sources) != nfiles:
+				raise Exception("Found "+str(len(sources))+" TrackParticlesAppend files for species "+self.species+" instead of "+str(nfiles)+" in "+path)
+			sources.sort(key=lambda f: f.attrs["first_rank"])
+			# Read the index of each file. Only the iterations written in all files are kept.
+			iteration_npart = [f["iteration_npart"][()] for f in sources]
+			ntimes = min(len(index) for index in iteration_npart)
+			latest_IDs = self._np.hstack([f["latest_IDs"][:ntimes] for f in sources])
+			x_moved = sources[0]["x_moved"][:ntimes]
+			# List the datasets of the particle properties
+			species_path = "data/0/particles/"+self.species
+			datasets = []
+			sources[0][species_path].visititems(lambda name, obj: datasets.append(name) if isinstance(obj, self._h5py.Dataset) else None)
+			with self._h5py.File(view, "w") as v:
+				for it in range(ntimes):
+					last = [index[it,1] for index in iteration_npart]
+					first = [index[it-1,1] if it>0 else 0 for index in iteration_npart]
+					npart = sum(last) - sum(first)
+					iteration = v.create_group("data/%010i"%iteration_npart[0][it,0])
+					iteration.attrs["x_moved"] = x_moved[it]
+					iteration.create_dataset("latest_IDs", data=latest_IDs[it])
+					group = iteration.create_group("particles/"+self.species)
+					for name in datasets:
+						dtype = sources[0][species_path+"/"+name].dtype
+						if npart == 0:
+							group.create_dataset(name, (0,), dtype)
+							continue
+						layout = self._h5py.VirtualLayout((npart,), dtype)
+						start = 0
+						for f, s, e in zip(sources, first, last):
+							if e > s:
+								# Source files are given relative to the view, so that the results can be moved
+								source = self._h5py.VirtualSource(self._os.path.basename(f.filename), species_path+"/"+name, shape=f[species_path+"/"+name].shape)
+								layout[start:start+e-s] = source[s:e]
+								start += e-s
+						group.create_virtual_dataset(name, layout)
+		finally:
+			for f in sources:
+				f.close()
+		return view
+	
 	def _selectParticles( self, select, already_sorted, chunksize ):
 		if type(select) is str:
 			# Parse the selector
@@ -635,7 +702,7 @@ class TrackParticles(ParticleList):
 		properties = {"moving_x":"x"}
 		properties.update( self._raw_properties_from_short )
 
-		disorderedfiles = self._findFiles("TrackParticlesDisordered")
+		disorderedfiles = self._findDisorderedFiles()
 		for file in disorderedfiles:
 			f = self._h5py.File(file, "r")
 			# This is the timestep for which we want to produce an iterator
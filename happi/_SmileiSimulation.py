@@ -312,7 +312,13 @@ class SmileiSimulation(object):
 	
 	def getTrackSpecies(self):
 		""" List the available tracked species """
-		return self._getParticleListSpecies("TrackParticlesDisordered")
+		species = self._getParticleListSpecies("TrackParticlesDisordered")
+		# Files of the append layout are numbered: TrackParticlesAppend_<species>_<number>.h5
+		for path in self._results_path:
+			for file in self._glob(path+self._os.sep+"TrackParticlesAppend_*.h5"):
+				s = self._re.search(r"^TrackParticlesAppend_(.+)_\d+\.h5$",self._os.path.basename(file))
+				if s: species += [ s.groups()[0] ]
+		return list(set(species))
 	
 	def getNewParticlesSpecies(self):
 		""" List the available NewParticles species """
@@ -9,6 +9,13 @@
 #include <sstream>
 #include <iomanip>
 #include <string>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <limits>
 
 #include <mpi.h>
 
@@ -52,7 +59,11 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
     keep_n_dumps( 2 ),
     keep_n_dumps_max( 10000 ),
     dump_deflate( 0 ),
-    file_grouping( 0 )
+    file_grouping( 0 ),
+    asynchronous_( false ),
+    write_failed_( false ),
+    restart_size_( 0 ),
+    restart_file_grouping_( 0 )
 {
 
     if( PyTools::nComponents( "Checkpoints" ) > 0 ) {
@@ -80,6 +91,15 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
         PyTools::extract( "exit_after_dump", exit_after_dump, "Checkpoints"  );
 
         PyTools::extract( "dump_deflate", dump_deflate, "Checkpoints"  );
+        if( dump_deflate > 0 ) {
+            if( ! H5Zfilter_avail( H5Z_FILTER_DEFLATE ) ) {
+                WARNING( "HDF5 has no deflate filter: dump_deflate ignored" );
+                dump_deflate = 0;
+            } else {
+                dump_deflate = min( dump_deflate, 9 );
+                MESSAGE( 1, "Particles will be compressed in the checkpoints (deflate level " << dump_deflate << ")" );
+            }
+        }
 
         PyTools::extract( "file_grouping", file_grouping, "Checkpoints"  );
         if( file_grouping > 0 ) {
@@ -89,6 +109,16 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
             MESSAGE( 1, "Code will group checkpoint files by "<< file_grouping );
         }
 
+        PyTools::extract( "asynchronous", asynchronous_, "Checkpoints"  );
+        if( asynchronous_ ) {
+            MESSAGE( 1, "Checkpoint files will be written in the background" );
+        }
+
+        PyTools::extractOrNone( "local_dir", local_dir_, "Checkpoints"  );
+        if( ! local_dir_.empty() ) {
+            MESSAGE( 1, "Checkpoint files will be written to " << local_dir_ << ", then copied in the background" );
+        }
+
         smpi->barrier();
 
         if( params.restart ) {
@@ -97,26 +127,59 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
                 ERROR( "Internal parameter `restart_files` not understood. This should not happen" );
             }
 
+            PyTools::extractOrNone( "restart_dir", restart_dir_, "Checkpoints"  );
+
             // This will open all dumps and pick the last one
-            restart_file = "";
+            vector<int> steps( restart_files.size(), -1 );
             for( unsigned int num_dump=0; num_dump<restart_files.size(); num_dump++ ) {
-                string dump_name = restart_files[num_dump];
-                H5Read f( dump_name, NULL, false );
+                H5Read f( restart_files[num_dump], NULL, false );
                 if( f.valid() ) {
-                    unsigned int dump_step = 0;
-                    f.attr( "dump_step", dump_step );
-                    if( dump_step > this_run_start_step ) {
-                        this_run_start_step = dump_step;
-                        restart_file = dump_name;
-                        dump_number = num_dump;
-                        f.attr( "dump_number", dump_number );
+                    // The files of rank 0 are also given to the other ranks: they are only valid for
+                    // the ranks which did not exist in the dumping run, which have no file of their own.
+                    // The files of these ranks left by an older run with more processes are ignored.
+                    vector<int> patch_count;
+                    f.vect( "patch_count", patch_count, true );
+                    const string &name = restart_files[num_dump];
+                    int file_rank = stoi( name.substr( name.rfind( '-' ) + 1 ) );
+                    bool own_file = ( file_rank == smpi->getRank() );
+                    if( own_file == ( smpi->getRank() < ( int ) patch_count.size() ) ) {
+                        unsigned int dump_step = 0;
+                        f.attr( "dump_step", dump_step );
+                        steps[num_dump] = dump_step;
                     }
                 }
             }
 
-            if( restart_file == "" ) {
+            // The files may come from two tiers (see local_dir), which the interruption of the
+            // run may have left incomplete: the newest dump found by all processes is selected
+            int selected_step = numeric_limits<int>::max();
+            int selected_dump = -1;
+            while( true ) {
+                int newest_step = -1;
+                for( unsigned int num_dump=0; num_dump<steps.size(); num_dump++ ) {
+                    if( steps[num_dump] <= selected_step && steps[num_dump] > newest_step ) {
+                        newest_step = steps[num_dump];
+                        selected_dump = num_dump;
+                    }
+                }
+                int common_step = newest_step;
+                if( ! smpi->test_mode ) {
+                    MPI_Allreduce( &newest_step, &common_step, 1, MPI_INT, MPI_MIN, smpi->world() );
+                }
+                if( common_step == selected_step || common_step < 0 ) {
+                    selected_step = common_step;
+                    break;
+                }
+                selected_step = common_step;
+            }
+
+            if( selected_step < 0 ) {
                 ERROR( "Cannot find a valid restart file for rank "<<smpi->getRank() );
             }
+            this_run_start_step = selected_step;
+            restart_file = restart_files[selected_dump];
+            H5Read f( restart_file );
+            f.attr( "dump_number", dump_number );
 
             // Make sure all ranks have the same dump number
             // Different numbers can be due to corrupted restart files
@@ -180,7 +243,12 @@ Checkpoint::Checkpoint( Params &params, SmileiMPI *smpi ) :
     nDim_particle=params.nDim_particle;
 }
 
-Checkpoint::~Checkpoint() {}
+Checkpoint::~Checkpoint()
+{
+    if( writer_.joinable() ) {
+        writer_.join();
+    }
+}
 
 void Checkpoint::dump( VectorPatch &vecPatches, Region &region, unsigned int itime, SmileiMPI *smpi, SimWindow *simWindow, Params &params )
 {
@@ -201,6 +269,9 @@ void Checkpoint::dump( VectorPatch &vecPatches, Region &region, unsigned int iti
     
     if( signal_received != 0 || dump_now ) {
         dumpAll( vecPatches, region, itime,  smpi, simWindow, params );
+        if( asynchronous_ || ! local_dir_.empty() ) {
+            writer_ = std::thread( &Checkpoint::writeInBackground, this );
+        }
         if( exit_after_dump || ( ( signal_received!=0 ) && ( signal_received != SIGUSR2 ) ) ) {
             exit_asap = true;
         }
@@ -211,6 +282,11 @@ void Checkpoint::dump( VectorPatch &vecPatches, Region &region, unsigned int iti
 
 void Checkpoint::dumpAll( VectorPatch &vecPatches, Region &region, unsigned int itime,  SmileiMPI *smpi, SimWindow *simWin,  Params &params )
 {
+    // The previous dump may be written to the same file
+    waitDump();
+    // Fields may still be written in the background
+    vecPatches.waitAllDiagsWrite();
+
     unsigned int num_dump=dump_number % keep_n_dumps;
 
     ostringstream nameDumpTmp( "" );
@@ -222,8 +298,17 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, Region &region, unsigned int
     nameDumpTmp << "dump-" << setfill( '0' ) << setw( 5 ) << num_dump << "-" << setfill( '0' ) << setw( 10 ) << smpi->getRank() << ".h5" ;
     std::string dumpName=nameDumpTmp.str();
 
+    // With a node-local directory, the file written there is copied to dumpName by a separate thread
+    image_name_ = local_dir_.empty() ? dumpName : local_dir_ + PATH_SEPARATOR + dumpName;
+    drain_name_ = local_dir_.empty() ? "" : dumpName;
+    // The files finished in the background are written under another name, then renamed:
+    // an incomplete file is never taken for a checkpoint
+    bool background = asynchronous_ || ! local_dir_.empty();
 
-    H5Write f( dumpName );
+    H5Write f( background ? image_name_ + ".tmp" : image_name_, NULL, true, asynchronous_ );
+    if( dump_deflate > 0 ) {
+        f.allowFormatV110();
+    }
     dump_number++;
 
 #ifdef  __DEBUG
@@ -252,6 +337,8 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, Region &region, unsigned int
     f.attr( "dump_number", dump_number );
 
     f.vect( "patch_count", smpi->patch_count );
+    f.attr( "patch_arrangement", params.patch_arrangement );
+    f.attr( "file_grouping", file_grouping );
 
     // Write diags scalar data
     DiagnosticScalar *scalars = static_cast<DiagnosticScalar *>( vecPatches.globalDiags[0] );
@@ -329,6 +416,47 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, Region &region, unsigned int
         dumpMovingWindow( f, simWin );
     }
 
+    // Asynchronous mode: the file built in memory is written by another thread
+    if( asynchronous_ ) {
+        f.image( image_ );
+    }
+
+}
+
+
+void Checkpoint::writeInBackground()
+{
+    string tmp_name = image_name_ + ".tmp";
+    write_failed_ = false;
+    if( asynchronous_ ) {
+        ofstream file( tmp_name, ios::binary | ios::trunc );
+        file.write( image_.data(), image_.size() );
+        file.close();
+        write_failed_ = file.fail();
+        vector<char>().swap( image_ );
+    }
+    write_failed_ = write_failed_ || rename( tmp_name.c_str(), image_name_.c_str() ) != 0;
+
+    // Copy the local file to the shared directory
+    if( ! write_failed_ && ! drain_name_.empty() ) {
+        string drain_tmp_name = drain_name_ + ".tmp";
+        ifstream in( image_name_, ios::binary );
+        ofstream out( drain_tmp_name, ios::binary | ios::trunc );
+        out << in.rdbuf();
+        out.close();
+        write_failed_ = out.fail() || rename( drain_tmp_name.c_str(), drain_name_.c_str() ) != 0;
+    }
+}
+
+
+void Checkpoint::waitDump()
+{
+    if( writer_.joinable() ) {
+        writer_.join();
+        if( write_failed_ ) {
+            ERROR( "Cannot write checkpoint file " << ( drain_name_.empty() ? image_name_ : drain_name_ ) );
+        }
+    }
 }
 
 
@@ -586,7 +714,7 @@ void Checkpoint::dumpPatch( Patch *patch, Params &params, H5Write &g )
 };
 
 
-void Checkpoint::readPatchDistribution( SmileiMPI *smpi, SimWindow *simWin )
+void Checkpoint::readPatchDistribution( SmileiMPI *smpi, SimWindow *simWin, Params &params )
 {
     H5Read f( restart_file );
 
@@ -599,9 +727,69 @@ void Checkpoint::readPatchDistribution( SmileiMPI *smpi, SimWindow *simWin )
         WARNING( "                while running version is " << string( __VERSION ) );
     }
 
-    vector<int> patch_count( smpi->getSize() );
-    f.vect( "patch_count", patch_count );
-    smpi->patch_count = patch_count;
+    // The patches are stored by index: their ordering must not change
+    if( f.hasAttr( "patch_arrangement" ) ) {
+        string patch_arrangement;
+        f.attr( "patch_arrangement", patch_arrangement );
+        if( patch_arrangement != params.patch_arrangement ) {
+            ERROR( "Restart with patch_arrangement = " << params.patch_arrangement << " from checkpoints written with " << patch_arrangement );
+        }
+    }
+
+    vector<int> patch_count;
+    f.vect( "patch_count", patch_count, true );
+    restart_size_ = patch_count.size();
+
+    if( restart_size_ == smpi->getSize() ) {
+        smpi->patch_count = patch_count;
+    } else {
+        // Elastic restart: the patches dumped by restart_size_ processes are distributed
+        // over the current ones. Each process of the previous run had about the same load,
+        // shared by its patches: the patches of the processes which had many of them are
+        // considered cheaper. The load balancing, if any, refines this distribution.
+        if( params.multiple_decomposition ) {
+            ERROR( "Restart with " << smpi->getSize() << " MPI processes from checkpoints written by " << restart_size_ << " processes is not supported with MultipleDecomposition" );
+        }
+        int size = smpi->getSize();
+        restart_refHindexes_.resize( restart_size_+1, 0 );
+        for( int rk=0 ; rk<restart_size_ ; rk++ ) {
+            restart_refHindexes_[rk+1] = restart_refHindexes_[rk] + patch_count[rk];
+        }
+        unsigned int npatches = restart_refHindexes_.back();
+        if( npatches < ( unsigned int ) size ) {
+            ERROR( "Restart with " << size << " MPI processes: only " << npatches << " patches" );
+        }
+        if( f.hasAttr( "file_grouping" ) ) {
+            f.attr( "file_grouping", restart_file_grouping_ );
+        } else {
+            restart_file_grouping_ = min( file_grouping, ( unsigned int ) restart_size_ );
+        }
+
+        smpi->patch_count.resize( size );
+        double target = ( double ) restart_size_ / ( double ) size;
+        double load = 0.;
+        unsigned int hindex = 0;
+        int previous_rank = 0;
+        for( int rk=0 ; rk<size ; rk++ ) {
+            // Keep at least one patch for each of the next processes
+            unsigned int last = npatches - ( size-1-rk );
+            int count = 0;
+            while( hindex < last ) {
+                while( hindex >= restart_refHindexes_[previous_rank+1] ) {
+                    previous_rank++;
+                }
+                double patch_load = 1. / ( double ) patch_count[previous_rank];
+                if( count > 0 && rk < size-1 && load + 0.5 * patch_load > ( rk+1 ) * target ) {
+                    break;
+                }
+                load += patch_load;
+                hindex++;
+                count++;
+            }
+            smpi->patch_count[rk] = count;
+        }
+        MESSAGE( 1, "Restart: patches of " << restart_size_ << " MPI processes distributed over " << size );
+    }
 
     smpi->patch_refHindexes.resize( smpi->patch_count.size(), 0 );
     smpi->patch_refHindexes[0] = 0;
@@ -629,14 +817,32 @@ void Checkpoint::restartAll( VectorPatch &vecPatches, Region &region, SmileiMPI
         f.attr( "EnergyUsedForNorm", scalars->EnergyUsedForNorm );
     }
     // Poynting scalars
-    unsigned int k=0;
-    for( unsigned int j=0; j<2; j++ ) { //directions (xmin/xmax, ymin/ymax, zmin/zmax)
-        for( unsigned int i=0; i<params.nDim_field; i++ ) { //axis 0=x, 1=y, 2=z
-            string poy_name = Tools::merge( "Poy", Tools::xyz[i], j==0?"min":"max" );
-            if( f.hasAttr( poy_name ) ) {
-                f.attr( poy_name, vecPatches( 0 )->EMfields->poynting[j][i] );
+    bool elastic = ( restart_size_ != smpi->getSize() );
+    if( ! elastic ) {
+        for( unsigned int j=0; j<2; j++ ) { //directions (xmin/xmax, ymin/ymax, zmin/zmax)
+            for( unsigned int i=0; i<params.nDim_field; i++ ) { //axis 0=x, 1=y, 2=z
+                string poy_name = Tools::merge( "Poy", Tools::xyz[i], j==0?"min":"max" );
+                if( f.hasAttr( poy_name ) ) {
+                    f.attr( poy_name, vecPatches( 0 )->EMfields->poynting[j][i] );
+                }
+            }
+        }
+    } else {
+        // Each process sums those of the processes of the previous run with the same rank modulo
+        // the current number of processes, so that the total is unchanged
+        for( int rk=smpi->getRank() ; rk<restart_size_ ; rk+=smpi->getSize() ) {
+            H5Read fp( restartFileName( rk ) );
+            checkRestartStep( fp, rk );
+            for( unsigned int j=0; j<2; j++ ) {
+                for( unsigned int i=0; i<params.nDim_field; i++ ) {
+                    string poy_name = Tools::merge( "Poy", Tools::xyz[i], j==0?"min":"max" );
+                    if( fp.hasAttr( poy_name ) ) {
+                        double poy_val = 0.;
+                        fp.attr( poy_name, poy_val );
+                        vecPatches( 0 )->EMfields->poynting[j][i] += poy_val;
+                    }
+                }
             }
-            k++;
         }
     }
 
@@ -659,19 +865,34 @@ void Checkpoint::restartAll( VectorPatch &vecPatches, Region &region, SmileiMPI
         }
     }
 
-    // Read all the patch data
-    for( unsigned int ipatch=0 ; ipatch<vecPatches.size(); ipatch++ ) {
+    // Read all the patch data. In an elastic restart, they are read from the files
+    // of the processes of the previous run which owned them, one file after the other
+    unsigned int ipatch = 0;
+    while( ipatch < vecPatches.size() ) {
+        int previous_rank = elastic ? restartRank( vecPatches( ipatch )->Hindex() ) : smpi->getRank();
+        H5Read fp;
+        if( elastic ) {
+            fp.init( restartFileName( previous_rank ) );
+            checkRestartStep( fp, previous_rank );
+        }
+        H5Read &fr = elastic ? fp : f;
 
-        ostringstream patch_name( "" );
-        patch_name << setfill( '0' ) << setw( 6 ) << vecPatches( ipatch )->Hindex();
-        string patchName = Tools::merge( "patch-", patch_name.str() );
-        H5Read g = f.group( patchName );
+        for( ; ipatch<vecPatches.size(); ipatch++ ) {
+            if( elastic && restartRank( vecPatches( ipatch )->Hindex() ) != previous_rank ) {
+                break;
+            }
 
-        restartPatch( vecPatches( ipatch ), params, g );
+            ostringstream patch_name( "" );
+            patch_name << setfill( '0' ) << setw( 6 ) << vecPatches( ipatch )->Hindex();
+            string patchName = Tools::merge( "patch-", patch_name.str() );
+            H5Read g = fr.group( patchName );
 
-        // Random number generator state
-        g.attr( "xorshift32_state", vecPatches( ipatch )->rand_->xorshift32_state );
+            restartPatch( vecPatches( ipatch ), params, g );
+
+            // Random number generator state
+            g.attr( "xorshift32_state", vecPatches( ipatch )->rand_->xorshift32_state );
 
+        }
     }
 
     if (params.multiple_decomposition) {
@@ -687,7 +908,11 @@ void Checkpoint::restartAll( VectorPatch &vecPatches, Region &region, SmileiMPI
         if( DiagnosticTrack *track = dynamic_cast<DiagnosticTrack *>( vecPatches.localDiags[idiag] ) ) {
             ostringstream n( "" );
             n<< "latest_ID_" << track->species_name_;
-            if( f.hasAttr( n.str() ) ) {
+            if( smpi->getRank() >= restart_size_ ) {
+                // The processes beyond those of the previous run start a new range of Ids,
+                // and the restored particles keep theirs
+                track->latest_Id = ( uint64_t ) smpi->getRank() << 32;
+            } else if( f.hasAttr( n.str() ) ) {
                 f.attr( n.str(), track->latest_Id, H5T_NATIVE_UINT64 );
             } else {
                 track->IDs_done=false;
@@ -698,6 +923,49 @@ void Checkpoint::restartAll( VectorPatch &vecPatches, Region &region, SmileiMPI
 }
 
 
+int Checkpoint::restartRank( unsigned int hindex ) const
+{
+    return upper_bound( restart_refHindexes_.begin(), restart_refHindexes_.end(), hindex ) - restart_refHindexes_.begin() - 1;
+}
+
+
+string Checkpoint::restartFileName( int rank ) const
+{
+    // restart_file is <restart_dir>/checkpoints/[<group>/]dump-<number>-<rank>.h5, unless
+    // it was found in the node-local tier: the files of the other processes are then
+    // taken from restart_dir
+    size_t name_start = restart_file.rfind( "dump-" );
+    size_t rank_start = restart_file.find( '-', name_start+5 ) + 1;
+    string dir;
+    if( restart_dir_.empty() ) {
+        dir = restart_file.substr( 0, name_start );
+        if( restart_file_grouping_ > 0 ) {
+            dir = dir.substr( 0, dir.rfind( PATH_SEPARATOR, dir.size()-2 ) + 1 );
+        }
+    } else {
+        dir = restart_dir_ + PATH_SEPARATOR + "checkpoints" + PATH_SEPARATOR;
+    }
+
+    ostringstream name( "" );
+    name << dir;
+    if( restart_file_grouping_ > 0 ) {
+        name << setfill( '0' ) << setw( int( 1+log10( restart_size_/restart_file_grouping_+1 ) ) ) << rank/restart_file_grouping_ << PATH_SEPARATOR;
+    }
+    name << restart_file.substr( name_start, rank_start-name_start ) << setfill( '0' ) << setw( 10 ) << rank << ".h5";
+    return name.str();
+}
+
+void Checkpoint::checkRestartStep( H5Read &f, int rank ) const
+{
+    // An interrupted copy from the node-local tier may leave an older file with the same dump number
+    unsigned int step = 0;
+    f.attr( "dump_step", step );
+    if( step != this_run_start_step ) {
+        ERROR( "Restart file " << restartFileName( rank ) << " was written at step " << step << " instead of " << this_run_start_step );
+    }
+}
+
+
 void Checkpoint::readRegionDistribution( Region &region )
 {
     int read_hindex( -1 );
@@ -1042,40 +1310,44 @@ void Checkpoint::restart_cFieldsPerProc( H5Read &g, Field *field )
 
 void Checkpoint::dumpParticles( H5Write& s, Particles &p )
 {
+    if( dump_deflate > 0 ) {
+        s.attr( "particle_codec", 1 );
+    }
+
     for( unsigned int i=0; i<p.Position.size(); i++ ) {
         ostringstream my_name( "" );
         my_name << "Position-" << i;
-        s.vect( my_name.str(), p.Position[i] );//, dump_deflate );
+        dumpParticleProperty( s, my_name.str(), p.Position[i] );
     }
     
     for( unsigned int i=0; i<p.Momentum.size(); i++ ) {
         ostringstream my_name( "" );
         my_name << "Momentum-" << i;
-        s.vect( my_name.str(),p.Momentum[i] );//, dump_deflate );
+        dumpParticleProperty( s, my_name.str(), p.Momentum[i] );
     }
     
-    s.vect( "Weight", p.Weight );//, dump_deflate );
-    s.vect( "Charge", p.Charge );//, dump_deflate );
+    dumpParticleProperty( s, "Weight", p.Weight );
+    dumpParticleProperty( s, "Charge", p.Charge );
     
     if( p.tracked ) {
-        s.vect( "Id", p.Id, H5T_NATIVE_UINT64 );//, dump_deflate );
+        dumpParticleProperty( s, "Id", p.Id );
     }
     
     // Monte-Carlo process
     if( p.has_Monte_Carlo_process ) {
-        s.vect( "Tau", p.Tau );//, dump_deflate );
+        dumpParticleProperty( s, "Tau", p.Tau );
     }
     
     // Copy interpolated fields that must be accumulated over time
     if( p.interpolated_fields_ ) {
         if( p.interpolated_fields_->mode_[6] == 2 ) {
-            s.vect( "Wx", p.interpolated_fields_->F_[6] );
+            dumpParticleProperty( s, "Wx", p.interpolated_fields_->F_[6] );
         }
         if( p.interpolated_fields_->mode_[7] == 2 ) {
-            s.vect( "Wy", p.interpolated_fields_->F_[7] );
+            dumpParticleProperty( s, "Wy", p.interpolated_fields_->F_[7] );
         }
         if( p.interpolated_fields_->mode_[8] == 2 ) {
-            s.vect( "Wz", p.interpolated_fields_->F_[8] );
+            dumpParticleProperty( s, "Wz", p.interpolated_fields_->F_[8] );
         }
     }
 }
@@ -1085,40 +1357,131 @@ void Checkpoint::restartParticles( H5Read& s, Particles &p )
     for( unsigned int i=0; i<p.Position.size(); i++ ) {
         ostringstream my_name( "" );
         my_name << "Position-" << i;
-        s.vect( my_name.str(), p.Position[i] );
+        restartParticleProperty( s, my_name.str(), p.Position[i] );
     }
     
     for( unsigned int i=0; i<p.Momentum.size(); i++ ) {
         ostringstream my_name( "" );
         my_name << "Momentum-" << i;
-        s.vect( my_name.str(), p.Momentum[i] );
+        restartParticleProperty( s, my_name.str(), p.Momentum[i] );
     }
     
-    s.vect( "Weight", p.Weight );
-    s.vect( "Charge", p.Charge );
+    restartParticleProperty( s, "Weight", p.Weight );
+    restartParticleProperty( s, "Charge", p.Charge );
     
     if( p.tracked ) {
-        s.vect( "Id", p.Id, H5T_NATIVE_UINT64 );
+        restartParticleProperty( s, "Id", p.Id );
     }
     
     if( p.has_Monte_Carlo_process ) {
-        s.vect( "Tau", p.Tau );
+        restartParticleProperty( s, "Tau", p.Tau );
     }
     
     // Retrieve interpolated fields that must be accumulated over time
     if( p.interpolated_fields_ ) {
         if( p.interpolated_fields_->mode_[6] == 2 ) {
-            s.vect( "Wx", p.interpolated_fields_->F_[6] );
+            restartParticleProperty( s, "Wx", p.interpolated_fields_->F_[6] );
         }
         if( p.interpolated_fields_->mode_[7] == 2 ) {
-            s.vect( "Wy", p.interpolated_fields_->F_[7] );
+            restartParticleProperty( s, "Wy", p.interpolated_fields_->F_[7] );
         }
         if( p.interpolated_fields_->mode_[8] == 2 ) {
-            s.vect( "Wz", p.interpolated_fields_->F_[8] );
+            restartParticleProperty( s, "Wz", p.interpolated_fields_->F_[8] );
         }
     }
 }
 
+// HDF5 type of a particle property
+inline hid_t particlePropertyType( const double & ) { return H5T_NATIVE_DOUBLE; }
+inline hid_t particlePropertyType( const float & ) { return H5T_NATIVE_FLOAT; }
+inline hid_t particlePropertyType( const short & ) { return H5T_NATIVE_SHORT; }
+inline hid_t particlePropertyType( const uint64_t & ) { return H5T_NATIVE_UINT64; }
+
+// Unsigned integer with the size of a particle property, on which the particle codec works
+template<size_t N> struct ParticleCodecWord {};
+template<> struct ParticleCodecWord<2> {
+    typedef uint16_t type;
+    static hid_t h5type() { return H5T_NATIVE_UINT16; }
+};
+template<> struct ParticleCodecWord<4> {
+    typedef uint32_t type;
+    static hid_t h5type() { return H5T_NATIVE_UINT32; }
+};
+template<> struct ParticleCodecWord<8> {
+    typedef uint64_t type;
+    static hid_t h5type() { return H5T_NATIVE_UINT64; }
+};
+
+template <typename T>
+void Checkpoint::dumpParticleProperty( H5Write &s, string name, vector<T> &v )
+{
+    if( dump_deflate == 0 || v.empty() ) {
+        s.vect( name, v, particlePropertyType( T() ) );
+        return;
+    }
+
+    typedef typename ParticleCodecWord<sizeof( T )>::type W;
+    hid_t type = ParticleCodecWord<sizeof( T )>::h5type();
+    vector<W> words( v.size() );
+    memcpy( &words[0], &v[0], v.size()*sizeof( T ) );
+
+    // Same value for all particles (e.g. charge, or weight)
+    if( all_of( words.begin(), words.end(), [&words]( W w ) { return w == words[0]; } ) ) {
+        s.attr( name, words[0], type );
+        return;
+    }
+
+    // The particles are sorted by cell: consecutive positions share their sign, exponent
+    // and leading digits, which the difference (xor for floating-point numbers) makes zero.
+    // The shuffle filter gathers these zeros before the deflate filter.
+    for( size_t i=words.size()-1; i>0; i-- ) {
+        if( is_floating_point<T>::value ) {
+            words[i] ^= words[i-1];
+        } else {
+            words[i] -= words[i-1];
+        }
+    }
+    s.compressedVect( name, words[0], words.size(), type, dump_deflate );
+}
+
+template <typename T>
+void Checkpoint::restartParticleProperty( H5Read &s, string name, vector<T> &v )
+{
+    if( ! s.hasAttr( "particle_codec" ) ) {
+        s.vect( name, v, particlePropertyType( T() ) );
+        return;
+    }
+
+    typedef typename ParticleCodecWord<sizeof( T )>::type W;
+    hid_t type = ParticleCodecWord<sizeof( T )>::h5type();
+
+    // Same value for all particles
+    if( s.hasAttr( name ) ) {
+        W word;
+        s.attr( name, word, type );
+        T value;
+        memcpy( &value, &word, sizeof( T ) );
+        fill( v.begin(), v.end(), value );
+        return;
+    }
+
+    vector<W> words;
+    s.vect( name, words, type, true );
+    if( words.size() != v.size() ) {
+        ERROR( "Checkpoint: " << name << " has " << words.size() << " particles instead of " << v.size() );
+    }
+    for( size_t i=1; i<words.size(); i++ ) {
+        if( is_floating_point<T>::value ) {
+            words[i] ^= words[i-1];
+        } else {
+            words[i] += words[i-1];
+        }
+    }
+    if( ! words.empty() ) {
+        memcpy( &v[0], &words[0], v.size()*sizeof( T ) );
+    }
+}
+
 void Checkpoint::dumpMovingWindow( H5Write &f, SimWindow *simWin )
 {
     f.attr( "x_moved", simWin->getXmoved() );
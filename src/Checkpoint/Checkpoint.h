@@ -9,6 +9,7 @@
 
 #include <string>
 #include <vector>
+#include <thread>
 
 #include <hdf5.h>
 #include <Tools.h>
@@ -46,7 +47,7 @@ public:
     unsigned int nDim_particle;
     
     //! restart everything to file per processor
-    void readPatchDistribution( SmileiMPI *smpi, SimWindow *simWin );
+    void readPatchDistribution( SmileiMPI *smpi, SimWindow *simWin, Params &params );
     void readRegionDistribution( Region &region );
     void restartAll( VectorPatch &vecPatches, Region &region, SmileiMPI *smpi, Params &params );
     void restartPatch( Patch *patch, Params &params, H5Read &g );
@@ -58,6 +59,8 @@ public:
     
     //! dump everything to file per processor
     void dumpAll( VectorPatch &vecPatches, Region &region, unsigned int itime,  SmileiMPI *smpi, SimWindow *simWin, Params &params );
+    //! wait until the file of the previous dump is written (asynchronous mode or local_dir)
+    void waitDump();
     void dumpPatch( Patch *patch, Params &params, H5Write &g );
     
     //! incremental number of times we've done a dump
@@ -106,6 +109,13 @@ private:
     //! dump/restart a particles object
     void dumpParticles( H5Write& s, Particles &p );
     void restartParticles( H5Read& s, Particles &p );
+    //! dump/restart a particle property with the particle codec (dump_deflate > 0): a property
+    //! which has the same value for all particles is stored as an attribute; otherwise, the
+    //! differences between the bits of consecutive particles are stored, and compressed
+    template <typename T>
+    void dumpParticleProperty( H5Write &s, std::string name, std::vector<T> &v );
+    template <typename T>
+    void restartParticleProperty( H5Read &s, std::string name, std::vector<T> &v );
     //! dump/restart moving window parameters
     void dumpMovingWindow( H5Write &f, SimWindow *simWindow );
     void restartMovingWindow( H5Read &f, SimWindow *simWindow );
@@ -124,14 +134,48 @@ private:
     //! write dump drectory
     std::string dump_dir;
     
-    //! int deflate dump value
+    //! deflate level of the particle codec (0 if the particles are written as they are)
     int dump_deflate;
     
     //! group checkpoint files in subdirs of file_grouping files
     unsigned int file_grouping;
     
+    //! the files are built in memory and written by a separate thread, while the simulation goes on
+    bool asynchronous_;
+    //! node-local directory where the files are written first, then copied to the shared
+    //! directory by a separate thread (empty if the files are written to the shared directory)
+    std::string local_dir_;
+    //! thread writing the file of the last dump (asynchronous mode or local_dir_)
+    std::thread writer_;
+    //! content of the file written by writer_ (asynchronous mode)
+    std::vector<char> image_;
+    //! name of the file written by writer_, or of the local file copied by writer_
+    std::string image_name_;
+    //! name of the copy of the local file in the shared directory
+    std::string drain_name_;
+    //! set by writer_ if the file could not be written
+    bool write_failed_;
+    //! finish writing the file of the last dump (run by writer_)
+    void writeInBackground();
+    
     //! restart file
     std::string restart_file;
+    //! directory of the run which wrote the restart files
+    std::string restart_dir_;
+    
+    //! Number of MPI processes of the run which wrote the restart files
+    int restart_size_;
+    //! First patch of each of these processes (and total number of patches), when it
+    //! differs from the current number of processes
+    std::vector<unsigned int> restart_refHindexes_;
+    //! file_grouping of the run which wrote the restart files
+    unsigned int restart_file_grouping_;
+    //! Rank, in the run which wrote the restart files, of the process which owned a patch
+    int restartRank( unsigned int hindex ) const;
+    //! Restart file written by a process of the previous run
+    std::string restartFileName( int rank ) const;
+    //! Stop if a restart file of the previous run was not written at the restart step
+    void checkRestartStep( H5Read &f, int rank ) const;
     
     //! dump PML in the checkpoint file 
     template <typename Tpml>
@@ -442,6 +442,9 @@ void BinaryProcesses::debug( Params &params, int itime, unsigned int icoll, Vect
             }
         }
 
+        // Fields may still be written in the background
+        vecPatches.waitAllDiagsWrite();
+
         // Create H5 group for the current timestep
         ostringstream name( "" );
         name << "t" << setfill( '0' ) << setw( 8 ) << itime;
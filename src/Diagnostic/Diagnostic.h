@@ -52,6 +52,18 @@ public :
         return false;
     };
     
+    //! Tells whether this diagnostic writes to its HDF5 file at this iteration
+    virtual bool writesHDF5( int itime )
+    {
+        return timeSelection->theTimeIsNow( itime );
+    };
+    
+    //! Waits until the file is no longer written by a background thread
+    virtual void waitWrite() {};
+    
+    //! Sums the data accumulated separately by each thread (called by all threads after `run`)
+    virtual void reduceThreads() {};
+    
     //! Time selection for writing the diagnostic
     TimeSelection *timeSelection;
     
@@ -9,6 +9,7 @@
 #include "DiagnosticProbes.h"
 #include "DiagnosticScalar.h"
 #include "DiagnosticTrack.h"
+#include "DiagnosticTrackAppend.h"
 #include "DiagnosticNewParticles.h"
 #include "DiagnosticPerformances.h"
 
@@ -84,7 +85,15 @@ public:
         }
         
         for( unsigned int i = 0, n = PyTools::nComponents( "DiagTrackParticles" ); i < n; i++ ) {
-            vecDiagnostics.push_back( new DiagnosticTrack( params, smpi, vecPatches, i, vecDiagnostics.size(), openPMD ) );
+            std::string layout;
+            PyTools::extract( "layout", layout, "DiagTrackParticles", i );
+            if( layout == "per_iteration" ) {
+                vecDiagnostics.push_back( new DiagnosticTrack( params, smpi, vecPatches, i, vecDiagnostics.size(), openPMD ) );
+            } else if( layout == "append" ) {
+                vecDiagnostics.push_back( new DiagnosticTrackAppend( params, smpi, vecPatches, i, vecDiagnostics.size(), openPMD ) );
+            } else {
+                ERROR( "DiagTrackParticles #" << i << ": `layout` must be \"per_iteration\" or \"append\"" );
+            }
         }
         
         for( unsigned int i = 0, n = PyTools::nComponents( "DiagNewParticles" ); i < n; i++ ) {
@@ -185,6 +185,27 @@ DiagnosticFields::DiagnosticFields( Params &params, SmileiMPI *smpi, VectorPatch
         ERROR( "Diagnostic Fields #"<<ndiag<<" has an unknown datatype `"<<datatype<<"`" );
     }
     
+    // Extract the compression parameters
+    lossy_ = new H5Lossy( "DiagFields", ndiag, fields_names );
+    
+    // Extract the asynchronous parameter
+    asynchronous_ = false;
+    PyTools::extract( "asynchronous", asynchronous_, "DiagFields", ndiag );
+    if( asynchronous_ ) {
+        // The writer thread makes collective MPI calls through HDF5
+        int provided;
+        MPI_Query_thread( &provided );
+        if( provided != MPI_THREAD_MULTIPLE ) {
+            WARNING( "Diagnostic Fields #"<<ndiag<<" cannot be asynchronous without MPI_THREAD_MULTIPLE" );
+            asynchronous_ = false;
+        }
+    }
+    staged_data_     .resize( asynchronous_ ? fields_names.size() : 0 );
+    staged_stagger_  .resize( asynchronous_ ? fields_names.size() : 0 );
+    staged_stagger_t_.resize( asynchronous_ ? fields_names.size() : 0 );
+    staged_x_moved_ = 0.;
+    staged_flush_ = false;
+    
     // Copy the total number of patches
     tot_number_of_patches = params.tot_number_of_patches;
     
@@ -218,6 +239,7 @@ DiagnosticFields::~DiagnosticFields()
     }
     delete timeSelection;
     delete flush_timeSelection;
+    delete lossy_;
 }
 
 void DiagnosticFields::openFile( Params &, SmileiMPI *smpi )
@@ -242,6 +264,10 @@ void DiagnosticFields::openFile( Params &, SmileiMPI *smpi )
 
 void DiagnosticFields::closeFile()
 {
+    waitWrite();
+    if( file_ && lossy_->active() ) {
+        MESSAGE( 1, "Diagnostic Fields #"<<diag_n<<": "<<lossy_->summary()<<" (master process)" );
+    }
     if( data_group_ ) {
         delete data_group_;
         data_group_ = NULL;
@@ -294,6 +320,9 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
     
     #pragma omp master
     {
+        // Back-pressure: the buffers and the file must be free again
+        waitWrite();
+        
         // Calculate the structure of the file depending on 1D, 2D, ...
         refHindex = ( unsigned int )( vecPatches.refHindex_ );
         setFileSplitting( smpi, vecPatches );
@@ -319,7 +348,7 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
     
     unsigned int nPatches( vecPatches.size() );
     
-    // For each field, combine all patches and write out
+    // For each field, combine all patches and write out (or stage for the writer thread)
     for( unsigned int ifield=0; ifield < fields_indexes.size(); ifield++ ) {
     
         // Copy the patch field to the buffer
@@ -331,8 +360,6 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         
         #pragma omp master
         {
-            // Write
-            H5Write dset = writeField( iteration_group_, fields_names[ifield] );
             // Attributes for openPMD
             Field *f = vecPatches( 0 )->EMfields->allFields[fields_indexes[ifield]];
             vector<double> stagger( f->dims().size() );
@@ -341,34 +368,94 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
             }
             bool ends_with_m = 0 == fields_names[ifield].compare( fields_names[ifield].length()-2, 2, "_m" );
             double stagger_t = ends_with_m ? vecPatches( 0 )->EMfields->timestep*0.5 : 0.;
-            openPMD_->writeFieldAttributes( dset, subgrid_start_, subgrid_step_ );
-            openPMD_->writeRecordAttributes( dset, field_type[ifield], stagger_t );
-            openPMD_->writeFieldRecordAttributes( dset, stagger );
-            openPMD_->writeComponentAttributes( dset, field_type[ifield] );
+            if( asynchronous_ ) {
+                stageField( ifield );
+                staged_stagger_[ifield] = stagger;
+                staged_stagger_t_[ifield] = stagger_t;
+            } else {
+                writeFieldAndAttributes( ifield, stagger, stagger_t );
+            }
         }
         #pragma omp barrier 
     }
     
     #pragma omp master
     {
-        
-        // write x_moved
         double x_moved = simWindow ? simWindow->getXmoved() : 0.;
-        iteration_group_->attr( "x_moved", x_moved );
-        delete iteration_group_;
-        if( flush_timeSelection->theTimeIsNow( itime ) ) {
-            file_->flush();
+        bool flush = flush_timeSelection->theTimeIsNow( itime );
+        if( asynchronous_ ) {
+            staged_x_moved_ = x_moved;
+            staged_flush_ = flush;
+            writer_ = thread( &DiagnosticFields::writeStaged, this );
+        } else {
+            finishIteration( x_moved, flush );
         }
     }
     #pragma omp barrier
 }
 
+void DiagnosticFields::roundField( unsigned int ifield )
+{
+    lossy_->round( data.data(), data.size(), ifield );
+}
+
+void DiagnosticFields::stageField( unsigned int ifield )
+{
+    staged_data_[ifield].swap( data );
+    data.resize( staged_data_[ifield].size() );
+}
+
+void DiagnosticFields::writeFieldAndAttributes( unsigned int ifield, vector<double> &stagger, double stagger_t )
+{
+    if( lossy_->active() ) {
+        roundField( ifield );
+    }
+    H5Write dset = writeField( iteration_group_, fields_names[ifield] );
+    openPMD_->writeFieldAttributes( dset, subgrid_start_, subgrid_step_ );
+    openPMD_->writeRecordAttributes( dset, field_type[ifield], stagger_t );
+    openPMD_->writeFieldRecordAttributes( dset, stagger );
+    openPMD_->writeComponentAttributes( dset, field_type[ifield] );
+}
+
+void DiagnosticFields::finishIteration( double x_moved, bool flush )
+{
+    // write x_moved
+    iteration_group_->attr( "x_moved", x_moved );
+    delete iteration_group_;
+    if( flush ) {
+        file_->flush();
+    }
+}
+
+// Runs in the writer thread: the main thread does not touch HDF5 nor the buffers until waitWrite()
+void DiagnosticFields::writeStaged()
+{
+    for( unsigned int ifield=0; ifield < fields_indexes.size(); ifield++ ) {
+        // Bring the staged field back into the current buffer
+        stageField( ifield );
+        writeFieldAndAttributes( ifield, staged_stagger_[ifield], staged_stagger_t_[ifield] );
+    }
+    finishIteration( staged_x_moved_, staged_flush_ );
+}
+
+void DiagnosticFields::waitWrite()
+{
+    if( writer_.joinable() ) {
+        writer_.join();
+    }
+}
+
 bool DiagnosticFields::needsRhoJs( int itime )
 {
     
     return hasRhoJs && (itime - timeSelection->previousTime( itime ) < time_average);
 }
 
+bool DiagnosticFields::writesHDF5( int itime )
+{
+    return itime - timeSelection->previousTime( itime ) == time_average-1;
+}
+
 // SUPPOSED TO BE EXECUTED ONLY BY MASTER MPI
 uint64_t DiagnosticFields::getDiskFootPrint( int istart, int istop, Patch * )
 {
@@ -1,6 +1,8 @@
 #ifndef DIAGNOSTICFIELDS_H
 #define DIAGNOSTICFIELDS_H
 
+#include <thread>
+
 #include "Diagnostic.h"
 
 class DiagnosticFields  : public Diagnostic
@@ -27,6 +29,11 @@ public :
     
     virtual bool needsRhoJs( int itime ) override;
     
+    bool writesHDF5( int itime ) override;
+    
+    //! Joins the thread writing the previous iteration, if any
+    void waitWrite() override;
+    
     void findSubgridIntersection( unsigned int subgrid_start,
                                   unsigned int subgrid_stop,
                                   unsigned int subgrid_step,
@@ -87,6 +94,21 @@ protected :
     //! Copy patch field to current "data" buffer
     virtual void getField( Patch *patch, unsigned int ) = 0;
     
+    //! Round the current "data" buffer for the lossy compression
+    virtual void roundField( unsigned int ifield );
+    
+    //! Exchange the current "data" buffer with the staging buffer of a field
+    virtual void stageField( unsigned int ifield );
+    
+    //! Write the current buffer and its openPMD attributes
+    void writeFieldAndAttributes( unsigned int ifield, std::vector<double> &stagger, double stagger_t );
+    
+    //! Write the last attributes of the iteration and close its group
+    void finishIteration( double x_moved, bool flush );
+    
+    //! Write all the staged fields (runs in the writer thread)
+    void writeStaged();
+    
     //! Variable to store the status of a dataset (whether it exists or not)
     bool status;
     
@@ -101,6 +123,26 @@ protected :
     
     //! Datatype for writing to HDF5 file
     hid_t file_datatype_;
+    
+    //! Lossy compression of the datasets
+    H5Lossy *lossy_;
+    
+    //! True if the HDF5 writes are done by a background thread
+    bool asynchronous_;
+    
+    //! Thread writing the staged fields while the simulation proceeds
+    std::thread writer_;
+    
+    //! One staging buffer per field, swapped with "data"
+    std::vector<std::vector<double> > staged_data_;
+    
+    //! openPMD staggers of the staged fields
+    std::vector<std::vector<double> > staged_stagger_;
+    std::vector<double> staged_stagger_t_;
+    
+    //! Moving window position and flush request of the staged iteration
+    double staged_x_moved_;
+    bool staged_flush_;
 };
 
 #endif
@@ -36,6 +36,8 @@ DiagnosticFields1D::DiagnosticFields1D( Params &params, SmileiMPI *smpi, VectorP
 
 DiagnosticFields1D::~DiagnosticFields1D()
 {
+    // The writer thread calls the methods of this class
+    waitWrite();
 }
 
 void DiagnosticFields1D::setFileSplitting( SmileiMPI *smpi, VectorPatch &vecPatches )
@@ -115,6 +117,6 @@ void DiagnosticFields1D::getField( Patch *patch, unsigned int ifield )
 // Write current buffer to file
 H5Write DiagnosticFields1D::writeField( H5Write * loc, std::string name )
 {
-    return loc->array( name, data[0], filespace, memspace, false, file_datatype_ );
+    return loc->array( name, data[0], filespace, memspace, false, file_datatype_, lossy_ );
 }
 
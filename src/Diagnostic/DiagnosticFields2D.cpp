@@ -56,6 +56,8 @@ DiagnosticFields2D::DiagnosticFields2D( Params &params, SmileiMPI *smpi, VectorP
 
 DiagnosticFields2D::~DiagnosticFields2D()
 {
+    // The writer thread calls the methods of this class
+    waitWrite();
 }
 
 
@@ -184,6 +186,6 @@ void DiagnosticFields2D::getField( Patch *patch, unsigned int ifield )
 // Write current buffer to file
 H5Write DiagnosticFields2D::writeField( H5Write * loc, std::string name )
 {
-    return loc->array( name, data[0], filespace, memspace, false, file_datatype_ );
+    return loc->array( name, data[0], filespace, memspace, false, file_datatype_, lossy_ );
 }
 
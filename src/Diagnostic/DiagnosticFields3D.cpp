@@ -57,6 +57,8 @@ DiagnosticFields3D::DiagnosticFields3D( Params &params, SmileiMPI *smpi, VectorP
 
 DiagnosticFields3D::~DiagnosticFields3D()
 {
+    // The writer thread calls the methods of this class
+    waitWrite();
 }
 
 
@@ -218,6 +220,6 @@ void DiagnosticFields3D::getField( Patch *patch, unsigned int ifield )
 // Write current buffer to file
 H5Write DiagnosticFields3D::writeField( H5Write * loc, string name )
 {
-    return loc->array( name, data[0], filespace, memspace, false, file_datatype_ );
+    return loc->array( name, data[0], filespace, memspace, false, file_datatype_, lossy_ );
 }
 
@@ -80,6 +80,8 @@ DiagnosticFieldsAM::DiagnosticFieldsAM( Params &params, SmileiMPI *smpi, VectorP
 
 DiagnosticFieldsAM::~DiagnosticFieldsAM()
 {
+    // The writer thread calls the methods of this class
+    waitWrite();
 }
 
 
@@ -222,6 +224,28 @@ void DiagnosticFieldsAM::getField( Patch *patch, unsigned int ifield, F& out_dat
     }
 }
 
+// Round the current buffer for the lossy compression (real and imaginary parts alike)
+void DiagnosticFieldsAM::roundField( unsigned int ifield )
+{
+    if( is_complex_ ) {
+        lossy_->round( reinterpret_cast<double *>( idata.data() ), 2*idata.size(), ifield );
+    } else {
+        DiagnosticFields::roundField( ifield );
+    }
+}
+
+// Exchange the current buffer with the staging buffer of a field
+void DiagnosticFieldsAM::stageField( unsigned int ifield )
+{
+    if( is_complex_ ) {
+        staged_idata_.resize( fields_indexes.size() );
+        staged_idata_[ifield].swap( idata );
+        idata.resize( staged_idata_[ifield].size() );
+    } else {
+        DiagnosticFields::stageField( ifield );
+    }
+}
+
 // Write current buffer to file
 H5Write DiagnosticFieldsAM::writeField( H5Write * loc, string name )
 {
@@ -237,6 +261,6 @@ template<typename F>
 H5Write DiagnosticFieldsAM::writeField( H5Write *loc, string name, F& linearized_data )
 {
     // Rewrite the file with the previously defined partition
-    return loc->array( name, linearized_data[0], H5T_NATIVE_DOUBLE, filespace, memspace, false, file_datatype_ );
+    return loc->array( name, linearized_data[0], H5T_NATIVE_DOUBLE, filespace, memspace, false, file_datatype_, lossy_ );
 }
 
@@ -20,6 +20,10 @@ public:
     void getField( Patch *patch, unsigned int ) override;
     template<typename T, typename F>  void getField( Patch *patch, unsigned int, F& out_data );
     
+    void roundField( unsigned int ifield ) override;
+    
+    void stageField( unsigned int ifield ) override;
+    
     H5Write writeField( H5Write*, std::string ) override;
     template<typename F> H5Write writeField( H5Write*, std::string, F& linearized_data );
 
@@ -27,6 +31,7 @@ private:
     std::vector<unsigned int> buffer_skip_x, buffer_skip_y;
     
     std::vector<std::complex<double> > idata;
+    std::vector<std::vector<std::complex<double> > > staged_idata_;
     bool is_complex_;
 };
 
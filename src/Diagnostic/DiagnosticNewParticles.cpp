@@ -232,9 +232,15 @@ H5Space * DiagnosticNewParticles::prepareH5( SimWindow *, SmileiMPI *smpi, int i
     return new H5Space( new_size, full_offset, nParticles_local );
 }
 
-void DiagnosticNewParticles::writeOther( VectorPatch &vecPatches, size_t iprop, H5Space *file_space, H5Space *mem_space )
+void DiagnosticNewParticles::writeOther( VectorPatch &vecPatches, size_t /*iprop*/, H5Space *file_space, H5Space *mem_space )
 {
-    fill_buffer( vecPatches, iprop, data_double );
+    // The birth times are not particle properties: fill the buffer patch by patch
+    #pragma omp barrier
+    #pragma omp for schedule(runtime)
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        vector<double> &birth_time = vecPatches.species( ipatch, species_index_ )->birth_records_->birth_time_;
+        fill_buffer( ipatch, birth_time.size(), birth_time, data_double );
+    }
     #pragma omp master
     write_scalar_double( loc_birth_time_, "birth_time", data_double[0], file_space, mem_space, SMILEI_UNIT_NONE );
     
@@ -126,6 +126,9 @@ DiagnosticParticleBinningBase::DiagnosticParticleBinningBase(
         for( unsigned int i=0; i<histogram->axes.size(); i++ ) {
             MESSAGE( 2, histogram->axes[i]->info() );
         }
+        if( histogram->sharedBins( output_size ) ) {
+            MESSAGE( 2, "Too many bins to be summed separately by each thread: the threads share them with atomic operations" );
+        }
         
         // init HDF files (by master, only if it doesn't yet exist)
         mystream.str( "" ); // clear
@@ -308,20 +311,21 @@ void DiagnosticParticleBinningBase::run( Patch *patch, int, SimWindow *simWindow
 //        }
 //    }
     
-    // Calculate the total number of particles in this patch and resize buffers
-    unsigned int npart = 0;
-    vector<Species *> species;
+    // Loop species & fill the histogram, in the bins of the current thread
     for( unsigned int ispec=0 ; ispec < species_indices.size() ; ispec++ ) {
         Species *s = patch->vecSpecies[species_indices[ispec]];
-        species.push_back( s );
-        npart += s->getNbrOfParticles();
+        unsigned int npart = s->getNbrOfParticles();
+        if( npart == 0 ) {
+            continue;
+        }
+        double *double_buffer;
+        int *int_buffer;
+        histogram->workBuffers( npart, double_buffer, int_buffer );
+        
+        histogram->digitize( s, double_buffer, int_buffer, npart, simWindow );
+        histogram->valuate( s, double_buffer, int_buffer );
+        histogram->distribute( double_buffer, int_buffer, npart, data_sum );
     }
-    vector<int> int_buffer( npart, 0 );
-    vector<double> double_buffer( npart );
-    
-    histogram->digitize( species, double_buffer, int_buffer, simWindow );
-    histogram->valuate( species, double_buffer, int_buffer );
-    histogram->distribute( double_buffer, int_buffer, data_sum );
     
 } // END run
 
@@ -329,6 +333,13 @@ bool DiagnosticParticleBinningBase::writeNow( int itime ) {
     return itime - timeSelection->previousTime() == time_average-1;
 }
 
+bool DiagnosticParticleBinningBase::writesHDF5( int itime )
+{
+    // Called before prepare(): the previous time used by writeNow must be updated first
+    timeSelection->previousTime( itime );
+    return writeNow( itime );
+}
+
 // Now the data_sum has been filled
 // if needed now, store result to hdf file
 void DiagnosticParticleBinningBase::write( int itime, SmileiMPI *smpi )
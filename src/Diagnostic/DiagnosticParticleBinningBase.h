@@ -38,8 +38,16 @@ public :
     
     virtual void run( Patch *patch, int itime, SimWindow *simWindow ) override;
     
+    void reduceThreads() override
+    {
+        histogram->reduceThreads( data_sum );
+    };
+    
     virtual bool writeNow( int itime );
     
+    //! Same condition as write() (the output happens at the end of the time average)
+    bool writesHDF5( int itime ) override;
+    
     void write( int itime, SmileiMPI *smpi ) override;
     
     //! Clear the array
@@ -4,6 +4,7 @@
 #include <sstream>
 
 #include "ParticleData.h"
+#include "ParticleExpression.h"
 #include "PeekAtSpecies.h"
 #include "DiagnosticParticleList.h"
 #include "VectorPatch.h"
@@ -147,12 +148,18 @@ DiagnosticParticleList::DiagnosticParticleList( Params &params, SmileiMPI *smpi,
         MESSAGE( 1, "Created " << diag_type << " #" << idiag_of_this_type << ": species " << species_name_ );
         MESSAGE( 2, attr_list.str() );
     }
+    
+    // Simple filters are evaluated natively, without python
+    if( has_filter ) {
+        compiled_filter_ = ParticleExpression::create( filter, nDim_particle, vecPatches( 0 )->vecSpecies[species_index_]->particles, true, "filter" );
+    }
 }
 
 DiagnosticParticleList::~DiagnosticParticleList()
 {
     delete timeSelection;
     delete flush_timeSelection;
+    delete compiled_filter_;
     Py_DECREF( filter );
 }
 
@@ -168,13 +175,36 @@ void DiagnosticParticleList::run( SmileiMPI *smpi, VectorPatch &vecPatches, int
     string xyz = "xyz";
     
     H5Space *file_space=NULL, *mem_space=NULL;
+    
+    // A compiled filter selects the particles of all patches in parallel
+    if( compiled_filter_ ) {
+        #pragma omp master
+        patch_selection.resize( vecPatches.size() );
+        #pragma omp barrier
+        #pragma omp for schedule(runtime)
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            patch_selection[ipatch].resize( 0 );
+            Particles *p = getParticles( vecPatches( ipatch ) );
+            compiled_filter_->select( p, 0, p->numberOfParticles(), patch_selection[ipatch] );
+        }
+    }
+    
     #pragma omp master
     {
         // Obtain the particle partition of all the patches in this MPI
         nParticles_local = 0;
         patch_start.resize( vecPatches.size() );
         
-        if( has_filter ) {
+        if( compiled_filter_ ) {
+            // Changes to filtered particles are applied in the patch order (see DiagnosticTrack::modifyFiltered)
+            for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+                if( getParticles( vecPatches( ipatch ) )->numberOfParticles() > 0 ) {
+                    modifyFiltered( vecPatches, ipatch );
+                }
+                patch_start[ipatch] = nParticles_local;
+                nParticles_local += patch_selection[ipatch].size();
+            }
+        } else if( has_filter ) {
 #ifdef SMILEI_USE_NUMPY
             patch_selection.resize( vecPatches.size() );
             PyArrayObject *ret;
@@ -221,10 +251,12 @@ void DiagnosticParticleList::run( SmileiMPI *smpi, VectorPatch &vecPatches, int
         
         // Get the number of offset for this MPI rank
         uint64_t np_local = nParticles_local, offset;
-        MPI_Scan( &np_local, &offset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD );
+        int file_size;
+        MPI_Comm_size( file_comm_, &file_size );
+        MPI_Scan( &np_local, &offset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, file_comm_ );
         nParticles_global = offset;
         offset -= np_local;
-        MPI_Bcast( &nParticles_global, 1, MPI_UNSIGNED_LONG_LONG, smpi->getSize()-1, MPI_COMM_WORLD );
+        MPI_Bcast( &nParticles_global, 1, MPI_UNSIGNED_LONG_LONG, file_size-1, file_comm_ );
         
         // Prepare all HDF5 groups and datasets
         file_space = prepareH5( simWindow, smpi, itime, nParticles_local, nParticles_global, offset );
@@ -261,7 +293,7 @@ void DiagnosticParticleList::run( SmileiMPI *smpi, VectorPatch &vecPatches, int
     if( write_any_position_ ) {
         for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
             if( write_position_[idim] ) {
-                fill_buffer( vecPatches, idim, data_double );
+                fill_buffer<double, particle_real>( vecPatches, idim, data_double );
                 #pragma omp master
                 write_component_double( loc_position_[idim], xyz.substr( idim, 1 ).c_str(), data_double[0], file_space, mem_space, SMILEI_UNIT_POSITION );
             }
@@ -272,7 +304,7 @@ void DiagnosticParticleList::run( SmileiMPI *smpi, VectorPatch &vecPatches, int
     if( write_any_momentum_ ) {
         for( unsigned int idim=0; idim<3; idim++ ) {
             if( write_momentum_[idim] ) {
-                fill_buffer( vecPatches, nDim_particle+idim, data_double );
+                fill_buffer<double, particle_real>( vecPatches, nDim_particle+idim, data_double );
                 #pragma omp master
                 {
                     // Multiply by the mass to obtain an actual momentum (except for photons (mass = 0))
@@ -297,7 +329,7 @@ void DiagnosticParticleList::run( SmileiMPI *smpi, VectorPatch &vecPatches, int
     
     // Weight
     if( write_weight_ ) {
-        fill_buffer( vecPatches, iprop, data_double );
+        fill_buffer<double, particle_real>( vecPatches, iprop, data_double );
         #pragma omp master
         write_scalar_double( loc_weight_, "weight", data_double[0], file_space, mem_space, SMILEI_UNIT_WEIGHT );
     }
@@ -310,7 +342,7 @@ void DiagnosticParticleList::run( SmileiMPI *smpi, VectorPatch &vecPatches, int
     
     // Chi - quantum parameter
     if( write_chi_ ) {
-        fill_buffer( vecPatches, iprop, data_double );
+        fill_buffer<double, particle_real>( vecPatches, iprop, data_double );
         #pragma omp master
         write_scalar_double( loc_chi_, "chi", data_double[0], file_space, mem_space, SMILEI_UNIT_NONE );
     }
@@ -389,7 +421,7 @@ void DiagnosticParticleList::run( SmileiMPI *smpi, VectorPatch &vecPatches, int
         
         for( unsigned int idim=0; idim<3; idim++ ) {
             if( write_E_[idim] ) {
-                fill_buffer( vecPatches, iprop, data_double );
+                fill_buffer<double, particle_real>( vecPatches, iprop, data_double );
                 #pragma omp master
                 write_component_double( loc_E_[idim], xyz.substr( idim, 1 ).c_str(), data_double[0], file_space, mem_space, SMILEI_UNIT_EFIELD );
             }
@@ -400,7 +432,7 @@ void DiagnosticParticleList::run( SmileiMPI *smpi, VectorPatch &vecPatches, int
         
         for( unsigned int idim=0; idim<3; idim++ ) {
             if( write_B_[idim] ) {
-                fill_buffer( vecPatches, iprop, data_double );
+                fill_buffer<double, particle_real>( vecPatches, iprop, data_double );
                 #pragma omp master
                 write_component_double( loc_B_[idim], xyz.substr( idim, 1 ).c_str(), data_double[0], file_space, mem_space, SMILEI_UNIT_BFIELD );
             }
@@ -417,7 +449,7 @@ void DiagnosticParticleList::run( SmileiMPI *smpi, VectorPatch &vecPatches, int
     if( write_any_W_ ) {
         for( unsigned int idim=0; idim<3; idim++ ) {
             if( write_W_[idim] ) {
-                fill_buffer( vecPatches, iprop, data_double );
+                fill_buffer<double, particle_real>( vecPatches, iprop, data_double );
                 #pragma omp master
                 write_component_double( loc_W_[idim], xyz.substr( idim, 1 ).c_str(), data_double[0], file_space, mem_space, SMILEI_UNIT_ENERGY );
             }
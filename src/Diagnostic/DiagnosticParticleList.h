@@ -7,6 +7,7 @@
 class Patch;
 class Params;
 class SmileiMPI;
+class ParticleExpression;
 
 
 class DiagnosticParticleList : public Diagnostic
@@ -53,33 +54,36 @@ public :
     virtual void writeOther( VectorPatch &, size_t, H5Space *, H5Space * ) {};
     
     //! Fills a buffer with the required particle property
-    template<typename T> void fill_buffer( VectorPatch &vecPatches, size_t iprop, std::vector<T> &buffer )
+    //! (P is the type in which the property is stored in Particles, e.g. particle_real for a double buffer)
+    template<typename T, typename P = T> void fill_buffer( VectorPatch &vecPatches, size_t iprop, std::vector<T> &buffer )
     {
         const size_t nPatches = vecPatches.size();
-        std::vector<T> *property = NULL;
+        std::vector<P> *property = NULL;
         
         #pragma omp barrier
+        #pragma omp for schedule(runtime)
+        for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
+            Particles * p = getParticles( vecPatches( ipatch ) );
+            p->getProperty( iprop, property );
+            fill_buffer( ipatch, p->numberOfParticles(), *property, buffer );
+        }
+    };
+    
+    //! Fills the part of a buffer owned by patch ipatch with a per-particle quantity of this patch
+    //! (the selected particles if there is a filter, else the nParticles first ones)
+    template<typename T, typename P> void fill_buffer( unsigned int ipatch, size_t nParticles, std::vector<P> &property, std::vector<T> &buffer )
+    {
         if( has_filter ) {
-            #pragma omp for schedule(runtime)
-            for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
-                const size_t patch_nParticles = patch_selection[ipatch].size();
-                getParticles( vecPatches( ipatch ) )->getProperty( iprop, property );
-                size_t i=0;
-                size_t j=patch_start[ipatch];
-                while( i < patch_nParticles ) {
-                    buffer[j] = ( *property )[patch_selection[ipatch][i]];
-                    i++;
-                    j++;
-                }
+            const size_t patch_nParticles = patch_selection[ipatch].size();
+            size_t i=0;
+            size_t j=patch_start[ipatch];
+            while( i < patch_nParticles ) {
+                buffer[j] = property[patch_selection[ipatch][i]];
+                i++;
+                j++;
             }
         } else {
-            #pragma omp for schedule(runtime)
-            for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
-                Particles * p = getParticles( vecPatches( ipatch ) );
-                const size_t patch_nParticles = p->numberOfParticles();
-                p->getProperty( iprop, property );
-                std::copy( property->begin(), property->begin() + patch_nParticles, buffer.begin() + patch_start[ipatch] );
-            }
+            std::copy( property.begin(), property.begin() + nParticles, buffer.begin() + patch_start[ipatch] );
         }
     };
 
@@ -111,6 +115,9 @@ protected:
     //! Tells whether this diag includes a particle filter
     PyObject *filter;
     
+    //! Native version of the filter (NULL if the filter must be run by python)
+    ParticleExpression *compiled_filter_ = NULL;
+    
     //! Selection of the filtered particles in each patch
     std::vector<std::vector<unsigned int> > patch_selection;
     
@@ -127,6 +134,9 @@ protected:
     //! Number of particles shared among patches in this proc
     uint32_t nParticles_local;
     
+    //! Ranks sharing the same output file (the particles are numbered across this communicator)
+    MPI_Comm file_comm_ = MPI_COMM_WORLD;
+    
     //! HDF5 locations where attributes must be written
     bool write_id_ = false; H5Write* loc_id_ = nullptr;
     bool write_charge_ = false; H5Write* loc_charge_ = nullptr;
@@ -6,7 +6,7 @@
 
 using namespace std;
 
-const unsigned int n_quantities_double = 19;
+const unsigned int n_quantities_double = 22;
 const unsigned int n_quantities_uint   = 4;
 
 // Constructor
@@ -107,6 +107,9 @@ void DiagnosticPerformances::openFile( Params &params, SmileiMPI *smpi )
     quantities_double[16] = "timer_envelope"     ;
     quantities_double[17] = "timer_syncSusceptibility"     ;
     quantities_double[18] = "timer_partMerging"     ;
+    quantities_double[19] = "memory_arena"    ;
+    quantities_double[20] = "arena_allocations";
+    quantities_double[21] = "arena_resizes"   ;
     file_->attr( "quantities_double", quantities_double );
     
     file_->flush();
@@ -140,7 +143,7 @@ bool DiagnosticPerformances::prepare( int itime )
 } // END prepare
 
 
-void DiagnosticPerformances::run( SmileiMPI *, VectorPatch &vecPatches, int itime, SimWindow *, Timers &timers )
+void DiagnosticPerformances::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime, SimWindow *, Timers &timers )
 {
     
     #pragma omp master
@@ -224,6 +227,13 @@ void DiagnosticPerformances::run( SmileiMPI *, VectorPatch &vecPatches, int itim
         quantities_double[17] = timers.susceptibility   .getTime();
         quantities_double[18] = timers.particleMerging  .getTime();
         
+        // Memory held by the arenas of the dynamics buffers, and allocator activity
+        double arena_bytes, arena_allocations, arena_resizes;
+        smpi->getDynamicsArenaStatistics( arena_bytes, arena_allocations, arena_resizes );
+        quantities_double[19] = arena_bytes / 1073741824.;
+        quantities_double[20] = arena_allocations;
+        quantities_double[21] = arena_resizes;
+        
         // Write doubles to file
         iteration_group.array( "quantities_double", quantities_double[0], &filespace_double, &memspace_double );
         
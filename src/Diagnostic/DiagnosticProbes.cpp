@@ -356,6 +356,13 @@ DiagnosticProbes::DiagnosticProbes( Params &params, SmileiMPI *smpi, VectorPatch
         }
     }
     
+    // Stencils cannot be cached for the complex modes or the B-TIS3 fields
+#if defined( SMILEI_ACCELERATOR_GPU )
+    use_stencils_ = false;
+#else
+    use_stencils_ = ( geometry != "AMcylindrical" ) && !params.use_BTIS3;
+#endif
+    
     // Extract time_integral
     PyTools::extract( "time_integral", time_integral, "DiagProbe", n_probe );
     if( time_integral && params.hasWindow ) {
@@ -373,6 +380,9 @@ DiagnosticProbes::DiagnosticProbes( Params &params, SmileiMPI *smpi, VectorPatch
         ERROR( "Probe #"<<n_probe<<": unknown datatype `"<<datatype<<"`" );
     }
     
+    // Extract the compression parameters
+    lossy_ = new H5Lossy( "DiagProbe", n_probe, fieldname );
+    
     // Pre-calculate patch size
     patch_length.resize( nDim_particle );
     for( unsigned int k=0; k<nDim_particle; k++ ) {
@@ -427,6 +437,7 @@ DiagnosticProbes::~DiagnosticProbes()
 {
     delete timeSelection;
     delete flush_timeSelection;
+    delete lossy_;
 }
 
 
@@ -465,6 +476,9 @@ void DiagnosticProbes::openFile( Params &, SmileiMPI *smpi )
 void DiagnosticProbes::closeFile()
 {
     if( file_ ) {
+        if( lossy_->active() ) {
+            MESSAGE( 1, "Probe #"<<probe_n<<": "<<lossy_->summary()<<" (master process)" );
+        }
         delete file_;
         file_ = NULL;
     }
@@ -573,6 +587,7 @@ void DiagnosticProbes::createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, d
         // Initialize the list of "fake" particles (points) just as actual macro-particles
         Particles *particles = &( vecPatches( ipatch )->probes[probe_n]->particles );
         particles->initialize( ntot, nDim_particle, false );
+        vecPatches( ipatch )->probes[probe_n]->stencils.clear();
         // In AM, redefine patchmin as rmin and not -rmax anymore
         if( geometry == "AMcylindrical" ) {
             patchMin[1] = patchMax[1] - patch_length[1];
@@ -740,43 +755,62 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         // Interpolate all usual fields on probe ("fake") particles of current patch
         unsigned int iPart_MPI = offset_in_MPI[ipatch];
         unsigned int maxPart_MPI = offset_in_MPI[ipatch] + npart;
+        
+        // The points do not move between two re-creations: their stencils are computed once
+        // and the fields are then interpolated by a sparse gather over the field arrays
+        InterpolationStencils &stencils = patch->probes[probe_n]->stencils;
+        bool cached = use_stencils_ && npart > 0
+                      && ( stencils.built() || patch->probesInterp->stencils( patch->probes[probe_n]->particles, stencils ) );
+        if( cached ) {
+            Field *usual_fields[10] = {
+                patch->EMfields->Ex_, patch->EMfields->Ey_, patch->EMfields->Ez_,
+                patch->EMfields->Bx_m, patch->EMfields->By_m, patch->EMfields->Bz_m,
+                patch->EMfields->Jx_, patch->EMfields->Jy_, patch->EMfields->Jz_, patch->EMfields->rho_
+            };
+            for( unsigned int k=0; k<10; k++ ) {
+                if( fieldlocation[k] != nFields ) {
+                    stencils.gather( usual_fields[k], &( *probesArray )( fieldlocation[k], offset_in_MPI[ipatch] ) );
+                }
+            }
+        } else {
 #if defined( SMILEI_ACCELERATOR_GPU )
-        smpi->resizeDeviceBuffers( ithread,
-                                   nDim_particle,
-                                   npart );
+            smpi->resizeDeviceBuffers( ithread,
+                                       nDim_particle,
+                                       npart );
 #else
-        smpi->resizeBuffers( ithread, nDim_particle, npart, false );
+            smpi->resizeBuffers( ithread, nDim_particle, npart, false );
 #endif
 
-        for( unsigned int ipart=0; ipart<npart; ipart++ ) {
-            int iparticle( ipart ); // Compatibility
-            int false_idx( 0 );   // Use in classical interp for now, not for probes
-            patch->probesInterp->fieldsAndCurrents(
-                patch->EMfields,
-                patch->probes[probe_n]->particles, smpi,
-                &iparticle, &false_idx, ithread,
-                &Jloc_fields, &Rloc_fields
-            );
-            //! here we fill the probe data!!!
-            ( *probesArray )( fieldlocation[0], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+0*npart];
-            ( *probesArray )( fieldlocation[1], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+1*npart];
-            ( *probesArray )( fieldlocation[2], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+2*npart];
-            ( *probesArray )( fieldlocation[3], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+0*npart];
-            ( *probesArray )( fieldlocation[4], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+1*npart];
-            ( *probesArray )( fieldlocation[5], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+2*npart];
-            if (smpi->use_BTIS3){
-                if (fieldlocation[17] < nFields){
-                    ( *probesArray )( fieldlocation[17], iPart_MPI )=smpi->dynamics_Bpart_yBTIS3[ithread][ipart+0*npart];
-                }
-                if (fieldlocation[18] < nFields){
-                    ( *probesArray )( fieldlocation[18], iPart_MPI )=smpi->dynamics_Bpart_zBTIS3[ithread][ipart+0*npart];
+            for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                int iparticle( ipart ); // Compatibility
+                int false_idx( 0 );   // Use in classical interp for now, not for probes
+                patch->probesInterp->fieldsAndCurrents(
+                    patch->EMfields,
+                    patch->probes[probe_n]->particles, smpi,
+                    &iparticle, &false_idx, ithread,
+                    &Jloc_fields, &Rloc_fields
+                );
+                //! here we fill the probe data!!!
+                ( *probesArray )( fieldlocation[0], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+0*npart];
+                ( *probesArray )( fieldlocation[1], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+1*npart];
+                ( *probesArray )( fieldlocation[2], iPart_MPI )=smpi->dynamics_Epart[ithread][ipart+2*npart];
+                ( *probesArray )( fieldlocation[3], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+0*npart];
+                ( *probesArray )( fieldlocation[4], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+1*npart];
+                ( *probesArray )( fieldlocation[5], iPart_MPI )=smpi->dynamics_Bpart[ithread][ipart+2*npart];
+                if (smpi->use_BTIS3){
+                    if (fieldlocation[17] < nFields){
+                        ( *probesArray )( fieldlocation[17], iPart_MPI )=smpi->dynamics_Bpart_yBTIS3[ithread][ipart+0*npart];
+                    }
+                    if (fieldlocation[18] < nFields){
+                        ( *probesArray )( fieldlocation[18], iPart_MPI )=smpi->dynamics_Bpart_zBTIS3[ithread][ipart+0*npart];
+                    }
                 }
+                ( *probesArray )( fieldlocation[6], iPart_MPI )=Jloc_fields.x;
+                ( *probesArray )( fieldlocation[7], iPart_MPI )=Jloc_fields.y;
+                ( *probesArray )( fieldlocation[8], iPart_MPI )=Jloc_fields.z;
+                ( *probesArray )( fieldlocation[9], iPart_MPI )=Rloc_fields;
+                iPart_MPI++;
             }
-            ( *probesArray )( fieldlocation[6], iPart_MPI )=Jloc_fields.x;
-            ( *probesArray )( fieldlocation[7], iPart_MPI )=Jloc_fields.y;
-            ( *probesArray )( fieldlocation[8], iPart_MPI )=Jloc_fields.z;
-            ( *probesArray )( fieldlocation[9], iPart_MPI )=Rloc_fields;
-            iPart_MPI++;
         }
         
         // Calculate Poynting flux on each point if needed
@@ -833,6 +867,10 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
                     unsigned int iloc = species_field_location[ispec][j];
                     int istart( 0 ), iend( npart );
                     double *FieldLoc = &( ( *probesArray )( iloc, offset_in_MPI[ipatch] ) );
+                    if( cached ) {
+                        stencils.gather( patch->EMfields->allFields[start+ifield], FieldLoc );
+                        continue;
+                    }
                     patch->probesInterp->oneField(
                         &patch->EMfields->allFields[start+ifield],
                         patch->probes[probe_n]->particles,
@@ -887,8 +925,14 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
             // Define spaces
             H5Space memspace( {(hsize_t)nFields, nPart_MPI}, {}, {} );
             H5Space filespace( {(hsize_t)nFields, nPart_total_actual}, {0, offset_in_file[0]}, {(hsize_t)nFields, nPart_MPI} );
+            // Round each field for the lossy compression
+            if( lossy_->active() && nPart_MPI > 0 ) {
+                for( unsigned int ifield=0; ifield<nFields; ifield++ ) {
+                    lossy_->round( &( *probesArray )( ifield, 0 ), nPart_MPI, ifield );
+                }
+            }
             // Create new dataset for this timestep
-            H5Write d = file_->array( dataset_name, *(probesArray->data_), &filespace, &memspace, true, file_datatype_ );
+            H5Write d = file_->array( dataset_name, *(probesArray->data_), &filespace, &memspace, true, file_datatype_, lossy_ );
             // Write x_moved
             d.attr( "x_moved", x_moved );
             
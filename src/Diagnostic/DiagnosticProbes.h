@@ -4,6 +4,7 @@
 #include "Diagnostic.h"
 
 #include "Field2D.h"
+#include "Interpolator.h"
 
 
 class DiagnosticProbes : public Diagnostic
@@ -126,6 +127,9 @@ private:
     //! True if this diagnostic requires the pre-calculation of the particle J & Rho
     bool hasRhoJs;
     
+    //! True if the probe points may use cached interpolation stencils
+    bool use_stencils_;
+    
     //! Last iteration when points were re-calculated
     unsigned int last_iteration_points_calculated;
     
@@ -137,6 +141,9 @@ private:
     
     //! Datatype for writing to HDF5 file
     hid_t file_datatype_;
+    
+    //! Lossy compression of the datasets
+    H5Lossy *lossy_;
 };
 
 
@@ -152,6 +159,8 @@ public :
     ~ProbeParticles() {};
     
     Particles particles;
+    //! Cached interpolation indices and weights of the points (emptied when the points are re-created)
+    InterpolationStencils stencils;
     int offset_in_file;
     std::vector<std::vector<double> > integrated_data;
 };
@@ -120,24 +120,25 @@ void DiagnosticRadiationSpectrum::openFile( Params& params, SmileiMPI* smpi )
 void DiagnosticRadiationSpectrum::run( Patch* patch, int, SimWindow* simWindow )
 {
 
-    // Calculate the total number of particles in this patch and resize buffers
-    unsigned int npart = 0;
-    vector<Species *> species;
-    for( unsigned int ispec=0 ; ispec < species_indices.size() ; ispec++ ) {
-        Species *s = patch->vecSpecies[species_indices[ispec]];
-        species.push_back( s );
-        npart += s->getNbrOfParticles();
-    }
-    vector<int> int_buffer( npart, 0 );
-    vector<double> double_buffer( npart );
-    
-    // Get the index (int_buffer) of each particle in the final array (data_sum)
-    histogram->digitize( species, double_buffer, int_buffer, simWindow );
+    // Bins where this thread accumulates
+    bool atomic;
+    double *bins = histogram->threadBins( data_sum, atomic );
     
     // loop species & fill the histogram
-    unsigned int istart = 0;
     for( unsigned int ispec=0 ; ispec < species_indices.size() ; ispec++ ) {
         
+        Species *s = patch->vecSpecies[species_indices[ispec]];
+        unsigned int npart = s->getNbrOfParticles();
+        if( npart == 0 ) {
+            continue;
+        }
+        double *double_buffer;
+        int *index;
+        histogram->workBuffers( npart, double_buffer, index );
+        
+        // Get the index of each particle in the final array (data_sum)
+        histogram->digitize( s, double_buffer, index, npart, simWindow );
+        
         // Sum the data into the data_sum
         // ------------------------------
         
@@ -146,9 +147,6 @@ void DiagnosticRadiationSpectrum::run( Patch* patch, int, SimWindow* simWindow )
         int iphoton_energy_max;
         double coeff = ( ( double ) photon_axis->nbins )/( emax - emin );
         
-        Species *s = patch->vecSpecies[species_indices[ispec]];
-        unsigned int npart = s->getNbrOfParticles();
-        int *index = &int_buffer[istart];
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             int ind = index[ipart];
             if( ind < 0 ) continue; // skip already discarded particles
@@ -183,12 +181,14 @@ void DiagnosticRadiationSpectrum::run( Patch* patch, int, SimWindow* simWindow )
                 nu   = two_third_ov_chi * zeta;
                 cst  = xi * zeta;
                 increment = increment0 * delta_energies[i] * xi * RadiationTools::computeBesselPartsRadiatedPower(nu,cst);
-                #pragma omp atomic
-                data_sum[ind+i] += increment;
+                if( atomic ) {
+                    #pragma omp atomic
+                    bins[ind+i] += increment;
+                } else {
+                    bins[ind+i] += increment;
+                }
             }
         }
-        
-        istart += npart;
     
     }
     
@@ -437,11 +437,11 @@ void DiagnosticScalar::compute( Patch *patch, int )
             const unsigned int nPart=vecSpecies[ispec]->getNbrOfParticles(); // number of particles
 
 // #if defined( SMILEI_ACCELERATOR_GPU )
-            const double *const __restrict__ weight_ptr = vecSpecies[ispec]->particles->getPtrWeight();
+            const particle_real *const __restrict__ weight_ptr = vecSpecies[ispec]->particles->getPtrWeight();
             const short  *const __restrict__ charge_ptr = vecSpecies[ispec]->particles->getPtrCharge();
-            const double *const __restrict__ momentum_x = vecSpecies[ispec]->particles->getPtrMomentum(0);
-            const double *const __restrict__ momentum_y = vecSpecies[ispec]->particles->getPtrMomentum(1);
-            const double *const __restrict__ momentum_z = vecSpecies[ispec]->particles->getPtrMomentum(2);
+            const particle_real *const __restrict__ momentum_x = vecSpecies[ispec]->particles->getPtrMomentum(0);
+            const particle_real *const __restrict__ momentum_y = vecSpecies[ispec]->particles->getPtrMomentum(1);
+            const particle_real *const __restrict__ momentum_z = vecSpecies[ispec]->particles->getPtrMomentum(2);
 // #endif
 
             if( vecSpecies[ispec]->mass_ > 0 ) {
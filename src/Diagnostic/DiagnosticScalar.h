@@ -125,6 +125,12 @@ public :
     
     virtual bool needsRhoJs( int itime ) override;
     
+    //! Scalars are written to a text file
+    bool writesHDF5( int ) override
+    {
+        return false;
+    };
+    
     //! get a particular scalar
     double getScalar( std::string name );
     
@@ -152,6 +152,12 @@ DiagnosticScreen::DiagnosticScreen(
     
     data_sum.resize( output_size, 0. );
     
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    opposite_.resize( nthreads );
+    
 } // END DiagnosticScreen::DiagnosticScreen
 
 
@@ -209,30 +215,28 @@ void DiagnosticScreen::run( Patch *patch, int, SimWindow *simWindow )
         ERROR( "unkown screen_type " << screen_type );
     }
     
-    // Calculate the total number of particles in this patch and resize buffers
-    unsigned int npart_total = 0;
-    vector<Species *> species;
-    for( unsigned int ispec=0 ; ispec < species_indices.size() ; ispec++ ) {
-        Species *s = patch->vecSpecies[species_indices[ispec]];
-        species.push_back( s );
-        npart_total += s->getNbrOfParticles();
-    }
-    vector<int> int_buffer( npart_total, 0 );
-    vector<double> double_buffer( npart_total );
-    bool opposite[npart_total]; // cannot use vector<bool>
-    for( unsigned int i=0; i<npart_total; i++ ) {
-        opposite[i] = false;
-    }
+    int ithread = 0;
+#ifdef _OPENMP
+    ithread = omp_get_thread_num();
+#endif
     
     // loop species & find crossing particles
-    unsigned int nuseful = 0;
-    unsigned int istart = 0;
     for( unsigned int ispec=0 ; ispec < species_indices.size() ; ispec++ ) {
     
         Species *s = patch->vecSpecies[species_indices[ispec]];
         unsigned int npart = s->getNbrOfParticles();
-        int *index = &int_buffer[istart];
-        bool *opp = &opposite[istart];
+        if( npart == 0 ) {
+            continue;
+        }
+        double *double_buffer;
+        int *index;
+        histogram->workBuffers( npart, double_buffer, index );
+        if( opposite_[ithread].size() < npart ) {
+            opposite_[ithread].resize( npart );
+        }
+        char *opposite = opposite_[ithread].data();
+        fill( opposite, opposite+npart, 0 );
+        unsigned int nuseful = 0;
        
         // Fill the int_buffer with -1 (not crossing screen) and 0 (crossing screen)
         if( screen_type == 0 ) { // plane
@@ -248,7 +252,7 @@ void DiagnosticScreen::run( Patch *patch, int, SimWindow *simWindow )
                     index[ipart] = 0;
                     nuseful++;
                     if( side < 0. ) {
-                        opp[ipart] = true;
+                        opposite[ipart] = 1;
                     }
                 } else {
                     index[ipart] = -1;
@@ -269,7 +273,7 @@ void DiagnosticScreen::run( Patch *patch, int, SimWindow *simWindow )
                     index[ipart] = 0;
                     nuseful++;
                     if( side > 0. ) {
-                        opp[ipart] = true;
+                        opposite[ipart] = 1;
                     }
                 } else {
                     index[ipart] = -1;
@@ -295,7 +299,7 @@ void DiagnosticScreen::run( Patch *patch, int, SimWindow *simWindow )
                     index[ipart] = 0;
                     nuseful++;
                     if( side > 0. ) {
-                        opp[ipart] = true;
+                        opposite[ipart] = 1;
                     }
                 } else {
                     index[ipart] = -1;
@@ -303,38 +307,36 @@ void DiagnosticScreen::run( Patch *patch, int, SimWindow *simWindow )
             }
         }
         
-        istart += npart;
-    }
-    
-    if( nuseful == 0 ) {
-        return;
-    }
-    
-    histogram->digitize( species, double_buffer, int_buffer, simWindow );
-    histogram->valuate( species, double_buffer, int_buffer );
-    
-    if( direction_type == 1 ) { // canceling
-        for( unsigned int ipart=0; ipart<npart_total; ipart++ ) {
-            if( opposite[ipart] ) {
-                double_buffer[ipart] = -double_buffer[ipart];
-            }
+        if( nuseful == 0 ) {
+            continue;
         }
-    } else if( direction_type == 2 ) { // forward
-        for( unsigned int ipart=0; ipart<npart_total; ipart++ ) {
-            if( opposite[ipart] ) {
-                double_buffer[ipart] = 0.;
+        
+        histogram->digitize( s, double_buffer, index, npart, simWindow );
+        histogram->valuate( s, double_buffer, index );
+        
+        if( direction_type == 1 ) { // canceling
+            for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                if( opposite[ipart] ) {
+                    double_buffer[ipart] = -double_buffer[ipart];
+                }
             }
-        }
-    } else if( direction_type == 3 ) { // backward
-        for( unsigned int ipart=0; ipart<npart_total; ipart++ ) {
-            if( int_buffer[ipart]>=0 && !opposite[ipart] ) {
-                double_buffer[ipart] = 0.;
+        } else if( direction_type == 2 ) { // forward
+            for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                if( opposite[ipart] ) {
+                    double_buffer[ipart] = 0.;
+                }
+            }
+        } else if( direction_type == 3 ) { // backward
+            for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                if( index[ipart]>=0 && !opposite[ipart] ) {
+                    double_buffer[ipart] = 0.;
+                }
             }
         }
+        
+        histogram->distribute( double_buffer, index, npart, data_sum );
     }
     
-    histogram->distribute( double_buffer, int_buffer, data_sum );
-    
 } // END run
 
 bool DiagnosticScreen::writeNow( int itime ) {
@@ -68,6 +68,9 @@ private :
     
     //! Copy of the timestep
     double dt;
+    
+    //! For each thread, whether particles cross the screen in the opposite direction
+    std::vector<std::vector<char> > opposite_;
 };
 
 #endif
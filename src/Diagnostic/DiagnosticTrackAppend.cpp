@@ -0,0 +1,256 @@
+#include "PyTools.h"
+
+#include <string>
+#include <sstream>
+#include <iomanip>
+
+#include "DiagnosticTrackAppend.h"
+#include "VectorPatch.h"
+#include "Params.h"
+
+using namespace std;
+
+DiagnosticTrackAppend::DiagnosticTrackAppend( Params &params, SmileiMPI *smpi, VectorPatch &vecPatches, unsigned int iDiagTrackParticles, unsigned int idiag, OpenPMDparams &oPMD ) :
+    DiagnosticTrack( params, smpi, vecPatches, iDiagTrackParticles, idiag, oPMD )
+{
+    PyTools::extract( "ranks_per_file", ranks_per_file_, "DiagTrackParticles", iDiagTrackParticles );
+    if( ranks_per_file_ < 1 ) {
+        ERROR( "DiagTrackParticles #" << iDiagTrackParticles << ": `ranks_per_file` must be a positive integer" );
+    }
+    
+    // Consecutive ranks are grouped, and each group shares one file
+    int file_index = smpi->getRank() / ranks_per_file_;
+    MPI_Comm_split( smpi->world(), file_index, smpi->getRank(), &file_comm_ );
+    MPI_Comm_rank( file_comm_, &file_rank_ );
+    MPI_Comm_size( file_comm_, &file_size_ );
+    
+    ostringstream hdf_filename( "" );
+    hdf_filename << "TrackParticlesAppend_" << species_name_ << "_" << setfill( '0' ) << setw( 6 ) << file_index << ".h5";
+    filename = hdf_filename.str();
+    
+    if( smpi->isMaster() ) {
+        int nfiles = ( smpi->getSize() + ranks_per_file_ - 1 ) / ranks_per_file_;
+        MESSAGE( 2, "Append layout in " << nfiles << " file(s)" );
+    }
+}
+
+DiagnosticTrackAppend::~DiagnosticTrackAppend()
+{
+    closeFile();
+    MPI_Comm_free( &file_comm_ );
+}
+
+void DiagnosticTrackAppend::openFile( Params &params, SmileiMPI *smpi )
+{
+    // Create HDF5 file, shared by the ranks of file_comm_ only
+    file_ = new H5Write( filename, file_size_ > 1 ? &file_comm_ : NULL );
+    file_->attr( "name", diag_name_ );
+    file_->attr( "first_rank", smpi->getRank() - file_rank_ );
+    file_->attr( "number_of_ranks", file_size_ );
+    file_->attr( "number_of_files", ( smpi->getSize() + ranks_per_file_ - 1 ) / ranks_per_file_ );
+    
+    // Groups for openPMD
+    H5Write data_group( file_, "data" );
+    H5Write iteration_group( &data_group, "0" );
+    H5Write particles_group( &iteration_group, "particles" );
+    H5Write species_group( &particles_group, species_name_ );
+    
+    // Attributes for openPMD
+    openPMD_->writeRootAttributes( *file_, "no_meshes", "particles/" );
+    openPMD_->writeBasePathAttributes( iteration_group, 0 );
+    openPMD_->writeParticlesAttributes( particles_group );
+    openPMD_->writeSpeciesAttributes( species_group );
+    
+    // PositionOffset (for OpenPMD)
+    string xyz = "xyz";
+    H5Write positionoffset_group = species_group.group( "positionOffset" );
+    openPMD_->writeRecordAttributes( positionoffset_group, SMILEI_UNIT_POSITION );
+    vector<uint64_t> np = {0};
+    for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
+        H5Write xyz_group = positionoffset_group.group( xyz.substr( idim, 1 ) );
+        openPMD_->writeComponentAttributes( xyz_group, SMILEI_UNIT_POSITION );
+        xyz_group.attr( "value", 0. );
+        xyz_group.attr( "shape", np, H5T_NATIVE_UINT64 );
+    }
+    
+    // Make empty datasets, extended at each output by chunks of records
+    H5Space file_space( 0, 0, 0, 16384, true );
+    loc_id_ = newDataset( species_group, "id", H5T_NATIVE_UINT64, file_space, SMILEI_UNIT_NONE );
+    openPMD_->writeRecordAttributes( *loc_id_, SMILEI_UNIT_NONE );
+    if( write_charge_ ) {
+        loc_charge_ = newDataset( species_group, "charge", H5T_NATIVE_SHORT, file_space, SMILEI_UNIT_CHARGE );
+        openPMD_->writeRecordAttributes( *loc_charge_, SMILEI_UNIT_CHARGE );
+    }
+    if( write_any_position_ ) {
+        H5Write position_group( &species_group, "position" );
+        openPMD_->writeRecordAttributes( position_group, SMILEI_UNIT_POSITION );
+        for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
+            if( write_position_[idim] ) {
+                loc_position_[idim] = newDataset( position_group, xyz.substr( idim, 1 ).c_str(), H5T_NATIVE_DOUBLE, file_space, SMILEI_UNIT_POSITION );
+            }
+        }
+    }
+    if( write_any_momentum_ ) {
+        H5Write momentum_group( &species_group, "momentum" );
+        openPMD_->writeRecordAttributes( momentum_group, SMILEI_UNIT_MOMENTUM );
+        for( unsigned int idim=0; idim<3; idim++ ) {
+            if( write_momentum_[idim] ) {
+                loc_momentum_[idim] = newDataset( momentum_group, xyz.substr( idim, 1 ).c_str(), H5T_NATIVE_DOUBLE, file_space, SMILEI_UNIT_MOMENTUM );
+            }
+        }
+    }
+    if( write_weight_ ) {
+        loc_weight_ = newDataset( species_group, "weight", H5T_NATIVE_DOUBLE, file_space, SMILEI_UNIT_WEIGHT );
+        openPMD_->writeRecordAttributes( *loc_weight_, SMILEI_UNIT_WEIGHT );
+    }
+    if( write_chi_ ) {
+        loc_chi_ = newDataset( species_group, "chi", H5T_NATIVE_DOUBLE, file_space, SMILEI_UNIT_NONE );
+        openPMD_->writeRecordAttributes( *loc_chi_, SMILEI_UNIT_NONE );
+    }
+    if( write_any_E_ ) {
+        H5Write E_group( &species_group, "E" );
+        openPMD_->writeRecordAttributes( E_group, SMILEI_UNIT_EFIELD );
+        for( unsigned int idim=0; idim<3; idim++ ) {
+            if( write_E_[idim] ) {
+                loc_E_[idim] = newDataset( E_group, xyz.substr( idim, 1 ).c_str(), H5T_NATIVE_DOUBLE, file_space, SMILEI_UNIT_EFIELD );
+            }
+        }
+    }
+    if( write_any_B_ ) {
+        H5Write B_group( &species_group, "B" );
+        openPMD_->writeRecordAttributes( B_group, SMILEI_UNIT_BFIELD );
+        for( unsigned int idim=0; idim<3; idim++ ) {
+            if( write_B_[idim] ) {
+                loc_B_[idim] = newDataset( B_group, xyz.substr( idim, 1 ).c_str(), H5T_NATIVE_DOUBLE, file_space, SMILEI_UNIT_BFIELD );
+            }
+        }
+    }
+    if( write_any_W_ ) {
+        H5Write W_group( &species_group, "W" );
+        openPMD_->writeRecordAttributes( W_group, SMILEI_UNIT_ENERGY );
+        for( unsigned int idim=0; idim<3; idim++ ) {
+            if( write_W_[idim] ) {
+                loc_W_[idim] = newDataset( W_group, xyz.substr( idim, 1 ).c_str(), H5T_NATIVE_DOUBLE, file_space, SMILEI_UNIT_ENERGY );
+            }
+        }
+    }
+    
+    // Make the index datasets, with one row per output iteration
+    hsize_t ntimes = timeSelection->howManyTimesBefore( params.n_time ) + 1;
+    hsize_t nranks = file_size_;
+    H5Space fs_npart( {0, 2}, {0, 0}, {0, 2}, {ntimes, 2}, {true, false} );
+    iteration_npart_ = new H5Write( file_, "iteration_npart", H5T_NATIVE_INT64, &fs_npart );
+    H5Space fs_x_moved( 0, 0, 0, ntimes, true );
+    x_moved_ = new H5Write( file_, "x_moved", H5T_NATIVE_DOUBLE, &fs_x_moved );
+    H5Space fs_latest_IDs( {0, nranks}, {0, 0}, {0, nranks}, {ntimes, nranks}, {true, false} );
+    latest_IDs_ = new H5Write( file_, "latest_IDs", H5T_NATIVE_UINT64, &fs_latest_IDs );
+    
+    file_->flush();
+}
+
+void DiagnosticTrackAppend::closeFile()
+{
+    if( file_ ) {
+        for( auto d : loc_position_ ) delete d;
+        for( auto d : loc_momentum_ ) delete d;
+        delete loc_id_;
+        delete loc_charge_;
+        delete loc_weight_;
+        delete loc_chi_;
+        for( auto d : loc_E_ ) delete d;
+        for( auto d : loc_B_ ) delete d;
+        for( auto d : loc_W_ ) delete d;
+        delete iteration_npart_;
+        delete x_moved_;
+        delete latest_IDs_;
+        delete file_;
+        file_ = nullptr;
+    }
+}
+
+
+H5Space * DiagnosticTrackAppend::prepareH5( SimWindow *simWindow, SmileiMPI *, int itime, uint32_t nParticles_local, uint64_t nParticles_global, uint64_t offset )
+{
+    // Resize datasets
+    hsize_t new_size = nParticles_written + nParticles_global;
+    loc_id_->extend( new_size );
+    if( write_charge_ ) {
+        loc_charge_->extend( new_size );
+    }
+    for( unsigned int idim=0; idim<3; idim++ ) {
+        if( write_position_[idim] ) {
+            loc_position_[idim]->extend( new_size );
+        }
+        if( write_momentum_[idim] ) {
+            loc_momentum_[idim]->extend( new_size );
+        }
+        if( write_E_[idim] ) {
+            loc_E_[idim]->extend( new_size );
+        }
+        if( write_B_[idim] ) {
+            loc_B_[idim]->extend( new_size );
+        }
+        if( write_W_[idim] ) {
+            loc_W_[idim]->extend( new_size );
+        }
+    }
+    if( write_weight_ ) {
+        loc_weight_->extend( new_size );
+    }
+    if( write_chi_ ) {
+        loc_chi_->extend( new_size );
+    }
+    
+    // Update the index: each rank gives its latest ID, and the first rank the rest
+    hsize_t nranks = file_size_;
+    iteration_npart_->extend( {nTimes_written+1, 2} );
+    x_moved_->extend( nTimes_written+1 );
+    latest_IDs_->extend( {nTimes_written+1, nranks} );
+    H5Space fs_latest_IDs( {nTimes_written+1, nranks}, {nTimes_written, ( hsize_t )file_rank_}, {1, 1} );
+    H5Space ms_latest_IDs( 1 );
+    latest_IDs_->write( latest_Id, H5T_NATIVE_UINT64, &fs_latest_IDs, &ms_latest_IDs );
+    if( file_rank_ == 0 ) {
+        bool independent = file_size_ > 1;
+        H5Space fs_npart( {nTimes_written+1, 2}, {nTimes_written, 0}, {1, 2} );
+        H5Space ms_npart( 2 );
+        uint64_t i_n[2] = { ( uint64_t ) itime, new_size };
+        iteration_npart_->write( i_n[0], H5T_NATIVE_UINT64, &fs_npart, &ms_npart, independent );
+        H5Space fs_x_moved( nTimes_written+1, nTimes_written, 1 );
+        H5Space ms_x_moved( 1 );
+        double x_moved = simWindow ? simWindow->getXmoved() : 0.;
+        x_moved_->write( x_moved, H5T_NATIVE_DOUBLE, &fs_x_moved, &ms_x_moved, independent );
+    }
+    nTimes_written += 1;
+    
+    // Filespace
+    hsize_t full_offset = nParticles_written + offset;
+    nParticles_written = new_size;
+    return new H5Space( new_size, full_offset, nParticles_local );
+}
+
+
+void DiagnosticTrackAppend::write_scalar_uint64( H5Write * location, string /*name*/, uint64_t &buffer, H5Space *file_space, H5Space *mem_space, unsigned int /*unit_type*/ )
+{
+    location->write( buffer, H5T_NATIVE_UINT64, file_space, mem_space );
+}
+void DiagnosticTrackAppend::write_scalar_short( H5Write * location, string /*name*/, short &buffer, H5Space *file_space, H5Space *mem_space, unsigned int /*unit_type*/ )
+{
+    location->write( buffer, H5T_NATIVE_SHORT, file_space, mem_space );
+}
+void DiagnosticTrackAppend::write_scalar_double( H5Write * location, string /*name*/, double &buffer, H5Space *file_space, H5Space *mem_space, unsigned int /*unit_type*/ )
+{
+    location->write( buffer, H5T_NATIVE_DOUBLE, file_space, mem_space );
+}
+
+void DiagnosticTrackAppend::write_component_uint64( H5Write * location, string /*name*/, uint64_t &buffer, H5Space *file_space, H5Space *mem_space, unsigned int /*unit_type*/ )
+{
+    location->write( buffer, H5T_NATIVE_UINT64, file_space, mem_space );
+}
+void DiagnosticTrackAppend::write_component_short( H5Write * location, string /*name*/, short &buffer, H5Space *file_space, H5Space *mem_space, unsigned int /*unit_type*/ )
+{
+    location->write( buffer, H5T_NATIVE_SHORT, file_space, mem_space );
+}
+void DiagnosticTrackAppend::write_component_double( H5Write * location, string /*name*/, double &buffer, H5Space *file_space, H5Space *mem_space, unsigned int /*unit_type*/ )
+{
+    location->write( buffer, H5T_NATIVE_DOUBLE, file_space, mem_space );
+}
@@ -0,0 +1,71 @@
+#ifndef DIAGNOSTICTRACKAPPEND_H
+#define DIAGNOSTICTRACKAPPEND_H
+
+#include "DiagnosticTrack.h"
+
+class Patch;
+class Params;
+class SmileiMPI;
+
+//! Tracked particles written with `layout="append"`: instead of one group per iteration in a
+//! file shared by all ranks, each group of `ranks_per_file` ranks appends the records of its
+//! particles to chunked, extendable datasets in its own file, without any global numbering.
+//! The small `iteration_npart` index gives the range of records of each iteration.
+class DiagnosticTrackAppend : public DiagnosticTrack
+{
+
+public :
+    //! Default constructor
+    DiagnosticTrackAppend( Params &params, SmileiMPI *smpi, VectorPatch &vecPatches, unsigned int, unsigned int, OpenPMDparams & );
+    //! Default destructor
+    ~DiagnosticTrackAppend() override;
+    
+    void openFile( Params &params, SmileiMPI *smpi ) override;
+    
+    void closeFile() override;
+    
+    //! Extend the datasets and the index
+    H5Space * prepareH5( SimWindow *simWindow, SmileiMPI *smpi, int itime, uint32_t nParticles_local, uint64_t nParticles_global, uint64_t offset ) override;
+    
+    //! The datasets stay open until the file is closed
+    void deleteH5() override {};
+    
+    //! Write a dataset
+    void write_scalar_uint64( H5Write * location, std::string name, uint64_t &buffer, H5Space *file_space, H5Space *mem_space, unsigned int unit_type ) override;
+    void write_scalar_short ( H5Write * location, std::string name, short    &buffer, H5Space *file_space, H5Space *mem_space, unsigned int unit_type ) override;
+    void write_scalar_double( H5Write * location, std::string name, double   &buffer, H5Space *file_space, H5Space *mem_space, unsigned int unit_type ) override;
+    void write_component_uint64( H5Write * location, std::string name, uint64_t &buffer, H5Space *file_space, H5Space *mem_space, unsigned int unit_type ) override;
+    void write_component_short ( H5Write * location, std::string name, short    &buffer, H5Space *file_space, H5Space *mem_space, unsigned int unit_type ) override;
+    void write_component_double( H5Write * location, std::string name, double   &buffer, H5Space *file_space, H5Space *mem_space, unsigned int unit_type ) override;
+    
+    H5Write * newDataset( H5Write &group, std::string name, hid_t dtype, H5Space &file_space, unsigned int unit_type ) {
+        H5Write * d = new H5Write( &group, name, dtype, &file_space );
+        openPMD_->writeComponentAttributes( *d, unit_type );
+        return d;
+    };
+
+private :
+
+    //! Number of ranks sharing each file
+    int ranks_per_file_;
+    
+    //! Rank in file_comm_ and number of ranks in file_comm_
+    int file_rank_, file_size_;
+    
+    //! Number of particles previously written in the file
+    hsize_t nParticles_written = 0;
+    
+    //! Number of times the file was previously written
+    hsize_t nTimes_written = 0;
+    
+    //! Index: iteration and end of its records (one row per output)
+    H5Write * iteration_npart_ = nullptr;
+    
+    //! Index: moving window position (one element per output)
+    H5Write * x_moved_ = nullptr;
+    
+    //! Index: latest ID of each rank of the file (one row per output)
+    H5Write * latest_IDs_ = nullptr;
+};
+
+#endif
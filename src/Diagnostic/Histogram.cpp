@@ -7,112 +7,176 @@
 
 using namespace std;
 
+//! Maximum number of private bins of all threads, beyond which the threads share the output with atomic operations
+static const size_t max_private_bins = 1<<25;
+
+Histogram::Histogram()
+{
+    nthreads_ = 1;
+#ifdef _OPENMP
+    nthreads_ = omp_get_max_threads();
+#endif
+    double_buffers_.resize( nthreads_ );
+    int_buffers_   .resize( nthreads_ );
+    private_bins_  .resize( nthreads_ );
+    private_used_  .resize( nthreads_, 0 );
+}
+
+// Index of the particles along one axis, merged with the index along the previous axes.
+// Scale and edges are known at compile time so that the loop has no branch.
+template<bool logscale, bool edge_inclusive>
+static void digitizeAxis( const double *location, int *index, unsigned int npart, double actual_min, double coeff, int nbins )
+{
+    const double last = ( double )( nbins-1 );
+    #pragma omp simd
+    for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
+        double x = logscale ? log10( abs( location[ipart] ) ) : location[ipart];
+        double d = floor( ( x-actual_min ) * coeff );
+        // particles out of the "box" are discarded, unless edge_inclusive
+        bool inside = edge_inclusive || ( d >= 0. && d < nbins );
+        int ind = ( int ) fmin( fmax( d, 0. ), last );
+        // The indexes are "reshaped" in one dimension.
+        // For instance, in 3d, the index has the form  i = i3 + n3*( i2 + n2*i1 )
+        index[ipart] = ( index[ipart] < 0 || !inside ) ? -1 : index[ipart] * nbins + ind;
+    }
+}
+
 // Loop on the different axes requested and compute the output index of each particle
-void Histogram::digitize( vector<Species *> species,
-                          vector<double> &double_buffer,
-                          vector<int>    &int_buffer,
+void Histogram::digitize( Species *s,
+                          double *double_buffer,
+                          int    *int_buffer,
+                          unsigned int npart,
                           SimWindow *simWindow )
 {
-    unsigned int npart = double_buffer.size();
-    
     for( unsigned int iaxis=0 ; iaxis < axes.size() ; iaxis++ ) {
         
         HistogramAxis * axis = axes[iaxis];
         
-        // first loop on particles to store the indexing (axis) quantity
-        unsigned int istart = 0;
-        for( unsigned int ispec=0; ispec < species.size(); ispec++ ) {
-            unsigned int npart = species[ispec]->getNbrOfParticles();
-            axis->calculate_locations( species[ispec], &double_buffer[istart], &int_buffer[istart], npart, simWindow );
-            istart += npart;
-        }
-        // Now, double_buffer has the location of each particle along the axis
-        
-        // if log scale, loop again and convert to log
-        if( axis->logscale ) {
-            for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
-                if( int_buffer[ipart] < 0 ) {
-                    continue;
-                }
-                double_buffer[ipart] = log10( abs( double_buffer[ipart] ) );
-            }
-        }
+        // Store the indexing (axis) quantity
+        axis->calculate_locations( s, double_buffer, int_buffer, npart, simWindow );
         
         double actual_min = axis->logscale ? log10( axis->global_min ) : axis->global_min;
         double actual_max = axis->logscale ? log10( axis->global_max ) : axis->global_max;
         double coeff = ( ( double ) axis->nbins )/( actual_max - actual_min );
         
-        // The indexes are "reshaped" in one dimension.
-        // For instance, in 3d, the index has the form  i = i3 + n3*( i2 + n2*i1 )
-        // Here we do the multiplication by n3 or n2 (etc.)
-        if( iaxis>0 ) {
-            for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
-                int_buffer[ipart] *= axis->nbins;
-            }
-        }
-        
-        // loop again on the particles and calculate the index
-        // This is separated in two cases: edge_inclusive and edge_exclusive
-        if( !axis->edge_inclusive ) { // if the particles out of the "box" must be excluded
-        
-            for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
-                // skip already discarded particles
-                if( int_buffer[ipart] < 0 ) {
-                    continue;
-                }
-                // calculate index
-                int ind = floor( ( double_buffer[ipart]-actual_min ) * coeff );
-                // index valid only if in the "box"
-                if( ind >= 0  &&  ind < axis->nbins ) {
-                    int_buffer[ipart] += ind;
-                } else {
-                    int_buffer[ipart] = -1;    // discard particle
-                }
+        // Calculate the index in a single pass
+        if( axis->logscale ) {
+            if( axis->edge_inclusive ) {
+                digitizeAxis<true, true>( double_buffer, int_buffer, npart, actual_min, coeff, axis->nbins );
+            } else {
+                digitizeAxis<true, false>( double_buffer, int_buffer, npart, actual_min, coeff, axis->nbins );
             }
-            
-        } else { // if the particles out of the "box" must be included
-
-            for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
-                // skip already discarded particles
-                if( int_buffer[ipart] < 0 ) {
-                    continue;
-                }
-                // calculate index
-                int ind = floor( ( double_buffer[ipart]-actual_min ) * coeff );
-                // move out-of-range indexes back into range
-                if( ind < 0 ) {
-                    ind = 0;
-                } else if( ind >= axis->nbins ) {
-                    ind = axis->nbins-1;
-                }
-                int_buffer[ipart] += ind;
+        } else {
+            if( axis->edge_inclusive ) {
+                digitizeAxis<false, true>( double_buffer, int_buffer, npart, actual_min, coeff, axis->nbins );
+            } else {
+                digitizeAxis<false, false>( double_buffer, int_buffer, npart, actual_min, coeff, axis->nbins );
             }
-
         }
         
     } // loop axes
 }
 
 void Histogram::distribute(
-    std::vector<double> &double_buffer,
-    std::vector<int>    &int_buffer,
+    double *double_buffer,
+    int    *int_buffer,
+    unsigned int npart,
     std::vector<double> &output_array )
 {
-
-    unsigned int ipart, npart=double_buffer.size();
-    int ind;
+    bool atomic;
+    double *bins = threadBins( output_array, atomic );
     
-    // Sum the data into the data_sum according to the indexes
+    // Sum the data into the bins according to the indexes
     // ---------------------------------------------------------------
-    for( ipart = 0 ; ipart < npart ; ipart++ ) {
-        ind = int_buffer[ipart];
-        if( ind<0 ) {
-            continue;    // skip discarded particles
+    if( atomic ) {
+        for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
+            int ind = int_buffer[ipart];
+            if( ind<0 ) {
+                continue;    // skip discarded particles
+            }
+            #pragma omp atomic
+            bins[ind] += double_buffer[ipart];
         }
-        #pragma omp atomic
-        output_array[ind] += double_buffer[ipart];
+    } else {
+        for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
+            int ind = int_buffer[ipart];
+            if( ind<0 ) {
+                continue;    // skip discarded particles
+            }
+            bins[ind] += double_buffer[ipart];
+        }
+    }
+    
+}
+
+void Histogram::workBuffers( unsigned int npart, double *&double_buffer, int *&int_buffer )
+{
+    int ithread = 0;
+#ifdef _OPENMP
+    ithread = omp_get_thread_num();
+#endif
+    if( double_buffers_[ithread].size() < npart ) {
+        double_buffers_[ithread].resize( npart );
+        int_buffers_   [ithread].resize( npart );
+    }
+    double_buffer = double_buffers_[ithread].data();
+    int_buffer    = int_buffers_   [ithread].data();
+    fill( int_buffer, int_buffer+npart, 0 );
+}
+
+double *Histogram::threadBins( std::vector<double> &output, bool &atomic )
+{
+    atomic = false;
+    if( nthreads_ == 1 ) {
+        return output.data();
+    }
+    if( sharedBins( output.size() ) ) {
+        atomic = true;
+        return output.data();
+    }
+    int ithread = 0;
+#ifdef _OPENMP
+    ithread = omp_get_thread_num();
+#endif
+    if( private_bins_[ithread].size() != output.size() ) {
+        private_bins_[ithread].assign( output.size(), 0. );
+    }
+    private_used_[ithread] = 1;
+    return private_bins_[ithread].data();
+}
+
+bool Histogram::sharedBins( size_t nbins ) const
+{
+    return nthreads_ > 1 && nbins * nthreads_ > max_private_bins;
+}
+
+void Histogram::reduceThreads( std::vector<double> &output )
+{
+    bool used = false;
+    for( unsigned int ithread=0; ithread<nthreads_; ithread++ ) {
+        used = used || private_used_[ithread];
+    }
+    if( ! used ) {
+        return;
     }
     
+    // Each thread sums a slice of the bins
+    #pragma omp for schedule(static)
+    for( unsigned int i=0; i<output.size(); i++ ) {
+        for( unsigned int ithread=0; ithread<nthreads_; ithread++ ) {
+            if( private_used_[ithread] ) {
+                output[i] += private_bins_[ithread][i];
+            }
+        }
+    }
+    // The private bins are released: they are only held while the particles are binned
+    #pragma omp single
+    {
+        for( unsigned int ithread=0; ithread<nthreads_; ithread++ ) {
+            vector<double>().swap( private_bins_[ithread] );
+        }
+        fill( private_used_.begin(), private_used_.end(), 0 );
+    }
 }
 
 
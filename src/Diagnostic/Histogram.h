@@ -72,33 +72,47 @@ public:
 class Histogram
 {
 public:
-    Histogram() {};
+    Histogram();
     virtual ~Histogram() {
         for( unsigned int iaxe=0; iaxe<axes.size(); iaxe++ ) {
             delete axes[iaxe];
         }
     };
     
-    //! Compute the index of each particle in the final histogram
-    void digitize( std::vector<Species *>, std::vector<double> &, std::vector<int> &, SimWindow * );
+    //! Compute the index of each particle of one species in the final histogram
+    void digitize( Species *, double *, int *, unsigned int, SimWindow * );
     //! Calculate the quantity of each particle to be summed in the histogram
     virtual void valuate( Species *, double *, int * ) {
         ERROR( "`deposited_quantity` should not be empty" );
     };
-    //! Same as `valuate` for all species
-    void valuate( std::vector<Species *> species, std::vector<double> &double_buffer, std::vector<int> &int_buffer ) {
-        unsigned int istart = 0;
-        for( unsigned int ispec=0; ispec < species.size(); ispec++ ) {
-            valuate( species[ispec], &double_buffer[istart], &int_buffer[istart] );
-            istart += species[ispec]->getNbrOfParticles();
-        }
-    };
-    //! Add the contribution of each particle in the histogram
-    void distribute( std::vector<double> &, std::vector<int> &, std::vector<double> & );
-
+    //! Add the contribution of each particle in the bins of the current thread
+    void distribute( double *, int *, unsigned int, std::vector<double> & );
+    
+    //! Work buffers of the current thread for npart particles (indexes set to 0)
+    void workBuffers( unsigned int npart, double *&double_buffer, int *&int_buffer );
+    //! Bins where the current thread accumulates: private bins if possible, otherwise the output array
+    //! (then `atomic` is true when other threads write in it too)
+    double *threadBins( std::vector<double> &output, bool &atomic );
+    //! True if the threads accumulate directly in an output of nbins bins, too large to be privatised
+    bool sharedBins( size_t nbins ) const;
+    //! Sum the private bins of all threads into the output, and release them (must be called by all threads)
+    void reduceThreads( std::vector<double> &output );
+    
     std::string deposited_quantity;
-
+    
     std::vector<HistogramAxis *> axes;
+    
+private:
+    //! Number of threads
+    unsigned int nthreads_;
+    
+    //! Work buffers of each thread
+    std::vector<std::vector<double> > double_buffers_;
+    std::vector<std::vector<int> > int_buffers_;
+    
+    //! Private bins of each thread (allocated until reduceThreads), and whether they contain data
+    std::vector<std::vector<double> > private_bins_;
+    std::vector<char> private_used_;
 };
 
 
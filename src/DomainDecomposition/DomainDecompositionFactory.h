@@ -6,6 +6,8 @@
 #include "HilbertDomainDecomposition.h"
 // Patches decomposition along a linearized curve
 #include "LinearizedDomainDecomposition.h"
+// Patches decomposition by recursive coordinate bisection
+#include "RCBDomainDecomposition.h"
 // Domain decomposition (linearized)
 #include "RegionDomainDecomposition.h"
 
@@ -26,6 +28,8 @@ public:
             } else {
                 ERROR( "Unknown geometry" );
             }
+        } else if( params.patch_arrangement=="rcb" ) {
+            domain_decomposition = new RCBDomainDecomposition( params );
         } else {
         
             bool enable_diagField( true );
@@ -0,0 +1,68 @@
+#include "RCBDomainDecomposition.h"
+
+#include <mpi.h>
+
+
+RCBDomainDecomposition::RCBDomainDecomposition( Params &params )
+    : DomainDecomposition( params )
+{
+    ndomain_ = params.number_of_patches;
+    mi_.assign( params.mi.begin(), params.mi.begin() + params.nDim_field );
+
+    // Sequence of cuts: each one halves the longest side (in cells) of the boxes
+    std::vector<double> length( params.nDim_field );
+    std::vector<unsigned int> remaining( mi_ );
+    for( unsigned int iDim=0 ; iDim<params.nDim_field ; iDim++ ) {
+        length[iDim] = ( double )params.number_of_patches[iDim] * params.patch_size_[iDim];
+    }
+    while( true ) {
+        int longest = -1;
+        for( unsigned int iDim=0 ; iDim<params.nDim_field ; iDim++ ) {
+            if( remaining[iDim] > 0 && ( longest < 0 || length[iDim] > length[longest] ) ) {
+                longest = iDim;
+            }
+        }
+        if( longest < 0 ) {
+            break;
+        }
+        cuts_.push_back( longest );
+        length[longest] *= 0.5;
+        remaining[longest]--;
+    }
+}
+
+
+RCBDomainDecomposition::~RCBDomainDecomposition( )
+{
+}
+
+
+// The bits of the coordinates, from the most significant, in the order of the cuts
+unsigned int RCBDomainDecomposition::getDomainId( std::vector<int> Coordinates )
+{
+    for( unsigned int iDim=0 ; iDim<mi_.size() ; iDim++ ) {
+        if( Coordinates[iDim] < 0 || Coordinates[iDim] >= ( int )ndomain_[iDim] ) {
+            return MPI_PROC_NULL;
+        }
+    }
+
+    std::vector<unsigned int> bit( mi_ );
+    unsigned int id = 0;
+    for( unsigned int icut=0 ; icut<cuts_.size() ; icut++ ) {
+        unsigned int iDim = cuts_[icut];
+        bit[iDim]--;
+        id = ( id << 1 ) | ( ( Coordinates[iDim] >> bit[iDim] ) & 1 );
+    }
+    return id;
+}
+
+
+std::vector<unsigned int> RCBDomainDecomposition::getDomainCoordinates( unsigned int Id )
+{
+    std::vector<unsigned int> coords( mi_.size(), 0 );
+    for( unsigned int icut=0 ; icut<cuts_.size() ; icut++ ) {
+        unsigned int iDim = cuts_[icut];
+        coords[iDim] = ( coords[iDim] << 1 ) | ( ( Id >> ( cuts_.size()-1-icut ) ) & 1 );
+    }
+    return coords;
+}
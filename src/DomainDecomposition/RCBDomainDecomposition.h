@@ -0,0 +1,33 @@
+#ifndef RCBDOMAINDECOMPOSITION_H
+#define RCBDOMAINDECOMPOSITION_H
+
+#include "DomainDecomposition.h"
+
+// -----------------------------------------------------------------------------
+//! Patches ordered by recursive coordinate bisection (Main.patch_arrangement = "rcb").
+//! The box is cut in two halves along its longest side, measured in cells, and
+//! the patches of the first half are numbered before those of the second one;
+//! each half is then cut the same way. Any range of consecutive indexes (as
+//! given to an MPI process) is thus made of a few boxes of balanced aspect
+//! ratio, which limits the volume of the ghost cells exchanged between the
+//! processes, also when the patches are not cubic.
+//!
+//! The number of patches must be a power of 2 in each direction.
+// -----------------------------------------------------------------------------
+class RCBDomainDecomposition final : public DomainDecomposition
+{
+public:
+    RCBDomainDecomposition( Params &params );
+    ~RCBDomainDecomposition( ) override final;
+
+    unsigned int getDomainId( std::vector<int> Coordinates ) override final;
+    std::vector<unsigned int> getDomainCoordinates( unsigned int Id ) override final;
+
+private:
+    //! Direction of each cut, from the first (most significant bit of the index) to the last
+    std::vector<unsigned int> cuts_;
+    //! log2 of the number of patches in each direction
+    std::vector<unsigned int> mi_;
+};
+
+#endif
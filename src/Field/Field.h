@@ -32,6 +32,8 @@ class Field
 {
 public:
     AsyncMPIbuffers MPIbuff;
+    //! Messages of a whole list of fields when Main.field_exchange="aggregated", held by the first field of the list
+    AggregatedFieldMPIbuffers aggregatedMPIbuff;
 
     //! name of the field
     std::string name;
@@ -7,3 +7,77 @@
 #include "Patch.h"
 
 using namespace std;
+
+void InterpolationStencils::resize( unsigned int ndim, unsigned int width, unsigned int npoints )
+{
+    ndim_ = ndim;
+    width_ = width;
+    npoints_ = npoints;
+    for( unsigned int idim=0; idim<3; idim++ ) {
+        for( unsigned int dual=0; dual<2; dual++ ) {
+            first_[idim][dual].resize( idim < ndim ? npoints : 0 );
+            coeff_[idim][dual].resize( idim < ndim ? npoints*width : 0 );
+        }
+    }
+}
+
+void InterpolationStencils::gather( Field *field, double *out ) const
+{
+    const double *f = field->data();
+    const unsigned int w = width_;
+    if( ndim_ == 1 ) {
+        const vector<int> &ix = first_[0][field->isDual( 0 )];
+        const vector<double> &cx = coeff_[0][field->isDual( 0 )];
+        for( unsigned int ipoint=0; ipoint<npoints_; ipoint++ ) {
+            const double *c = &cx[ipoint*w];
+            const double *g = &f[ix[ipoint]];
+            double res = 0.;
+            for( unsigned int i=0; i<w; i++ ) {
+                res += c[i] * g[i];
+            }
+            out[ipoint] = res;
+        }
+    } else if( ndim_ == 2 ) {
+        const unsigned int ny = field->dims_[1];
+        const vector<int> &ix = first_[0][field->isDual( 0 )];
+        const vector<int> &iy = first_[1][field->isDual( 1 )];
+        const vector<double> &cx = coeff_[0][field->isDual( 0 )];
+        const vector<double> &cy = coeff_[1][field->isDual( 1 )];
+        for( unsigned int ipoint=0; ipoint<npoints_; ipoint++ ) {
+            const double *c0 = &cx[ipoint*w];
+            const double *c1 = &cy[ipoint*w];
+            const double *g = &f[ix[ipoint]*ny + iy[ipoint]];
+            double res = 0.;
+            for( unsigned int i=0; i<w; i++ ) {
+                for( unsigned int j=0; j<w; j++ ) {
+                    res += c0[i] * c1[j] * g[i*ny+j];
+                }
+            }
+            out[ipoint] = res;
+        }
+    } else {
+        const unsigned int ny = field->dims_[1];
+        const unsigned int nz = field->dims_[2];
+        const vector<int> &ix = first_[0][field->isDual( 0 )];
+        const vector<int> &iy = first_[1][field->isDual( 1 )];
+        const vector<int> &iz = first_[2][field->isDual( 2 )];
+        const vector<double> &cx = coeff_[0][field->isDual( 0 )];
+        const vector<double> &cy = coeff_[1][field->isDual( 1 )];
+        const vector<double> &cz = coeff_[2][field->isDual( 2 )];
+        for( unsigned int ipoint=0; ipoint<npoints_; ipoint++ ) {
+            const double *c0 = &cx[ipoint*w];
+            const double *c1 = &cy[ipoint*w];
+            const double *c2 = &cz[ipoint*w];
+            const double *g = &f[( ix[ipoint]*ny + iy[ipoint] )*nz + iz[ipoint]];
+            double res = 0.;
+            for( unsigned int i=0; i<w; i++ ) {
+                for( unsigned int j=0; j<w; j++ ) {
+                    for( unsigned int k=0; k<w; k++ ) {
+                        res += c0[i] * c1[j] * c2[k] * g[( i*ny + j )*nz + k];
+                    }
+                }
+            }
+            out[ipoint] = res;
+        }
+    }
+}
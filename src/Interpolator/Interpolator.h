@@ -10,6 +10,49 @@ class ElectroMagn;
 class Particles;
 
 
+//  --------------------------------------------------------------------------------------------------------------------
+//! Interpolation stencils of points which do not move (probes), so that they are calculated only once.
+//! For each dimension and each point: the first node and the shape coefficients, on the primal and dual grids.
+//  --------------------------------------------------------------------------------------------------------------------
+class InterpolationStencils
+{
+public:
+    InterpolationStencils() : ndim_( 0 ), width_( 0 ), npoints_( 0 ) {};
+    
+    //! Allocate for npoints points, with width nodes in each dimension
+    void resize( unsigned int ndim, unsigned int width, unsigned int npoints );
+    
+    //! Forget the stencils (the points have changed)
+    void clear()
+    {
+        resize( 0, 0, 0 );
+    }
+    
+    //! Whether the stencils have been calculated
+    inline bool built() const
+    {
+        return ndim_ > 0;
+    }
+    
+    //! Store the stencil of a point along one dimension, from the central indices and the coefficients
+    inline void set( unsigned int ipoint, unsigned int idim, int idx_p, int idx_d, double *coeffp, double *coeffd )
+    {
+        first_[idim][0][ipoint] = idx_p - ( int )( width_/2 );
+        first_[idim][1][ipoint] = idx_d - ( int )( width_/2 );
+        for( unsigned int i=0; i<width_; i++ ) {
+            coeff_[idim][0][ipoint*width_+i] = coeffp[i];
+            coeff_[idim][1][ipoint*width_+i] = coeffd[i];
+        }
+    }
+    
+    //! Interpolate a field at all points (sparse gather), in the same order of operations as the interpolators
+    void gather( Field *field, double *out ) const;
+    
+    unsigned int ndim_, width_, npoints_;
+    std::vector<int> first_[3][2];
+    std::vector<double> coeff_[3][2];
+};
+
 //  --------------------------------------------------------------------------------------------------------------------
 //! Class Interpolator
 //  --------------------------------------------------------------------------------------------------------------------
@@ -47,6 +90,13 @@ public:
     virtual void externalMagneticField( ElectroMagn *, Particles &, SmileiMPI *, int, int ){
         ERROR( "External magnetic field not implemented with this geometry and this order" );
     };
+    
+    //! Calculate the stencils of all particles, to be reused while they do not move.
+    //! Returns false if this interpolator does not provide them.
+    virtual bool stencils( Particles &, InterpolationStencils & )
+    {
+        return false;
+    };
 
 private:
 
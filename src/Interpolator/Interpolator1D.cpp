@@ -19,7 +19,7 @@ Interpolator1D::Interpolator1D( Patch *patch )
 void Interpolator1D::externalMagneticField( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int ibin, int ithread ){
     // Interpolate the external field at the particle position
     double *const __restrict__ ExtBLoc  = smpi->dynamics_external_Bpart[ithread].data();
-    const double *const __restrict__ position_x = particles.getPtrPosition( 0 );
+    const particle_real *const __restrict__ position_x = particles.getPtrPosition( 0 );
     const int nparts = particles.numberOfParticles();
     for(auto pt = EMfields->partExtFields.begin(); pt < EMfields->partExtFields.end(); pt++){
         int idx = pt->index - 3;
@@ -162,6 +162,23 @@ void Interpolator1D2Order::oneField( Field **field, Particles &particles, int *i
     }
 }
 
+// Stencils of all particles (probes), reused while they do not move
+bool Interpolator1D2Order::stencils( Particles &particles, InterpolationStencils &stencils )
+{
+    unsigned int npart = particles.hostVectorSize();
+    stencils.resize( 1, 3, npart );
+    int idx_p[1], idx_d[1];
+    double delta_p[1];
+    double coeffxp[3];
+    double coeffxd[3];
+    for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+        double xpn = particles.position( 0, ipart )*dx_inv_;
+        coeffs( xpn, idx_p, idx_d, coeffxp, coeffxd, delta_p );
+        stencils.set( ipart, 0, idx_p[0], idx_d[0], coeffxp, coeffxd );
+    }
+    return true;
+}
+
 void Interpolator1D2Order::fieldsWrapper( ElectroMagn *EMfields,
                                           Particles &particles, SmileiMPI *smpi,
                                           int *istart, int *iend, int ithread, unsigned int, int )
@@ -172,7 +189,7 @@ void Interpolator1D2Order::fieldsWrapper( ElectroMagn *EMfields,
     int    *const __restrict__ iold  = smpi->dynamics_iold[ithread].data();
     double *const __restrict__ delta = smpi->dynamics_deltaold[ithread].data();
 
-    const double *const __restrict__ position_x = particles.getPtrPosition( 0 );
+    const particle_real *const __restrict__ position_x = particles.getPtrPosition( 0 );
 
     // Static cast of the electromagnetic fields
     const double *const __restrict__ Ex1D = static_cast<Field1D *>( EMfields->Ex_ )->data();
@@ -579,7 +596,7 @@ void Interpolator1D2Order::envelopeFieldForIonization( ElectroMagn *EMfields, Pa
     // Static cast of the envelope fields
     Field1D *Env_Eabs = static_cast<Field1D *>( EMfields->Env_E_abs_ );
 
-    std::vector<double> *Env_Eabs_part = &( smpi->dynamics_EnvEabs_part[ithread] );
+    dynamics_buffer<double> *Env_Eabs_part = &( smpi->dynamics_EnvEabs_part[ithread] );
 
     //Loop on bin particles
     for( int ipart=*istart ; ipart<*iend; ipart++ ) {
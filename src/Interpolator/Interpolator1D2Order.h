@@ -24,6 +24,9 @@ public:
     void fieldsSelection( ElectroMagn *EMfields, Particles &particles, double *buffer, int offset, std::vector<unsigned int> *selection ) override final;
     void oneField( Field **field, Particles &particles, int *istart, int *iend, double *FieldLoc, double *l1=NULL, double *l2=NULL, double *l3=NULL ) override final;
 
+    //! Stencils of all particles (probes), reused while they do not move
+    bool stencils( Particles &particles, InterpolationStencils &stencils ) override final;
+
     inline double __attribute__((always_inline)) 
     compute( double *coeff, Field1D *f, int idx )
     {
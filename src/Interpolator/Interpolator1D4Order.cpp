@@ -132,6 +132,23 @@ void Interpolator1D4Order::oneField( Field **field, Particles &particles, int *i
     }
 }
 
+// Stencils of all particles (probes), reused while they do not move
+bool Interpolator1D4Order::stencils( Particles &particles, InterpolationStencils &stencils )
+{
+    unsigned int npart = particles.hostVectorSize();
+    stencils.resize( 1, 5, npart );
+    int idx_p[1], idx_d[1];
+    double delta_p[1];
+    double coeffxp[5];
+    double coeffxd[5];
+    for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+        double xpn = particles.position( 0, ipart )*dx_inv_;
+        coeffs( xpn, idx_p, idx_d, coeffxp, coeffxd, delta_p );
+        stencils.set( ipart, 0, idx_p[0], idx_d[0], coeffxp, coeffxd );
+    }
+    return true;
+}
+
 void Interpolator1D4Order::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, unsigned int, int )
 {
     double *Epart = &( smpi->dynamics_Epart[ithread][0] );
@@ -22,6 +22,9 @@ public:
     void fieldsSelection( ElectroMagn *EMfields, Particles &particles, double *buffer, int offset, std::vector<unsigned int> *selection ) override final;
     void oneField( Field **field, Particles &particles, int *istart, int *iend, double *FieldLoc, double *l1=NULL, double *l2=NULL, double *l3=NULL ) override final;
 
+    //! Stencils of all particles (probes), reused while they do not move
+    bool stencils( Particles &particles, InterpolationStencils &stencils ) override final;
+
     inline double __attribute__((always_inline)) compute( double *coeff, Field1D *f, int idx )
     {
         double interp_res =  coeff[0] * ( *f )( idx-2 )   + coeff[1] * ( *f )( idx-1 )   + coeff[2] * ( *f )( idx ) + coeff[3] * ( *f )( idx+1 ) + coeff[4] * ( *f )( idx+2 );
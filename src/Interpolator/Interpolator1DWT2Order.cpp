@@ -110,10 +110,10 @@ void Interpolator1DWT2Order::oneField( Field **field, Particles &particles, int
 
 void Interpolator1DWT2Order::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, unsigned int, int )
 {
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
-    std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<int> *iold = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
 
     //Loop on bin particles
     int npart_tot = particles.numberOfParticles();
@@ -155,13 +155,13 @@ void Interpolator1DWT2Order::fieldsAndEnvelope( ElectroMagn *EMfields, Particles
     Field1D *GradPhiy1D = static_cast<Field1D *>( EMfields->envelope->GradPhiy_ );
     Field1D *GradPhiz1D = static_cast<Field1D *>( EMfields->envelope->GradPhiz_ );
 
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
-    std::vector<double> *PHIpart        = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPHIpart    = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *PHIpart        = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPHIpart    = &( smpi->dynamics_GradPHIpart[ithread] );
 
-    std::vector<int>    *iold  = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<int>    *iold  = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
 
     //Loop on bin particles
     int nparts( particles.numberOfParticles() );
@@ -209,11 +209,11 @@ void Interpolator1DWT2Order::timeCenteredEnvelope( ElectroMagn *EMfields, Partic
     Field1D *GradPhiy_m1D = static_cast<Field1D *>( EMfields->envelope->GradPhiy_m );
     Field1D *GradPhiz_m1D = static_cast<Field1D *>( EMfields->envelope->GradPhiz_m );
 
-    std::vector<double> *PHI_mpart     = &( smpi->dynamics_PHI_mpart[ithread] );
-    std::vector<double> *GradPHI_mpart = &( smpi->dynamics_GradPHI_mpart[ithread] );
+    dynamics_buffer<double> *PHI_mpart     = &( smpi->dynamics_PHI_mpart[ithread] );
+    dynamics_buffer<double> *GradPHI_mpart = &( smpi->dynamics_GradPHI_mpart[ithread] );
 
-    std::vector<int>    *iold  = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<int>    *iold  = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
 
     //Loop on bin particles
     int nparts( particles.numberOfParticles() );
@@ -328,7 +328,7 @@ void Interpolator1DWT2Order::envelopeFieldForIonization( ElectroMagn *EMfields,
     // Static cast of the envelope fields
     Field1D *Env_Eabs = static_cast<Field1D *>( EMfields->Env_E_abs_ );
 
-    std::vector<double> *Env_Eabs_part = &( smpi->dynamics_EnvEabs_part[ithread] );
+    dynamics_buffer<double> *Env_Eabs_part = &( smpi->dynamics_EnvEabs_part[ithread] );
 
     //Loop on bin particles
     for( int ipart=*istart ; ipart<*iend; ipart++ ) {
@@ -119,10 +119,10 @@ void Interpolator1DWT4Order::oneField( Field **field, Particles &particles, int
 
 void Interpolator1DWT4Order::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, unsigned int, int )
 {
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
-    std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<int> *iold = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
     
     //Loop on bin particles
     int npart_tot = particles.numberOfParticles();
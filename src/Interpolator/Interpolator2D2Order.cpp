@@ -152,6 +152,25 @@ void Interpolator2D2Order::oneField( Field **field, Particles &particles, int *i
     }
 }
 
+// Stencils of all particles (probes), reused while they do not move
+bool Interpolator2D2Order::stencils( Particles &particles, InterpolationStencils &stencils )
+{
+    unsigned int npart = particles.hostVectorSize();
+    stencils.resize( 2, 3, npart );
+    int idx_p[2], idx_d[2];
+    double delta_p[2];
+    double coeffxp[3], coeffyp[3];
+    double coeffxd[3], coeffyd[3];
+    for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+        double xpn = particles.position( 0, ipart )*d_inv_[0];
+        double ypn = particles.position( 1, ipart )*d_inv_[1];
+        coeffs( xpn, ypn, idx_p, idx_d, coeffxp, coeffyp, coeffxd, coeffyd, delta_p );
+        stencils.set( ipart, 0, idx_p[0], idx_d[0], coeffxp, coeffxd );
+        stencils.set( ipart, 1, idx_p[1], idx_d[1], coeffyp, coeffyd );
+    }
+    return true;
+}
+
 // -----------------------------------------------------------------------------
 //! Wrapper called by the particle dynamics section
 // -----------------------------------------------------------------------------
@@ -170,8 +189,8 @@ void Interpolator2D2Order::fieldsWrapper(   ElectroMagn *EMfields,
     int    *const __restrict__ iold  = smpi->dynamics_iold[ithread].data();
     double *const __restrict__ delta = smpi->dynamics_deltaold[ithread].data();
 
-    const double *const __restrict__ position_x = particles.getPtrPosition( 0 );
-    const double *const __restrict__ position_y = particles.getPtrPosition( 1 );
+    const particle_real *const __restrict__ position_x = particles.getPtrPosition( 0 );
+    const particle_real *const __restrict__ position_y = particles.getPtrPosition( 1 );
 
     const double *const __restrict__ Ex2D = static_cast<Field2D *>( EMfields->Ex_ )->data();
     const double *const __restrict__ Ey2D = static_cast<Field2D *>( EMfields->Ey_ )->data();
@@ -387,13 +406,13 @@ void Interpolator2D2Order::fieldsAndEnvelope( ElectroMagn *EMfields, Particles &
     Field2D *GradPhiy2D = static_cast<Field2D *>( EMfields->envelope->GradPhiy_ );
     Field2D *GradPhiz2D = static_cast<Field2D *>( EMfields->envelope->GradPhiz_ );
 
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
-    std::vector<double> *PHIpart        = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPHIpart    = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *PHIpart        = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPHIpart    = &( smpi->dynamics_GradPHIpart[ithread] );
 
-    std::vector<int>    *iold  = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<int>    *iold  = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
 
     //Loop on bin particles
     int nparts( particles.numberOfParticles() );
@@ -466,8 +485,8 @@ void Interpolator2D2Order::fieldsAndEnvelope( ElectroMagn *EMfields, Particles &
       
         Field2D *By2DBTIS3 = static_cast<Field2D *>( EMfields->By_mBTIS3 );
         Field2D *Bz2DBTIS3 = static_cast<Field2D *>( EMfields->Bz_mBTIS3 );
-        std::vector<double> *BpartyBTIS3 = &( smpi->dynamics_Bpart_yBTIS3[ithread] );
-        std::vector<double> *BpartzBTIS3 = &( smpi->dynamics_Bpart_zBTIS3[ithread] );
+        dynamics_buffer<double> *BpartyBTIS3 = &( smpi->dynamics_Bpart_yBTIS3[ithread] );
+        dynamics_buffer<double> *BpartzBTIS3 = &( smpi->dynamics_Bpart_zBTIS3[ithread] );
         
         for( int ipart=*istart ; ipart<*iend; ipart++ ) {
 
@@ -555,10 +574,10 @@ void Interpolator2D2Order::timeCenteredEnvelope( ElectroMagn *EMfields, Particle
     Field2D *GradPhiy_m2D = static_cast<Field2D *>( EMfields->envelope->GradPhiy_m );
     Field2D *GradPhiz_m2D = static_cast<Field2D *>( EMfields->envelope->GradPhiz_m );
 
-    std::vector<double> *PHI_mpart     = &( smpi->dynamics_PHI_mpart[ithread] );
-    std::vector<double> *GradPHI_mpart = &( smpi->dynamics_GradPHI_mpart[ithread] );
-    std::vector<int>    *iold  = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *PHI_mpart     = &( smpi->dynamics_PHI_mpart[ithread] );
+    dynamics_buffer<double> *GradPHI_mpart = &( smpi->dynamics_GradPHI_mpart[ithread] );
+    dynamics_buffer<int>    *iold  = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
 
     //Loop on bin particles
     int nparts( particles.numberOfParticles() );
@@ -652,8 +671,8 @@ void Interpolator2D2Order::envelopeFieldForIonization( ElectroMagn *EMfields, Pa
     Field2D *EnvEabs = static_cast<Field2D *>( EMfields->Env_E_abs_ );
     Field2D *EnvExabs = static_cast<Field2D *>( EMfields->Env_Ex_abs_ );
 
-    std::vector<double> *EnvEabs_part  = &( smpi->dynamics_EnvEabs_part[ithread] );
-    std::vector<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
+    dynamics_buffer<double> *EnvEabs_part  = &( smpi->dynamics_EnvEabs_part[ithread] );
+    dynamics_buffer<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
 
     //Loop on bin particles
     for( int ipart=*istart ; ipart<*iend; ipart++ ) {
@@ -32,6 +32,9 @@ public:
     //! Interpolator on another field than the basic ones
     void oneField( Field **field, Particles &particles, int *istart, int *iend, double *FieldLoc, double *l1=NULL, double *l2=NULL, double *l3=NULL ) override;
 
+    //! Stencils of all particles (probes), reused while they do not move
+    bool stencils( Particles &particles, InterpolationStencils &stencils ) override;
+
     //! Computation of a field from provided coefficients
     inline double __attribute__((always_inline))
     compute( double *coeffx, double *coeffy, Field2D *f, int idx, int idy )
@@ -149,6 +149,25 @@ void Interpolator2D4Order::oneField( Field **field, Particles &particles, int *i
     }
 }
 
+// Stencils of all particles (probes), reused while they do not move
+bool Interpolator2D4Order::stencils( Particles &particles, InterpolationStencils &stencils )
+{
+    unsigned int npart = particles.hostVectorSize();
+    stencils.resize( 2, 5, npart );
+    int idx_p[2], idx_d[2];
+    double delta_p[2];
+    double coeffxp[5], coeffyp[5];
+    double coeffxd[5], coeffyd[5];
+    for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+        double xpn = particles.position( 0, ipart )*d_inv_[0];
+        double ypn = particles.position( 1, ipart )*d_inv_[1];
+        coeffs( xpn, ypn, idx_p, idx_d, coeffxp, coeffyp, coeffxd, coeffyd, delta_p );
+        stencils.set( ipart, 0, idx_p[0], idx_d[0], coeffxp, coeffxd );
+        stencils.set( ipart, 1, idx_p[1], idx_d[1], coeffyp, coeffyd );
+    }
+    return true;
+}
+
 void Interpolator2D4Order::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, unsigned int, int )
 {
     double *Epart = &( smpi->dynamics_Epart[ithread][0] );
@@ -148,10 +148,10 @@ void Interpolator2DWT2Order::fieldsWrapper( ElectroMagn *EMfields,
                                             unsigned int,
                                             int )
 {
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
-    std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<int> *iold = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
 
     //Loop on bin particles
     int nparts( particles.numberOfParticles() );
@@ -206,13 +206,13 @@ void Interpolator2DWT2Order::fieldsAndEnvelope( ElectroMagn *EMfields, Particles
     Field2D *GradPhiy2D = static_cast<Field2D *>( EMfields->envelope->GradPhiy_ );
     Field2D *GradPhiz2D = static_cast<Field2D *>( EMfields->envelope->GradPhiz_ );
 
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
-    std::vector<double> *PHIpart        = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPHIpart    = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *PHIpart        = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPHIpart    = &( smpi->dynamics_GradPHIpart[ithread] );
 
-    std::vector<int>    *iold  = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<int>    *iold  = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
 
     //Loop on bin particles
     int nparts( particles.numberOfParticles() );
@@ -263,11 +263,11 @@ void Interpolator2DWT2Order::timeCenteredEnvelope( ElectroMagn *EMfields, Partic
     Field2D *GradPhiy_m2D = static_cast<Field2D *>( EMfields->envelope->GradPhiy_m );
     Field2D *GradPhiz_m2D = static_cast<Field2D *>( EMfields->envelope->GradPhiz_m );
 
-    std::vector<double> *PHI_mpart     = &( smpi->dynamics_PHI_mpart[ithread] );
-    std::vector<double> *GradPHI_mpart = &( smpi->dynamics_GradPHI_mpart[ithread] );
+    dynamics_buffer<double> *PHI_mpart     = &( smpi->dynamics_PHI_mpart[ithread] );
+    dynamics_buffer<double> *GradPHI_mpart = &( smpi->dynamics_GradPHI_mpart[ithread] );
 
-    std::vector<int>    *iold  = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<int>    *iold  = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
 
     //Loop on bin particles
     int nparts( particles.numberOfParticles() );
@@ -413,8 +413,8 @@ void Interpolator2DWT2Order::envelopeFieldForIonization( ElectroMagn *EMfields,
     Field2D *EnvEabs  = static_cast<Field2D *>( EMfields->Env_E_abs_ );
     Field2D *EnvExabs = static_cast<Field2D *>( EMfields->Env_Ex_abs_ );
 
-    std::vector<double> *EnvEabs_part  = &( smpi->dynamics_EnvEabs_part[ithread] );
-    std::vector<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
+    dynamics_buffer<double> *EnvEabs_part  = &( smpi->dynamics_EnvEabs_part[ithread] );
+    dynamics_buffer<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
 
     //Loop on bin particles
     for( int ipart=*istart ; ipart<*iend; ipart++ ) {
@@ -68,8 +68,8 @@ void Interpolator2DWT2OrderV::fieldsWrapper( ElectroMagn *EMfields,
     Field2D *By2D = static_cast<Field2D *>( EMfields->By_m );
     Field2D *Bz2D = static_cast<Field2D *>( EMfields->Bz_m );
 
-    double * __restrict__ position_x = particles.getPtrPosition(0);
-    double * __restrict__ position_y = particles.getPtrPosition(1);
+    particle_real * __restrict__ position_x = particles.getPtrPosition(0);
+    particle_real * __restrict__ position_y = particles.getPtrPosition(1);
 
     double coeff[2][2][3][32];
 
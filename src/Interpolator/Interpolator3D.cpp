@@ -21,9 +21,9 @@ Interpolator3D::Interpolator3D( Patch *patch )
 void Interpolator3D::externalMagneticField( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int ibin, int ithread ){
     // Interpolate the external field at the particle position
     double *const __restrict__ ExtBLoc  = smpi->dynamics_external_Bpart[ithread].data();
-    const double *const __restrict__ position_x = particles.getPtrPosition( 0 );
-    const double *const __restrict__ position_y = particles.getPtrPosition( 1 );
-    const double *const __restrict__ position_z = particles.getPtrPosition( 2 );
+    const particle_real *const __restrict__ position_x = particles.getPtrPosition( 0 );
+    const particle_real *const __restrict__ position_y = particles.getPtrPosition( 1 );
+    const particle_real *const __restrict__ position_z = particles.getPtrPosition( 2 );
     const int nparts = particles.numberOfParticles();
     for(auto pt = EMfields->partExtFields.begin(); pt < EMfields->partExtFields.end(); pt++){
         int idx = pt->index - 3;
@@ -160,6 +160,27 @@ void Interpolator3D2Order::oneField( Field **field, Particles &particles, int *i
     }
 }
 
+// Stencils of all particles (probes), reused while they do not move
+bool Interpolator3D2Order::stencils( Particles &particles, InterpolationStencils &stencils )
+{
+    unsigned int npart = particles.hostVectorSize();
+    stencils.resize( 3, 3, npart );
+    int idx_p[3], idx_d[3];
+    double delta_p[3];
+    double coeffxp[3], coeffyp[3], coeffzp[3];
+    double coeffxd[3], coeffyd[3], coeffzd[3];
+    for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+        double xpn = particles.position( 0, ipart )*d_inv_[0];
+        double ypn = particles.position( 1, ipart )*d_inv_[1];
+        double zpn = particles.position( 2, ipart )*d_inv_[2];
+        coeffs( xpn, ypn, zpn, idx_p, idx_d, coeffxp, coeffyp, coeffzp, coeffxd, coeffyd, coeffzd, delta_p );
+        stencils.set( ipart, 0, idx_p[0], idx_d[0], coeffxp, coeffxd );
+        stencils.set( ipart, 1, idx_p[1], idx_d[1], coeffyp, coeffyd );
+        stencils.set( ipart, 2, idx_p[2], idx_d[2], coeffzp, coeffzd );
+    }
+    return true;
+}
+
 void Interpolator3D2Order::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, unsigned int, int )
 {
     const int nparts = particles.numberOfParticles();
@@ -185,9 +206,9 @@ void Interpolator3D2Order::fieldsWrapper( ElectroMagn *EMfields, Particles &part
     int *const __restrict__ iold     = smpi->dynamics_iold[ithread].data();
     double *const __restrict__ delta = smpi->dynamics_deltaold[ithread].data();
 
-    const double *const __restrict__ position_x = particles.getPtrPosition( 0 );
-    const double *const __restrict__ position_y = particles.getPtrPosition( 1 );
-    const double *const __restrict__ position_z = particles.getPtrPosition( 2 );
+    const particle_real *const __restrict__ position_x = particles.getPtrPosition( 0 );
+    const particle_real *const __restrict__ position_y = particles.getPtrPosition( 1 );
+    const particle_real *const __restrict__ position_z = particles.getPtrPosition( 2 );
 
     const double *const __restrict__ Ex3D = EMfields->Ex_->data_;
     const double *const __restrict__ Ey3D = EMfields->Ey_->data_;
@@ -411,13 +432,13 @@ void Interpolator3D2Order::fieldsAndEnvelope( ElectroMagn *EMfields, Particles &
     double* GradPhiy3D = EMfields->envelope->GradPhiy_->data_;
     double* GradPhiz3D = EMfields->envelope->GradPhiz_->data_;
 
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
-    std::vector<double> *PHIpart        = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPHIpart    = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *PHIpart        = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPHIpart    = &( smpi->dynamics_GradPHIpart[ithread] );
 
-    std::vector<int>    *iold  = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<int>    *iold  = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
 
     int nx_p = EMfields->Bx_m->dims_[0];
     int ny_p = EMfields->By_m->dims_[1];
@@ -494,8 +515,8 @@ void Interpolator3D2Order::fieldsAndEnvelope( ElectroMagn *EMfields, Particles &
       
     } else { // with B-TIS3 interpolation
       
-        std::vector<double> *BypartBTIS3;
-        std::vector<double> *BzpartBTIS3;
+        dynamics_buffer<double> *BypartBTIS3;
+        dynamics_buffer<double> *BzpartBTIS3;
 
         BypartBTIS3 = &( smpi->dynamics_Bpart_yBTIS3[ithread] );
         BzpartBTIS3 = &( smpi->dynamics_Bpart_zBTIS3[ithread] );
@@ -584,11 +605,11 @@ void Interpolator3D2Order::timeCenteredEnvelope( ElectroMagn *EMfields, Particle
     double* GradPhiy_m3D = EMfields->envelope->GradPhiy_m->data_;
     double* GradPhiz_m3D = EMfields->envelope->GradPhiz_m->data_;
 
-    std::vector<double> *PHI_mpart     = &( smpi->dynamics_PHI_mpart[ithread] );
-    std::vector<double> *GradPHI_mpart = &( smpi->dynamics_GradPHI_mpart[ithread] );
+    dynamics_buffer<double> *PHI_mpart     = &( smpi->dynamics_PHI_mpart[ithread] );
+    dynamics_buffer<double> *GradPHI_mpart = &( smpi->dynamics_GradPHI_mpart[ithread] );
 
-    std::vector<int>    *iold  = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<int>    *iold  = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
 
     int nx_p = EMfields->Bx_m->dims_[0];
     int ny_p = EMfields->By_m->dims_[1];
@@ -687,8 +708,8 @@ void Interpolator3D2Order::envelopeFieldForIonization( ElectroMagn *EMfields, Pa
     double* EnvEabs  = EMfields->Env_E_abs_->data_;
     double* EnvExabs = EMfields->Env_Ex_abs_->data_;
 
-    std::vector<double> *EnvEabs_part  = &( smpi->dynamics_EnvEabs_part[ithread] );
-    std::vector<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
+    dynamics_buffer<double> *EnvEabs_part  = &( smpi->dynamics_EnvEabs_part[ithread] );
+    dynamics_buffer<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
 
     int nx_p = EMfields->Bx_m->dims_[0];
     int ny_p = EMfields->By_m->dims_[1];
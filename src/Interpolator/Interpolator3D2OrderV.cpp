@@ -62,9 +62,9 @@ void Interpolator3D2OrderV::fieldsWrapper( ElectroMagn * __restrict__ EMfields,
     double * __restrict__ Epart[3];
     double * __restrict__ Bpart[3];
 
-    const double *const __restrict__ position_x = particles.getPtrPosition( 0 );
-    const double *const __restrict__ position_y = particles.getPtrPosition( 1 );
-    const double *const __restrict__ position_z = particles.getPtrPosition( 2 );
+    const particle_real *const __restrict__ position_x = particles.getPtrPosition( 0 );
+    const particle_real *const __restrict__ position_y = particles.getPtrPosition( 1 );
+    const particle_real *const __restrict__ position_z = particles.getPtrPosition( 2 );
 
     // double * __restrict__ Ex = &Ex3D->data_[0];
     // double * __restrict__ Ey = &Ey3D->data_[0];
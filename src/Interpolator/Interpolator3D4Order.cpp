@@ -156,6 +156,27 @@ void Interpolator3D4Order::oneField( Field **field, Particles &particles, int *i
     }
 }
 
+// Stencils of all particles (probes), reused while they do not move
+bool Interpolator3D4Order::stencils( Particles &particles, InterpolationStencils &stencils )
+{
+    unsigned int npart = particles.hostVectorSize();
+    stencils.resize( 3, 5, npart );
+    int idx_p[3], idx_d[3];
+    double delta_p[3];
+    double coeffxp[5], coeffyp[5], coeffzp[5];
+    double coeffxd[5], coeffyd[5], coeffzd[5];
+    for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+        double xpn = particles.position( 0, ipart )*d_inv_[0];
+        double ypn = particles.position( 1, ipart )*d_inv_[1];
+        double zpn = particles.position( 2, ipart )*d_inv_[2];
+        coeffs( xpn, ypn, zpn, idx_p, idx_d, coeffxp, coeffyp, coeffzp, coeffxd, coeffyd, coeffzd, delta_p );
+        stencils.set( ipart, 0, idx_p[0], idx_d[0], coeffxp, coeffxd );
+        stencils.set( ipart, 1, idx_p[1], idx_d[1], coeffyp, coeffyd );
+        stencils.set( ipart, 2, idx_p[2], idx_d[2], coeffzp, coeffzd );
+    }
+    return true;
+}
+
 void Interpolator3D4Order::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, unsigned int, int )
 {
     double *const __restrict__ ELoc = &( smpi->dynamics_Epart[ithread][0] );
@@ -164,9 +185,9 @@ void Interpolator3D4Order::fieldsWrapper( ElectroMagn *EMfields, Particles &part
     int    *const __restrict__ iold     = &( smpi->dynamics_iold[ithread][0] );
     double *const __restrict__ delta = &( smpi->dynamics_deltaold[ithread][0] );
 
-    const double *const __restrict__ position_x = particles.getPtrPosition( 0 );
-    const double *const __restrict__ position_y = particles.getPtrPosition( 1 );
-    const double *const __restrict__ position_z = particles.getPtrPosition( 2 );
+    const particle_real *const __restrict__ position_x = particles.getPtrPosition( 0 );
+    const particle_real *const __restrict__ position_y = particles.getPtrPosition( 1 );
+    const particle_real *const __restrict__ position_z = particles.getPtrPosition( 2 );
 
     // Static cast of the electromagnetic fields
     Field3D *Ex3D = static_cast<Field3D *>( EMfields->Ex_ );
@@ -144,9 +144,9 @@ void Interpolator3DWT2Order::fieldsWrapper( ElectroMagn *EMfields, Particles &pa
     int*     iold = &( smpi->dynamics_iold    [ithread][0] );
     double* delta = &( smpi->dynamics_deltaold[ithread][0] );
 
-    double* position_x = particles.getPtrPosition(0);
-    double* position_y = particles.getPtrPosition(1);
-    double* position_z = particles.getPtrPosition(2);
+    particle_real* position_x = particles.getPtrPosition(0);
+    particle_real* position_y = particles.getPtrPosition(1);
+    particle_real* position_z = particles.getPtrPosition(2);
 
     // Static cast of the electromagnetic fields
     double* Ex3D = EMfields->Ex_->data_;
@@ -236,13 +236,13 @@ void Interpolator3DWT2Order::fieldsAndEnvelope( ElectroMagn *EMfields, Particles
     Field3D *GradPhiy3D = static_cast<Field3D *>( EMfields->envelope->GradPhiy_ );
     Field3D *GradPhiz3D = static_cast<Field3D *>( EMfields->envelope->GradPhiz_ );
 
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
-    std::vector<double> *PHIpart        = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPHIpart    = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *PHIpart        = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPHIpart    = &( smpi->dynamics_GradPHIpart[ithread] );
 
-    std::vector<int>    *iold  = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<int>    *iold  = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
 
     //Loop on bin particles
     int nparts( particles.numberOfParticles() );
@@ -294,11 +294,11 @@ void Interpolator3DWT2Order::timeCenteredEnvelope( ElectroMagn *EMfields, Partic
     Field3D *GradPhiy_m3D = static_cast<Field3D *>( EMfields->envelope->GradPhiy_m );
     Field3D *GradPhiz_m3D = static_cast<Field3D *>( EMfields->envelope->GradPhiz_m );
 
-    std::vector<double> *PHI_mpart     = &( smpi->dynamics_PHI_mpart[ithread] );
-    std::vector<double> *GradPHI_mpart = &( smpi->dynamics_GradPHI_mpart[ithread] );
+    dynamics_buffer<double> *PHI_mpart     = &( smpi->dynamics_PHI_mpart[ithread] );
+    dynamics_buffer<double> *GradPHI_mpart = &( smpi->dynamics_GradPHI_mpart[ithread] );
 
-    std::vector<int>    *iold  = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<int>    *iold  = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
 
     //Loop on bin particles
     int nparts( particles.numberOfParticles() );
@@ -425,8 +425,8 @@ void Interpolator3DWT2Order::envelopeFieldForIonization( ElectroMagn *EMfields,
     Field3D *EnvExabs = static_cast<Field3D *>( EMfields->Env_Ex_abs_ );
 
 
-    std::vector<double> *EnvEabs_part  = &( smpi->dynamics_EnvEabs_part[ithread] );
-    std::vector<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
+    dynamics_buffer<double> *EnvEabs_part  = &( smpi->dynamics_EnvEabs_part[ithread] );
+    dynamics_buffer<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
 
 
     //Loop on bin particles
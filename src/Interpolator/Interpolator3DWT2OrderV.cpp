@@ -68,9 +68,9 @@ void Interpolator3DWT2OrderV::fieldsWrapper( ElectroMagn * __restrict__ EMfields
     double * __restrict__ Epart[3];
     double * __restrict__ Bpart[3];
 
-    double * __restrict__ position_x = particles.getPtrPosition(0);
-    double * __restrict__ position_y = particles.getPtrPosition(1);
-    double * __restrict__ position_z = particles.getPtrPosition(2);
+    particle_real * __restrict__ position_x = particles.getPtrPosition(0);
+    particle_real * __restrict__ position_y = particles.getPtrPosition(1);
+    particle_real * __restrict__ position_z = particles.getPtrPosition(2);
 
     // double * __restrict__ Ex = &Ex3D->data_[0];
     // double * __restrict__ Ey = &Ey3D->data_[0];
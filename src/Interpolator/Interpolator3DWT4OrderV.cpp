@@ -80,9 +80,9 @@ void Interpolator3DWT4OrderV::fieldsWrapper( ElectroMagn *EMfields, Particles &p
     Field3D *By3D = static_cast<Field3D *>( EMfields->By_m );
     Field3D *Bz3D = static_cast<Field3D *>( EMfields->Bz_m );
 
-    double * __restrict__ position_x = particles.getPtrPosition(0);
-    double * __restrict__ position_y = particles.getPtrPosition(1);
-    double * __restrict__ position_z = particles.getPtrPosition(2);
+    particle_real * __restrict__ position_x = particles.getPtrPosition(0);
+    particle_real * __restrict__ position_y = particles.getPtrPosition(1);
+    particle_real * __restrict__ position_z = particles.getPtrPosition(2);
 
     double coeff[3][2][5][32];
     int dual[3][32]; // Size ndim. Boolean indicating if the part has a dual indice equal to the primal one (dual=0) or if it is +1 (dual=1).
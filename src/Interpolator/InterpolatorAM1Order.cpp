@@ -46,7 +46,7 @@ void InterpolatorAM1Order::fields( ElectroMagn *EMfields, Particles &particles,
     double xpn = particles.position( 0, ipart ) * D_inv_[0] ;
     double r = sqrt( particles.position( 1, ipart )*particles.position( 1, ipart )+particles.position( 2, ipart )*particles.position( 2, ipart ) ) ;
     double rpn = r * D_inv_[1] - 0.5 ; //-0.5 because of cells being shifted by dr_/2
-    exp_m_theta_ = ( particles.position( 1, ipart ) - Icpx * particles.position( 2, ipart ) ) / r ; //exp(-i theta)
+    exp_m_theta_ = ( ( double )particles.position( 1, ipart ) - Icpx * ( double )particles.position( 2, ipart ) ) / r ; //exp(-i theta)
     complex<double> exp_mm_theta = 1. ;                                                          //exp(-i m theta)
     // Calculate coeffs
     coeffs( xpn, rpn );
@@ -147,7 +147,7 @@ void InterpolatorAM1Order::fieldsAndCurrents( ElectroMagn *EMfields, Particles &
     ( *RhoLoc ) = std::real( compute( &coeffxp_[0], &coeffyp_[0], Rho, ip_, jp_ ) );
    
     if (r > 0){ 
-        exp_m_theta_ = ( particles.position( 1, ipart ) - Icpx * particles.position( 2, ipart ) ) / r ;
+        exp_m_theta_ = ( ( double )particles.position( 1, ipart ) - Icpx * ( double )particles.position( 2, ipart ) ) / r ;
     } else {
         exp_m_theta_ = 1. ;
     }
@@ -200,7 +200,7 @@ void InterpolatorAM1Order::oneField( Field **field, Particles &particles, int *i
         double rpn = r * D_inv_[1] - 0.5;
         coeffs( xpn, rpn);
         if (r > 0){ 
-            exp_m_theta_ = ( particles.position( 1, ipart ) - Icpx * particles.position( 2, ipart ) ) / r ;
+            exp_m_theta_ = ( ( double )particles.position( 1, ipart ) - Icpx * ( double )particles.position( 2, ipart ) ) / r ;
         } else {
             exp_m_theta_ = 1. ;
         }
@@ -234,11 +234,11 @@ void InterpolatorAM1Order::oneField( Field **field, Particles &particles, int *i
 
 void InterpolatorAM1Order::fieldsWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, unsigned int, int )
 {
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
-    std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<std::complex<double>> *eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<int> *iold = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<std::complex<double>> *eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
     
     //Loop on bin particles
     int nparts( particles.numberOfParticles() );
@@ -47,7 +47,7 @@ void InterpolatorAM1OrderRuyten::fields( ElectroMagn *EMfields, Particles &parti
     double xpn = particles.position( 0, ipart ) * D_inv_[0];
     double r = sqrt( particles.position( 1, ipart )*particles.position( 1, ipart )+particles.position( 2, ipart )*particles.position( 2, ipart ) ) ;
     double rpn = r * D_inv_[1];
-    exp_m_theta_ = ( particles.position( 1, ipart ) - Icpx * particles.position( 2, ipart ) ) / r ; //exp(-i theta)
+    exp_m_theta_ = ( ( double )particles.position( 1, ipart ) - Icpx * ( double )particles.position( 2, ipart ) ) / r ; //exp(-i theta)
     complex<double> exp_mm_theta = 1. ;                                                          //exp(-i m theta)
     // Compute coeffs
     int idx_p[2], idx_d[2];
@@ -174,7 +174,7 @@ void InterpolatorAM1OrderRuyten::fieldsAndCurrents( ElectroMagn *EMfields, Parti
     }
 
     if (r > 0){
-        exp_m_theta_ = ( particles.position( 1, ipart ) - Icpx * particles.position( 2, ipart ) ) / r ;
+        exp_m_theta_ = ( ( double )particles.position( 1, ipart ) - Icpx * ( double )particles.position( 2, ipart ) ) / r ;
     } else {
         exp_m_theta_ = 1. ;
     }
@@ -251,7 +251,7 @@ void InterpolatorAM1OrderRuyten::oneField( Field **field, Particles &particles,
 
         complex<double> exp_m_theta_ = 1., exp_mm_theta = 1. ;
         if (r > 0) {
-            exp_m_theta_ = ( particles.position( 1, ipart ) - Icpx * particles.position( 2, ipart ) ) / r ;
+            exp_m_theta_ = ( ( double )particles.position( 1, ipart ) - Icpx * ( double )particles.position( 2, ipart ) ) / r ;
         }
 
         double Jx_ = 0., Jy_ = 0., Jz_ = 0., Rho_ = 0.;
@@ -304,7 +304,7 @@ void InterpolatorAM1OrderRuyten::fieldsWrapper( ElectroMagn *EMfields,
             double xpn = particles.position( 0, ipart ) * D_inv_[0];
             double r = sqrt( particles.position( 1, ipart )*particles.position( 1, ipart )+particles.position( 2, ipart )*particles.position( 2, ipart ) ) ;
             double rpn = r * D_inv_[1];
-            exp_m_theta_local = ( particles.position( 1, ipart ) - Icpx * particles.position( 2, ipart ) ) / r ; //exp(-i theta)
+            exp_m_theta_local = ( ( double )particles.position( 1, ipart ) - Icpx * ( double )particles.position( 2, ipart ) ) / r ; //exp(-i theta)
                                                                    //exp(-i m theta)
 
             int idx_p[2], idx_d[2];
@@ -384,7 +384,7 @@ void InterpolatorAM1OrderRuyten::fieldsWrapper( ElectroMagn *EMfields,
             double xpn = particles.position( 0, ipart ) * D_inv_[0];
             double r = sqrt( particles.position( 1, ipart )*particles.position( 1, ipart )+particles.position( 2, ipart )*particles.position( 2, ipart ) ) ;
             double rpn = r * D_inv_[1];
-            exp_m_theta_local = ( particles.position( 1, ipart ) - Icpx * particles.position( 2, ipart ) ) / r ; //exp(-i theta)
+            exp_m_theta_local = ( ( double )particles.position( 1, ipart ) - Icpx * ( double )particles.position( 2, ipart ) ) / r ; //exp(-i theta)
                                                                    //exp(-i m theta)
 
             int idx_p[2], idx_d[2];
@@ -493,15 +493,15 @@ void InterpolatorAM1OrderRuyten::fieldsSelection( ElectroMagn *EMfields, Particl
 
 void InterpolatorAM1OrderRuyten::fieldsAndEnvelope( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int *istart, int *iend, int ithread, int )
 {
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
 
-    std::vector<double> *PHIpart        = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPHIpart    = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *PHIpart        = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPHIpart    = &( smpi->dynamics_GradPHIpart[ithread] );
 
-    std::vector<int>    *iold  = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<std::complex<double>> *eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
+    dynamics_buffer<int>    *iold  = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<std::complex<double>> *eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
 
     // Static cast of the envelope fields
     Field2D *Phi = static_cast<Field2D *>( EMfields->envelope->Phi_ );
@@ -563,7 +563,7 @@ void InterpolatorAM1OrderRuyten::fieldsAndEnvelope( ElectroMagn *EMfields, Parti
             ( *GradPHIpart ) [ 2*nparts+ipart ] = 0.;
 
             if (r > 0){
-                exp_m_theta_local = ( particles.position( 1, ipart ) - Icpx * particles.position( 2, ipart ) ) / r ;
+                exp_m_theta_local = ( ( double )particles.position( 1, ipart ) - Icpx * ( double )particles.position( 2, ipart ) ) / r ;
             } else {
                 exp_m_theta_local = 1. ;
             }
@@ -608,8 +608,8 @@ void InterpolatorAM1OrderRuyten::fieldsAndEnvelope( ElectroMagn *EMfields, Parti
       
     } else { // with B-TIS3 interpolation
 
-        std::vector<double> *BLocyBTIS3 = &( smpi->dynamics_Bpart_yBTIS3[ithread] );
-        std::vector<double> *BLoczBTIS3 = &( smpi->dynamics_Bpart_zBTIS3[ithread] );
+        dynamics_buffer<double> *BLocyBTIS3 = &( smpi->dynamics_Bpart_yBTIS3[ithread] );
+        dynamics_buffer<double> *BLoczBTIS3 = &( smpi->dynamics_Bpart_zBTIS3[ithread] );
       
         for( int ipart=*istart ; ipart<*iend; ipart++ ) {
 
@@ -667,7 +667,7 @@ void InterpolatorAM1OrderRuyten::fieldsAndEnvelope( ElectroMagn *EMfields, Parti
             ( *BLoczBTIS3)[ 0*nparts+ipart ]    = std::real( compute( &coeffxp[1], &coeffyd[0], Bt_BTIS3, idx_p[0], idx_d[1] ) );
 
             if (r > 0){
-                exp_m_theta_local = ( particles.position( 1, ipart ) - Icpx * particles.position( 2, ipart ) ) / r ;
+                exp_m_theta_local = ( ( double )particles.position( 1, ipart ) - Icpx * ( double )particles.position( 2, ipart ) ) / r ;
             } else {
                 exp_m_theta_local = 1. ;
             }
@@ -732,12 +732,12 @@ void InterpolatorAM1OrderRuyten::timeCenteredEnvelope( ElectroMagn *EMfields, Pa
     Field2D *GradPhil_m2Dcyl = static_cast<Field2D *>( EMfields->envelope->GradPhil_m );
     Field2D *GradPhir_m2Dcyl = static_cast<Field2D *>( EMfields->envelope->GradPhir_m );
 
-    std::vector<double> *PHI_mpart     = &( smpi->dynamics_PHI_mpart[ithread] );
-    std::vector<double> *GradPHI_mpart = &( smpi->dynamics_GradPHI_mpart[ithread] );
+    dynamics_buffer<double> *PHI_mpart     = &( smpi->dynamics_PHI_mpart[ithread] );
+    dynamics_buffer<double> *GradPHI_mpart = &( smpi->dynamics_GradPHI_mpart[ithread] );
 
-    std::vector<int>    *iold  = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<std::complex<double>> *eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
+    dynamics_buffer<int>    *iold  = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<std::complex<double>> *eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
 
     double r, delta2, xpn, rpn;
 
@@ -781,7 +781,7 @@ void InterpolatorAM1OrderRuyten::timeCenteredEnvelope( ElectroMagn *EMfields, Pa
         ( *GradPHI_mpart )[ipart+2*nparts] = 0.; // zero with cylindrical symmetry
 
         if (r > 0){
-            exp_m_theta_local = ( particles.position( 1, ipart ) - Icpx * particles.position( 2, ipart ) ) / r ;
+            exp_m_theta_local = ( ( double )particles.position( 1, ipart ) - Icpx * ( double )particles.position( 2, ipart ) ) / r ;
         } else {
             exp_m_theta_local = 1. ;
         }
@@ -851,8 +851,8 @@ void InterpolatorAM1OrderRuyten::envelopeFieldForIonization( ElectroMagn *EMfiel
     Field2D *EnvEabs  = static_cast<Field2D*>( EMfields->Env_E_abs_ );
     Field2D *EnvExabs = static_cast<Field2D*>( EMfields->Env_Ex_abs_ );
 
-    std::vector<double> *EnvEabs_part  = &( smpi->dynamics_EnvEabs_part[ithread] );
-    std::vector<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
+    dynamics_buffer<double> *EnvEabs_part  = &( smpi->dynamics_EnvEabs_part[ithread] );
+    dynamics_buffer<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
 
     double xpn,rpn,r;
 
@@ -39,9 +39,9 @@ void InterpolatorAM1OrderRuytenV::fieldsWrapper( ElectroMagn *EMfields, Particle
     double * __restrict__ Epart[3];
     double * __restrict__ Bpart[3];
 
-    double * __restrict__ position_x = particles.getPtrPosition(0);
-    double * __restrict__ position_y = particles.getPtrPosition(1);
-    double * __restrict__ position_z = particles.getPtrPosition(2);
+    particle_real * __restrict__ position_x = particles.getPtrPosition(0);
+    particle_real * __restrict__ position_y = particles.getPtrPosition(1);
+    particle_real * __restrict__ position_z = particles.getPtrPosition(2);
 
 
     double * __restrict__ deltaO[2]; //Delta is the distance of the particle from its primal node in cell size. Delta is in [-0.5, +0.5[
@@ -79,7 +79,7 @@ void InterpolatorAM1OrderRuytenV::fieldsWrapper( ElectroMagn *EMfields, Particle
         
             int ipart2 = ipart+ivect+istart[0];
             double r = sqrt( position_y[ipart2]*position_y[ipart2] + position_z[ipart2]*position_z[ipart2] );
-            exp_m_theta_[ipart] = ( position_y[ipart2] - Icpx * position_z[ipart2] ) / r ;
+            exp_m_theta_[ipart] = ( ( double )position_y[ipart2] - Icpx * ( double )position_z[ipart2] ) / r ;
             exp_mm_theta[ipart] = 1. ;
             eitheta_old[ipart] =  2.*std::real(exp_m_theta_[ipart]) - exp_m_theta_[ipart] ;  //exp(i theta)
 
@@ -4,6 +4,7 @@
 
 #include "Particles.h"
 #include "ParticleData.h"
+#include "ParticleExpression.h"
 #include "Species.h"
 
 using namespace std;
@@ -17,6 +18,7 @@ IonizationFromRate::IonizationFromRate( Params &params, Species *species ) : Ion
     
     maximum_charge_state_ = species->maximum_charge_state_;
     ionization_rate_ = species->ionization_rate_;
+    ionization_rate_expression_ = species->ionization_rate_expression_;
     
     DEBUG( "Finished Creating the FromRate Ionizaton class" );
     
@@ -24,7 +26,7 @@ IonizationFromRate::IonizationFromRate( Params &params, Species *species ) : Ion
 
 
 
-void IonizationFromRate::operator()( Particles *particles, unsigned int ipart_min, unsigned int ipart_max, vector<double> *, Patch *patch, Projector *, int )
+void IonizationFromRate::operator()( Particles *particles, unsigned int ipart_min, unsigned int ipart_max, dynamics_buffer<double> *, Patch *patch, Projector *, int )
 {
 
     //unsigned int Z, Zp1, newZ, k_times;
@@ -36,29 +38,35 @@ void IonizationFromRate::operator()( Particles *particles, unsigned int ipart_mi
         return;
     }
     
-#ifdef SMILEI_USE_NUMPY
-    // Run python to evaluate the ionization rate for each particle
-    PyArrayObject *ret;
     unsigned int npart = ipart_max - ipart_min;
-    #pragma omp critical
-    {
-        ParticleData particleData( npart );
-        particleData.startAt( ipart_min );
-        particleData.set( particles );
-        ret = ( PyArrayObject * )PyObject_CallFunctionObjArgs( ionization_rate_, particleData.get(), NULL );
-        PyTools::checkPyError();
-        if( ret == NULL ) {
-            ERROR( "ionization_rate profile has not provided a correct result" );
-        }
-        double *arr = ( double * ) PyArray_GETPTR1( ret, 0 );
+    if( ionization_rate_expression_ ) {
+        // Native evaluation of the ionization rate for each particle
         rate.resize( npart );
-        // Loop the return value and store
-        for( unsigned int i=0; i<npart; i++ ) {
-            rate[i] = arr[i];
+        ionization_rate_expression_->evaluate( particles, ipart_min, ipart_max, &rate[0] );
+    } else {
+#ifdef SMILEI_USE_NUMPY
+        // Run python to evaluate the ionization rate for each particle
+        PyArrayObject *ret;
+        #pragma omp critical
+        {
+            ParticleData particleData( npart );
+            particleData.startAt( ipart_min );
+            particleData.set( particles );
+            ret = ( PyArrayObject * )PyObject_CallFunctionObjArgs( ionization_rate_, particleData.get(), NULL );
+            PyTools::checkPyError();
+            if( ret == NULL ) {
+                ERROR( "ionization_rate profile has not provided a correct result" );
+            }
+            double *arr = ( double * ) PyArray_GETPTR1( ret, 0 );
+            rate.resize( npart );
+            // Loop the return value and store
+            for( unsigned int i=0; i<npart; i++ ) {
+                rate[i] = arr[i];
+            }
+            Py_DECREF( ret );
         }
-        Py_DECREF( ret );
-    }
 #endif
+    }
     
     
     for( unsigned int ipart=ipart_min ; ipart<ipart_max; ipart++ ) {
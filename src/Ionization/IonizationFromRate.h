@@ -9,6 +9,7 @@
 #include "Tools.h"
 
 class Particles;
+class ParticleExpression;
 
 //! calculate the particle FromRate ionization
 class IonizationFromRate : public Ionization
@@ -19,13 +20,15 @@ public:
     IonizationFromRate( Params &params, Species *species );
 
     //! apply the FromRate Ionization model to the species
-    void operator()( Particles *, unsigned int, unsigned int, std::vector<double> *, Patch *, Projector *, int ipart_ref = 0 ) override;
+    void operator()( Particles *, unsigned int, unsigned int, dynamics_buffer<double> *, Patch *, Projector *, int ipart_ref = 0 ) override;
 
 private:
 
     //int itime;
     unsigned int maximum_charge_state_;
     PyObject *ionization_rate_;
+    //! Native version of ionization_rate_, owned by the species (NULL if python is needed)
+    const ParticleExpression *ionization_rate_expression_;
 
 };
 
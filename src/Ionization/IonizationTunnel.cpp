@@ -48,7 +48,7 @@ IonizationTunnel::IonizationTunnel( Params &params, Species *species ) : Ionizat
 
 
 
-void IonizationTunnel::operator()( Particles *particles, unsigned int ipart_min, unsigned int ipart_max, vector<double> *Epart, Patch *patch, Projector *Proj, int ipart_ref )
+void IonizationTunnel::operator()( Particles *particles, unsigned int ipart_min, unsigned int ipart_max, dynamics_buffer<double> *Epart, Patch *patch, Projector *Proj, int ipart_ref )
 {
 
     unsigned int Z, Zp1, newZ, k_times;
@@ -182,7 +182,7 @@ void IonizationTunnel::operator()( Particles *particles, unsigned int ipart_min,
 }
 
 void IonizationTunnel::ionizationTunnelWithTasks( Particles *particles, unsigned int ipart_min, unsigned int ipart_max, 
-                                                  vector<double> *Epart, Patch *patch, Projector *Proj, int ibin, int bin_shift, 
+                                                  dynamics_buffer<double> *Epart, Patch *patch, Projector *Proj, int ibin, int bin_shift, 
                                                   double *b_Jx, double *b_Jy, double *b_Jz, int ipart_ref )
 {
 
@@ -53,7 +53,7 @@ IonizationTunnelEnvelopeAveraged::IonizationTunnelEnvelopeAveraged( Params &para
     
 }
 
-void IonizationTunnelEnvelopeAveraged::envelopeIonization( Particles *particles, unsigned int ipart_min, unsigned int ipart_max, std::vector<double> *Epart, std::vector<double> *EnvEabs_part, std::vector<double> *EnvExabs_part, std::vector<double> *Phipart, Patch *patch, Projector *, int ibin, int ipart_ref )
+void IonizationTunnelEnvelopeAveraged::envelopeIonization( Particles *particles, unsigned int ipart_min, unsigned int ipart_max, dynamics_buffer<double> *Epart, dynamics_buffer<double> *EnvEabs_part, dynamics_buffer<double> *EnvExabs_part, dynamics_buffer<double> *Phipart, Patch *patch, Projector *, int ibin, int ipart_ref )
 {
     unsigned int Z, Zp1, newZ, k_times;
     double E, E_sq, EnvE_sq, Aabs, invE, delta, ran_p, Mult, D_sum, P_sum, Pint_tunnel;
@@ -20,7 +20,7 @@ public:
     IonizationTunnelEnvelopeAveraged( Params &params, Species *species );
     
     //! method for envelope ionization
-    void envelopeIonization( Particles *, unsigned int, unsigned int, std::vector<double> *, std::vector<double> *, std::vector<double> *, std::vector<double> *, Patch *, Projector *, int ibin = 0, int ipart_ref = 0 ) override;
+    void envelopeIonization( Particles *, unsigned int, unsigned int, dynamics_buffer<double> *, dynamics_buffer<double> *, dynamics_buffer<double> *, dynamics_buffer<double> *, Patch *, Projector *, int ibin = 0, int ipart_ref = 0 ) override;
 
     double ellipticity,cos_phi,sin_phi;
 
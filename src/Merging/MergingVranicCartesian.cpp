@@ -143,12 +143,12 @@ void MergingVranicCartesian::operator() (
         //     momentum[i] =  &( particles.momentum(i,0) );
 
         // Momentum shortcut
-        double * __restrict__ momentum_x = particles.getPtrMomentum(0);
-        double * __restrict__ momentum_y = particles.getPtrMomentum(1);
-        double * __restrict__ momentum_z = particles.getPtrMomentum(2);
+        particle_real * __restrict__ momentum_x = particles.getPtrMomentum(0);
+        particle_real * __restrict__ momentum_y = particles.getPtrMomentum(1);
+        particle_real * __restrict__ momentum_z = particles.getPtrMomentum(2);
 
         // Weight shortcut
-        double * __restrict__ weight = &( particles.weight( 0 ) );
+        particle_real * __restrict__ weight = &( particles.weight( 0 ) );
 
         // Cell keys shortcut
         // int *cell_keys = &( particles.cell_keys[0] );
@@ -213,14 +213,14 @@ void MergingVranicCartesian::operator() (
         reduction(max:momentum_max)
 #endif
         for (ip=(unsigned int) (istart) ; ip < (unsigned int) (iend); ip++ ) {
-            momentum_min[0] = std::min(momentum_min[0],momentum_x[ip]);
-            momentum_max[0] = std::max(momentum_max[0],momentum_x[ip]);
+            momentum_min[0] = std::min<double>(momentum_min[0],momentum_x[ip]);
+            momentum_max[0] = std::max<double>(momentum_max[0],momentum_x[ip]);
 
-            momentum_min[1] = std::min(momentum_min[1],momentum_y[ip]);
-            momentum_max[1] = std::max(momentum_max[1],momentum_y[ip]);
+            momentum_min[1] = std::min<double>(momentum_min[1],momentum_y[ip]);
+            momentum_max[1] = std::max<double>(momentum_max[1],momentum_y[ip]);
 
-            momentum_min[2] = std::min(momentum_min[2],momentum_z[ip]);
-            momentum_max[2] = std::max(momentum_max[2],momentum_z[ip]);
+            momentum_min[2] = std::min<double>(momentum_min[2],momentum_z[ip]);
+            momentum_max[2] = std::max<double>(momentum_max[2],momentum_z[ip]);
         }
 
         // ---------------------------------------------------------------------
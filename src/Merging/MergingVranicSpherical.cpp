@@ -162,12 +162,12 @@ void MergingVranicSpherical::operator() (
         double e2_norm;
 
         // Momentum shortcut
-        double * __restrict__ momentum_x = particles.getPtrMomentum(0);
-        double * __restrict__ momentum_y = particles.getPtrMomentum(1);
-        double * __restrict__ momentum_z = particles.getPtrMomentum(2);
+        particle_real * __restrict__ momentum_x = particles.getPtrMomentum(0);
+        particle_real * __restrict__ momentum_y = particles.getPtrMomentum(1);
+        particle_real * __restrict__ momentum_z = particles.getPtrMomentum(2);
 
         // Weight shortcut
-        double *weight = &( particles.weight( 0 ) );
+        particle_real *weight = &( particles.weight( 0 ) );
 
         // Cell keys shortcut
         // int *cell_keys = &( particles.cell_keys[0] );
@@ -545,6 +545,7 @@ void SimWindow::shift( VectorPatch &vecPatches, SmileiMPI *smpi, Params &params,
             x_moved += cell_length_x_*params.patch_size_[0];
             vecPatches.updateFieldList( smpi ) ;
             //update list fields for species diag too ??
+            smpi->invalidateFieldExchanges();
             
             // Tell that the patches moved this iteration (needed for probes)
             vecPatches.lastIterationPatchesMoved = itime;
@@ -96,8 +96,8 @@ void MultiphotonBreitWheeler::computeThreadPhotonChi( Particles &particles,
 {
     // _______________________________________________________________
     // Parameters
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
 
     int nparts = smpi->getBufferSize(ithread);
     const double *const __restrict__ Ex = &( ( *Epart )[0*nparts] );
@@ -108,12 +108,12 @@ void MultiphotonBreitWheeler::computeThreadPhotonChi( Particles &particles,
     const double *const __restrict__ Bz = &( ( *Bpart )[2*nparts] );
 
     // Particles Momentum shortcut
-    const double *const __restrict__ momentum_x = particles.getPtrMomentum(0);
-    const double *const __restrict__ momentum_y = particles.getPtrMomentum(1);
-    const double *const __restrict__ momentum_z = particles.getPtrMomentum(2);
+    const particle_real *const __restrict__ momentum_x = particles.getPtrMomentum(0);
+    const particle_real *const __restrict__ momentum_y = particles.getPtrMomentum(1);
+    const particle_real *const __restrict__ momentum_z = particles.getPtrMomentum(2);
 
     // Quantum parameter
-    double *const __restrict__ chi = particles.getPtrChi();
+    particle_real *const __restrict__ chi = particles.getPtrChi();
 
     // _______________________________________________________________
     // Computation
@@ -164,8 +164,8 @@ void MultiphotonBreitWheeler::operator()( Particles &particles,
 {
     // _______________________________________________________________
     // Parameters
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
 
     // We use dynamics_invgf to store gamma
     double * const __restrict__ photon_gamma = &( smpi->dynamics_invgf[ithread][0] );
@@ -185,23 +185,23 @@ void MultiphotonBreitWheeler::operator()( Particles &particles,
     double event_time;
 
     // Position shortcut
-    double *const __restrict__ position_x = particles.getPtrPosition( 0 );
-    double *const __restrict__ position_y = n_dimensions_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
-    double *const __restrict__ position_z = n_dimensions_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
+    particle_real *const __restrict__ position_x = particles.getPtrPosition( 0 );
+    particle_real *const __restrict__ position_y = n_dimensions_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
+    particle_real *const __restrict__ position_z = n_dimensions_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
 
     // Particles Momentum shortcut
-    double *const __restrict__ momentum_x = particles.getPtrMomentum(0);
-    double *const __restrict__ momentum_y = particles.getPtrMomentum(1);
-    double *const __restrict__ momentum_z = particles.getPtrMomentum(2);
+    particle_real *const __restrict__ momentum_x = particles.getPtrMomentum(0);
+    particle_real *const __restrict__ momentum_y = particles.getPtrMomentum(1);
+    particle_real *const __restrict__ momentum_z = particles.getPtrMomentum(2);
 
     // Weight shortcut
-    double *const __restrict__ weight = particles.getPtrWeight();
+    particle_real *const __restrict__ weight = particles.getPtrWeight();
 
     // Optical depth for the Monte-Carlo process
-    double *const __restrict__ tau =  particles.getPtrTau();
+    particle_real *const __restrict__ tau =  particles.getPtrTau();
 
     // Quantum parameter
-    double *const __restrict__ photon_chi = particles.getPtrChi();
+    particle_real *const __restrict__ photon_chi = particles.getPtrChi();
 
     // Photon id
     // uint64_t * id = &( particles.id(0));
@@ -212,41 +212,41 @@ void MultiphotonBreitWheeler::operator()( Particles &particles,
     // new_pair[1]->reserve( np + mBW_pair_creation_sampling_[1] * (iend - istart) );
 
     // Pair shortcut
-    double *const __restrict__ pair0_position_x = new_pair[0]->getPtrPosition( 0 );
-    double *const __restrict__ pair0_position_y = (n_dimensions_ > 1 ? new_pair[0]->getPtrPosition( 1 ) : nullptr) ;
-    double *const __restrict__ pair0_position_z = (n_dimensions_ > 2 ? new_pair[0]->getPtrPosition( 2 ) : nullptr) ;
+    particle_real *const __restrict__ pair0_position_x = new_pair[0]->getPtrPosition( 0 );
+    particle_real *const __restrict__ pair0_position_y = (n_dimensions_ > 1 ? new_pair[0]->getPtrPosition( 1 ) : nullptr) ;
+    particle_real *const __restrict__ pair0_position_z = (n_dimensions_ > 2 ? new_pair[0]->getPtrPosition( 2 ) : nullptr) ;
 
-    double *const __restrict__ pair0_position_old_x = particles.keepOldPositions() ? new_pair[0]->getPtrPositionOld( 0 ) : nullptr;
-    double *const __restrict__ pair0_position_old_y = (particles.Position_old.size() > 1 ? new_pair[0]->getPtrPositionOld( 1 ) : nullptr) ;
-    double *const __restrict__ pair0_position_old_z = (particles.Position_old.size() > 2 ? new_pair[0]->getPtrPositionOld( 2 ) : nullptr) ;
+    particle_real *const __restrict__ pair0_position_old_x = particles.keepOldPositions() ? new_pair[0]->getPtrPositionOld( 0 ) : nullptr;
+    particle_real *const __restrict__ pair0_position_old_y = (particles.Position_old.size() > 1 ? new_pair[0]->getPtrPositionOld( 1 ) : nullptr) ;
+    particle_real *const __restrict__ pair0_position_old_z = (particles.Position_old.size() > 2 ? new_pair[0]->getPtrPositionOld( 2 ) : nullptr) ;
 
-    double *const __restrict__ pair0_momentum_x = new_pair[0]->getPtrMomentum( 0 );
-    double *const __restrict__ pair0_momentum_y = new_pair[0]->getPtrMomentum( 1 );
-    double *const __restrict__ pair0_momentum_z = new_pair[0]->getPtrMomentum( 2 );
+    particle_real *const __restrict__ pair0_momentum_x = new_pair[0]->getPtrMomentum( 0 );
+    particle_real *const __restrict__ pair0_momentum_y = new_pair[0]->getPtrMomentum( 1 );
+    particle_real *const __restrict__ pair0_momentum_z = new_pair[0]->getPtrMomentum( 2 );
 
-    double *const __restrict__ pair0_weight = new_pair[0]->getPtrWeight();
+    particle_real *const __restrict__ pair0_weight = new_pair[0]->getPtrWeight();
     short *const __restrict__ pair0_charge = new_pair[0]->getPtrCharge();
 
-    double *const __restrict__ pair0_chi = new_pair[0]->has_quantum_parameter ? new_pair[0]->getPtrChi() : nullptr;
-    double *const __restrict__ pair0_tau = new_pair[0]->has_Monte_Carlo_process ? new_pair[0]->getPtrTau() : nullptr;
+    particle_real *const __restrict__ pair0_chi = new_pair[0]->has_quantum_parameter ? new_pair[0]->getPtrChi() : nullptr;
+    particle_real *const __restrict__ pair0_tau = new_pair[0]->has_Monte_Carlo_process ? new_pair[0]->getPtrTau() : nullptr;
 
-    double *const __restrict__ pair1_position_x = new_pair[1]->getPtrPosition( 0 );
-    double *const __restrict__ pair1_position_y = (n_dimensions_ > 1 ? new_pair[1]->getPtrPosition( 1 ) : nullptr);
-    double *const __restrict__ pair1_position_z = (n_dimensions_ > 2 ? new_pair[1]->getPtrPosition( 2 ) : nullptr);
+    particle_real *const __restrict__ pair1_position_x = new_pair[1]->getPtrPosition( 0 );
+    particle_real *const __restrict__ pair1_position_y = (n_dimensions_ > 1 ? new_pair[1]->getPtrPosition( 1 ) : nullptr);
+    particle_real *const __restrict__ pair1_position_z = (n_dimensions_ > 2 ? new_pair[1]->getPtrPosition( 2 ) : nullptr);
 
-    double *const __restrict__ pair1_position_old_x = particles.keepOldPositions() ? new_pair[1]->getPtrPositionOld( 0 ) : nullptr;
-    double *const __restrict__ pair1_position_old_y = (particles.Position_old.size() > 1 ? new_pair[1]->getPtrPositionOld( 1 ) : nullptr) ;
-    double *const __restrict__ pair1_position_old_z = (particles.Position_old.size() > 2 ? new_pair[1]->getPtrPositionOld( 2 ) : nullptr) ;
+    particle_real *const __restrict__ pair1_position_old_x = particles.keepOldPositions() ? new_pair[1]->getPtrPositionOld( 0 ) : nullptr;
+    particle_real *const __restrict__ pair1_position_old_y = (particles.Position_old.size() > 1 ? new_pair[1]->getPtrPositionOld( 1 ) : nullptr) ;
+    particle_real *const __restrict__ pair1_position_old_z = (particles.Position_old.size() > 2 ? new_pair[1]->getPtrPositionOld( 2 ) : nullptr) ;
 
-    double *const __restrict__ pair1_momentum_x = new_pair[1]->getPtrMomentum( 0 );
-    double *const __restrict__ pair1_momentum_y = new_pair[1]->getPtrMomentum( 1 );
-    double *const __restrict__ pair1_momentum_z = new_pair[1]->getPtrMomentum( 2 );
+    particle_real *const __restrict__ pair1_momentum_x = new_pair[1]->getPtrMomentum( 0 );
+    particle_real *const __restrict__ pair1_momentum_y = new_pair[1]->getPtrMomentum( 1 );
+    particle_real *const __restrict__ pair1_momentum_z = new_pair[1]->getPtrMomentum( 2 );
 
-    double *const __restrict__ pair1_weight = new_pair[1]->getPtrWeight();
+    particle_real *const __restrict__ pair1_weight = new_pair[1]->getPtrWeight();
     short *const __restrict__ pair1_charge = new_pair[1]->getPtrCharge();
 
-    double *const __restrict__ pair1_chi = new_pair[1]->has_quantum_parameter ? new_pair[1]->getPtrChi() : nullptr;
-    double *const __restrict__ pair1_tau = new_pair[1]->has_Monte_Carlo_process ? new_pair[1]->getPtrTau() : nullptr;
+    particle_real *const __restrict__ pair1_chi = new_pair[1]->has_quantum_parameter ? new_pair[1]->getPtrChi() : nullptr;
+    particle_real *const __restrict__ pair1_tau = new_pair[1]->has_Monte_Carlo_process ? new_pair[1]->getPtrTau() : nullptr;
 
 #ifdef SMILEI_ACCELERATOR_GPU_OACC
     // Parameters for random generator
@@ -648,13 +648,13 @@ void MultiphotonBreitWheeler::removeDecayedPhotons(
     int ibin, int nbin,
     int *bmin, int *bmax, int ithread )
 {
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
-    std::vector<double> *gamma = &( smpi->dynamics_invgf[ithread] );
-    std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *deltaold = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *gamma = &( smpi->dynamics_invgf[ithread] );
+    dynamics_buffer<int> *iold = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *deltaold = &( smpi->dynamics_deltaold[ithread] );
 
-    std::vector<std::complex<double>> *thetaold = NULL;
+    dynamics_buffer<std::complex<double>> *thetaold = NULL;
     if ( smpi->dynamics_eithetaold.size() )
         thetaold = &( smpi->dynamics_eithetaold[ithread] );
 
@@ -662,7 +662,7 @@ void MultiphotonBreitWheeler::removeDecayedPhotons(
 
     if( bmax[ibin] > bmin[ibin] ) {
         // Weight shortcut
-        double *weight = &( particles.weight( 0 ) );
+        particle_real *weight = &( particles.weight( 0 ) );
 
         // Backward loop over the photons to fing the first existing photon
         int last_photon_index = bmax[ibin]-1; // Index of the last existing photon (weight > 0)
@@ -772,7 +772,7 @@ void MultiphotonBreitWheeler::removeDecayedPhotonsWithoutBinCompression(
 
     if( bmax[ibin] > bmin[ibin] ) {
         // Weight shortcut
-        double *const weight = particles.getPtrWeight();
+        particle_real *const weight = particles.getPtrWeight();
         //int nb_deleted_photon;
 
         // Backward loop over the photons to find the first existing photon
@@ -713,8 +713,58 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     PyTools::extract( "patch_arrangement", patch_arrangement, "Main"  );
     CAREFUL( 0,"Patches distribution: " << patch_arrangement );
 
+    PyTools::extract( "particle_exchange", particle_exchange, "Main"  );
+    if( particle_exchange != "per_dimension" && particle_exchange != "direct" ) {
+        ERROR_NAMELIST( "particle_exchange must be \"per_dimension\" or \"direct\"",  LINK_NAMELIST + std::string("#main-variables") );
+    }
+    direct_particle_exchange = ( particle_exchange == "direct" );
+    if( direct_particle_exchange ) {
+        if( geometry == "AMcylindrical" ) {
+            ERROR_NAMELIST( "particle_exchange = \"direct\" is not available in AMcylindrical geometry",  LINK_NAMELIST + std::string("#main-variables") );
+        }
+#if defined( SMILEI_ACCELERATOR_GPU )
+        ERROR_NAMELIST( "particle_exchange = \"direct\" is not available on GPU",  LINK_NAMELIST + std::string("#main-variables") );
+#endif
+        CAREFUL( 0,"Particle exchange: direct (single round with all the surrounding patches)" );
+    }
+
+    PyTools::extract( "field_exchange", field_exchange, "Main"  );
+    if( field_exchange != "aggregated" && field_exchange != "per_patch" ) {
+        ERROR_NAMELIST( "field_exchange must be \"aggregated\" or \"per_patch\"",  LINK_NAMELIST + std::string("#main-variables") );
+    }
+    aggregated_field_exchange = ( field_exchange == "aggregated" );
+#if defined( SMILEI_ACCELERATOR_GPU )
+    // Ghost regions are sent directly from the device, patch per patch
+    aggregated_field_exchange = false;
+#endif
+
+    PyTools::extract( "shared_memory_exchange", shared_memory_exchange, "Main"  );
+    if( shared_memory_exchange ) {
+        if( ! aggregated_field_exchange && ! direct_particle_exchange ) {
+            WARNING( "shared_memory_exchange requires field_exchange = \"aggregated\" or particle_exchange = \"direct\": it is ignored" );
+            shared_memory_exchange = false;
+        } else {
+            CAREFUL( 0,"Exchanges between the MPI processes of a node through shared memory" );
+        }
+    }
+
+    PyTools::extract( "patch_scheduling", patch_scheduling, "Main"  );
+    if( patch_scheduling != "runtime" && patch_scheduling != "cost" ) {
+        ERROR_NAMELIST( "patch_scheduling must be \"runtime\" or \"cost\"",  LINK_NAMELIST + std::string("#main-variables") );
+    }
+    cost_ordered_patches = ( patch_scheduling == "cost" );
+#ifdef _OMPTASKS
+    if( cost_ordered_patches ) {
+        WARNING( "patch_scheduling = \"cost\" is ignored with OpenMP tasks" );
+        cost_ordered_patches = false;
+    }
+#endif
+    if( cost_ordered_patches ) {
+        CAREFUL( 0,"Patches processed by decreasing cost of their particle operations" );
+    }
+
     int total_number_of_hilbert_patches = 1;
-    if( patch_arrangement == "hilbertian" ) {
+    if( patch_arrangement == "hilbertian" || patch_arrangement == "rcb" ) {
         for( unsigned int iDim=0 ; iDim<nDim_field ; iDim++ ) {
             total_number_of_hilbert_patches *= number_of_patches[iDim];
             if( ( number_of_patches[iDim] & ( number_of_patches[iDim]-1 ) ) != 0 ) {
@@ -734,14 +784,45 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
         PyTools::extract( "cell_load", cell_load, "LoadBalancing"   );
         PyTools::extract( "frozen_particle_load", frozen_particle_load, "LoadBalancing"   );
         PyTools::extract( "initial_balance", initial_balance, "LoadBalancing"   );
+        PyTools::extract( "load_model", load_model, "LoadBalancing"   );
+        if( load_model != "particles" && load_model != "measured" ) {
+            ERROR_NAMELIST( "LoadBalancing.load_model must be \"particles\" or \"measured\"", LINK_NAMELIST + std::string("#load-balancing") );
+        }
+        PyTools::extract( "measured_load_smoothing", measured_load_smoothing, "LoadBalancing"   );
+        if( measured_load_smoothing <= 0. || measured_load_smoothing > 1. ) {
+            ERROR_NAMELIST( "LoadBalancing.measured_load_smoothing must be in ]0, 1]", LINK_NAMELIST + std::string("#load-balancing") );
+        }
+        PyTools::extract( "imbalance_threshold", imbalance_threshold, "LoadBalancing"   );
+        if( imbalance_threshold != 0. && imbalance_threshold <= 1. ) {
+            ERROR_NAMELIST( "LoadBalancing.imbalance_threshold must be 0 or larger than 1", LINK_NAMELIST + std::string("#load-balancing") );
+        }
+        PyTools::extract( "migration_budget", migration_budget, "LoadBalancing"   );
+        if( migration_budget < 0. ) {
+            ERROR_NAMELIST( "LoadBalancing.migration_budget must be positive", LINK_NAMELIST + std::string("#load-balancing") );
+        }
+        PyTools::extract( "hierarchical", hierarchical_load_balancing, "LoadBalancing"   );
+        PyTools::extract( "node_imbalance_tolerance", node_imbalance_tolerance, "LoadBalancing"   );
+        if( node_imbalance_tolerance < 0. ) {
+            ERROR_NAMELIST( "LoadBalancing.node_imbalance_tolerance must be positive", LINK_NAMELIST + std::string("#load-balancing") );
+        }
+#ifndef __DETAILED_TIMERS
+        if( load_model == "measured" ) {
+            WARNING( "LoadBalancing.load_model = \"measured\" requires the detailed timers (make config=detailed_timers): the \"particles\" model is used" );
+            load_model = "particles";
+        }
+#endif
     } else {
         load_balancing_time_selection = new TimeSelection();
+        load_model = "particles";
+        imbalance_threshold = 0.;
+        migration_budget = 0.;
+        hierarchical_load_balancing = false;
     }
 
     has_load_balancing = ( smpi->getSize()>1 )  && ( ! load_balancing_time_selection->isEmpty() );
 
-    if( has_load_balancing && patch_arrangement != "hilbertian" ) {
-        ERROR_NAMELIST( "Dynamic load balancing is only available for Hilbert decomposition",  LINK_NAMELIST + std::string("#main-variables") );
+    if( has_load_balancing && patch_arrangement != "hilbertian" && patch_arrangement != "rcb" ) {
+        ERROR_NAMELIST( "Dynamic load balancing is only available for Hilbert or RCB decomposition",  LINK_NAMELIST + std::string("#main-variables") );
     }
     if( has_load_balancing && total_number_of_hilbert_patches < 2*smpi->getSize() ) {
         ERROR_NAMELIST( "Dynamic load balancing requires to use at least 2 patches per MPI process.",  LINK_NAMELIST + std::string("#main-variables") );
@@ -1455,9 +1536,22 @@ void Params::print_init()
         } else {
             MESSAGE( 1, "Patches are initially homogeneously distributed between MPI ranks. (initial_balance = false) " );
         }
-        MESSAGE( 1, "Happens: " << load_balancing_time_selection->info() );
+        if( imbalance_threshold > 0. ) {
+            MESSAGE( 1, "Happens: when the imbalance exceeds " << imbalance_threshold << " and is worth the exchange of patches" );
+        } else {
+            MESSAGE( 1, "Happens: " << load_balancing_time_selection->info() );
+        }
+        if( hierarchical_load_balancing ) {
+            MESSAGE( 1, "Hierarchical: balanced between nodes (tolerance " << node_imbalance_tolerance << "), then inside each node" );
+        }
+        if( migration_budget > 0. ) {
+            MESSAGE( 1, "Patches migrated by batches of at most " << migration_budget << " particles per neighbour and per iteration" );
+        }
         MESSAGE( 1, "Cell load coefficient = " << cell_load );
         MESSAGE( 1, "Frozen particle load coefficient = " << frozen_particle_load );
+        if( load_model == "measured" ) {
+            MESSAGE( 1, "Particle load measured by the detailed timers, smoothing = " << measured_load_smoothing );
+        }
     }
 
     TITLE( "Vectorization: " );
@@ -273,6 +273,22 @@ public:
     std::vector<unsigned int> number_of_patches;
     //! Domain decomposition
     std::string patch_arrangement;
+    //! Particle exchange between patches: "per_dimension" or "direct" (single round with all the surrounding patches)
+    std::string particle_exchange;
+    //! True if the leaving particles are sent directly to the 3^nDim-1 surrounding patches
+    bool direct_particle_exchange;
+    //! Field exchange between patches: "aggregated" (one message per MPI process) or "per_patch"
+    std::string field_exchange;
+    //! True if the ghost regions bound to the same MPI process are sent in a single message
+    bool aggregated_field_exchange;
+    //! True if the aggregated field exchanges and the direct particle exchange go through
+    //! MPI-3 shared memory between the processes of a node
+    bool shared_memory_exchange;
+
+    //! Order of the patches in the particle loop of each process: "runtime" (OpenMP runtime schedule)
+    //! or "cost" (decreasing time at the previous iteration)
+    std::string patch_scheduling;
+    bool cost_ordered_patches;
 
     //! Time selection for adaptive vectorization
     TimeSelection *adaptive_vecto_time_selection;
@@ -287,6 +303,20 @@ public:
     double cell_load;
     //! Load coefficient applied to a frozen particle (default = 0.1)
     double frozen_particle_load;
+    //! Load of a patch: "particles" (cells and particles count) or "measured" (detailed timers)
+    std::string load_model;
+    //! Weight of the last measure in the moving average of the measured load of a patch
+    double measured_load_smoothing;
+    //! Imbalance (largest over average time of the processes) above which the load is balanced, instead
+    //! of at fixed iterations (0 = fixed iterations)
+    double imbalance_threshold;
+    //! Number of particles above which the patches given to a neighbour process are migrated over
+    //! several iterations (0 = all at once)
+    double migration_budget;
+    //! Balance the load between nodes, then between the processes of each node
+    bool hierarchical_load_balancing;
+    //! Relative imbalance of the nodes below which no patch moves between nodes
+    double node_imbalance_tolerance;
     //! Return if number of patch = number of MPI process, to tune IO //ism
     bool one_patch_per_MPI;
     //! Compute an initially balanced patch distribution right from the start
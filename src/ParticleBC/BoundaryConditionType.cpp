@@ -13,10 +13,10 @@
 #include "userFunctions.h"
 
 
-void internal_inf( Species *species, int imin, int imax, int direction, double limit_inf, double /*dt*/, std::vector<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
+void internal_inf( Species *species, int imin, int imax, int direction, double limit_inf, double /*dt*/, dynamics_buffer<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
 {
     energy_change = 0.;     // no energy loss during exchange
-    const double* const position  = species->particles->getPtrPosition( direction );
+    const particle_real* const position  = species->particles->getPtrPosition( direction );
     int* const          cell_keys = species->particles->getPtrCellKeys();
 #if defined( SMILEI_ACCELERATOR_GPU_OACC )
     #pragma acc parallel deviceptr(position,cell_keys)
@@ -35,10 +35,10 @@ void internal_inf( Species *species, int imin, int imax, int direction, double l
     }
 }
 
-void internal_sup( Species *species, int imin, int imax, int direction, double limit_sup, double /*dt*/, std::vector<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
+void internal_sup( Species *species, int imin, int imax, int direction, double limit_sup, double /*dt*/, dynamics_buffer<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
 {
     energy_change = 0.;     // no energy loss during exchange
-    const double* const position  = species->particles->getPtrPosition( direction );
+    const particle_real* const position  = species->particles->getPtrPosition( direction );
     int* const          cell_keys = species->particles->getPtrCellKeys();
 #if defined( SMILEI_ACCELERATOR_GPU_OACC )
     #pragma acc parallel deviceptr(position,cell_keys)
@@ -57,11 +57,11 @@ void internal_sup( Species *species, int imin, int imax, int direction, double l
     }
 }
 
-void internal_inf_AM( Species *species, int imin, int imax, int /*direction*/, double limit_inf, double /*dt*/, std::vector<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
+void internal_inf_AM( Species *species, int imin, int imax, int /*direction*/, double limit_inf, double /*dt*/, dynamics_buffer<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
 {
     energy_change = 0.;     // no energy loss during exchange
-    double* position_y = species->particles->getPtrPosition(1);
-    double* position_z = species->particles->getPtrPosition(2);
+    particle_real* position_y = species->particles->getPtrPosition(1);
+    particle_real* position_z = species->particles->getPtrPosition(2);
     int* cell_keys = species->particles->getPtrCellKeys();
     double limit_inf2 = limit_inf*limit_inf;
     for( int ipart=imin ; ipart<imax ; ipart++ ) {
@@ -72,11 +72,11 @@ void internal_inf_AM( Species *species, int imin, int imax, int /*direction*/, d
     }
 }
 
-void internal_sup_AM( Species *species, int imin, int imax, int /*direction*/, double limit_sup, double /*dt*/, std::vector<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
+void internal_sup_AM( Species *species, int imin, int imax, int /*direction*/, double limit_sup, double /*dt*/, dynamics_buffer<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
 {
     energy_change = 0.;     // no energy loss during exchange
-    double* position_y = species->particles->getPtrPosition(1);
-    double* position_z = species->particles->getPtrPosition(2);
+    particle_real* position_y = species->particles->getPtrPosition(1);
+    particle_real* position_z = species->particles->getPtrPosition(2);
     int* cell_keys = species->particles->getPtrCellKeys();
     double limit_sup2 = limit_sup*limit_sup;
     for( int ipart=imin ; ipart<imax ; ipart++ ) {
@@ -87,11 +87,11 @@ void internal_sup_AM( Species *species, int imin, int imax, int /*direction*/, d
     }
 }
 
-void reflect_particle_inf( Species *species, int imin, int imax, int direction, double limit_inf, double /*dt*/, std::vector<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
+void reflect_particle_inf( Species *species, int imin, int imax, int direction, double limit_inf, double /*dt*/, dynamics_buffer<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
 {
     energy_change = 0.;     // no energy loss during reflection
-    double* position = species->particles->getPtrPosition(direction);
-    double* momentum = species->particles->getPtrMomentum(direction);
+    particle_real* position = species->particles->getPtrPosition(direction);
+    particle_real* momentum = species->particles->getPtrMomentum(direction);
 #ifdef SMILEI_ACCELERATOR_GPU_OACC
     #pragma acc parallel deviceptr(position,momentum)
     #pragma acc loop gang worker vector
@@ -107,11 +107,11 @@ void reflect_particle_inf( Species *species, int imin, int imax, int direction,
     }
 }
 
-void reflect_particle_sup( Species *species, int imin, int imax, int direction, double limit_sup, double /*dt*/, std::vector<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
+void reflect_particle_sup( Species *species, int imin, int imax, int direction, double limit_sup, double /*dt*/, dynamics_buffer<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
 {
     energy_change = 0.;     // no energy loss during reflection
-    double* position = species->particles->getPtrPosition(direction);
-    double* momentum = species->particles->getPtrMomentum(direction);
+    particle_real* position = species->particles->getPtrPosition(direction);
+    particle_real* momentum = species->particles->getPtrMomentum(direction);
 #ifdef SMILEI_ACCELERATOR_GPU_OACC
     #pragma acc parallel deviceptr(position,momentum)
     #pragma acc loop gang worker vector
@@ -127,11 +127,11 @@ void reflect_particle_sup( Species *species, int imin, int imax, int direction,
     }
 }
 
-void reflect_particle_wall( Species *species, int imin, int imax, int direction, double wall_position, double dt, std::vector<double> &invgf, Random * /*rand*/, double &energy_change )
+void reflect_particle_wall( Species *species, int imin, int imax, int direction, double wall_position, double dt, dynamics_buffer<double> &invgf, Random * /*rand*/, double &energy_change )
 {
     energy_change = 0.;     // no energy loss during reflection
-    double* position = species->particles->getPtrPosition(direction);
-    double* momentum = species->particles->getPtrMomentum(direction);
+    particle_real* position = species->particles->getPtrPosition(direction);
+    particle_real* momentum = species->particles->getPtrMomentum(direction);
     for (int ipart=imin ; ipart<imax ; ipart++ ) {
         double particle_position     = position[ipart];
         double particle_position_old = particle_position - dt*invgf[ipart]*momentum[ipart]; 
@@ -143,14 +143,14 @@ void reflect_particle_wall( Species *species, int imin, int imax, int direction,
 }
 
 // direction not used below, direction is "r"
-void refl_particle_AM( Species *species, int imin, int imax, int /*direction*/, double limit_sup, double /*dt*/, std::vector<double> &invgf, Random * /*rand*/, double &energy_change )
+void refl_particle_AM( Species *species, int imin, int imax, int /*direction*/, double limit_sup, double /*dt*/, dynamics_buffer<double> &invgf, Random * /*rand*/, double &energy_change )
 {
     energy_change = 0.;     // no energy loss during reflection
     
-    double* position_y = species->particles->getPtrPosition(1);
-    double* position_z = species->particles->getPtrPosition(2);
-    double* momentum_y = species->particles->getPtrMomentum(1);
-    double* momentum_z = species->particles->getPtrMomentum(2);
+    particle_real* position_y = species->particles->getPtrPosition(1);
+    particle_real* position_z = species->particles->getPtrPosition(2);
+    particle_real* momentum_y = species->particles->getPtrMomentum(1);
+    particle_real* momentum_z = species->particles->getPtrMomentum(2);
     //We look for the coordinate of the point at which the particle crossed the boundary
     //We need to fine the parameter t at which (y - vy*t)^2+(z-vz*t)^2 = Rmax^2
     for (int ipart=imin ; ipart<imax ; ipart++ ) {
@@ -198,19 +198,19 @@ void remove_particle_inf( Species* species,
                           int direction, 
                           double limit_inf, 
                           double /*dt*/, 
-                          std::vector<double>& /*invgf*/, 
+                          dynamics_buffer<double> &/*invgf*/, 
                           Random* /*rand*/, 
                           double& energy_change )
 {
 
     double change_in_energy = 0.0;
 
-    const double *const position   = species->particles->getPtrPosition( direction );
-    const double *const momentum_x = species->particles->getPtrMomentum( 0 );
-    const double *const momentum_y = species->particles->getPtrMomentum( 1 );
-    const double *const momentum_z = species->particles->getPtrMomentum( 2 );
+    const particle_real *const position   = species->particles->getPtrPosition( direction );
+    const particle_real *const momentum_x = species->particles->getPtrMomentum( 0 );
+    const particle_real *const momentum_y = species->particles->getPtrMomentum( 1 );
+    const particle_real *const momentum_z = species->particles->getPtrMomentum( 2 );
     short  *const charge     = species->particles->getPtrCharge();
-    const double *const weight     = species->particles->getPtrWeight();
+    const particle_real *const weight     = species->particles->getPtrWeight();
     int    *const cell_keys  = species->particles->getPtrCellKeys();
 
 #if defined( SMILEI_ACCELERATOR_GPU_OMP )
@@ -244,19 +244,19 @@ void remove_particle_sup( Species* species,
                           int direction, 
                           double limit_sup, 
                           double /*dt*/, 
-                          std::vector<double>& /*invgf*/, 
+                          dynamics_buffer<double> &/*invgf*/, 
                           Random* /*rand*/, 
                           double& energy_change )
 {
 
     double change_in_energy = 0.0;
 
-    const double *const position   = species->particles->getPtrPosition( direction );
-    const double *const momentum_x = species->particles->getPtrMomentum( 0 );
-    const double *const momentum_y = species->particles->getPtrMomentum( 1 );
-    const double *const momentum_z = species->particles->getPtrMomentum( 2 );
+    const particle_real *const position   = species->particles->getPtrPosition( direction );
+    const particle_real *const momentum_x = species->particles->getPtrMomentum( 0 );
+    const particle_real *const momentum_y = species->particles->getPtrMomentum( 1 );
+    const particle_real *const momentum_z = species->particles->getPtrMomentum( 2 );
     short  *const charge     = species->particles->getPtrCharge();
-    const double *const weight     = species->particles->getPtrWeight();
+    const particle_real *const weight     = species->particles->getPtrWeight();
     int    *const cell_keys  = species->particles->getPtrCellKeys();
 
 #if defined( SMILEI_ACCELERATOR_GPU_OMP )
@@ -285,16 +285,16 @@ void remove_particle_sup( Species* species,
     energy_change = change_in_energy;
 }
 
-void remove_particle_wall( Species *species, int imin, int imax, int direction, double wall_position, double dt, std::vector<double> &invgf, Random * /*rand*/, double &energy_change )
+void remove_particle_wall( Species *species, int imin, int imax, int direction, double wall_position, double dt, dynamics_buffer<double> &invgf, Random * /*rand*/, double &energy_change )
 {
     energy_change = 0.;
-    double* position = species->particles->getPtrPosition(direction);
-    double* momentum = species->particles->getPtrMomentum(direction);
-    double* momentum_x = species->particles->getPtrMomentum(0);
-    double* momentum_y = species->particles->getPtrMomentum(1);
-    double* momentum_z = species->particles->getPtrMomentum(2);
+    particle_real* position = species->particles->getPtrPosition(direction);
+    particle_real* momentum = species->particles->getPtrMomentum(direction);
+    particle_real* momentum_x = species->particles->getPtrMomentum(0);
+    particle_real* momentum_y = species->particles->getPtrMomentum(1);
+    particle_real* momentum_z = species->particles->getPtrMomentum(2);
     short* charge    = species->particles->getPtrCharge();
-    double* weight   = species->particles->getPtrWeight();
+    particle_real* weight   = species->particles->getPtrWeight();
     int* cell_keys   = species->particles->getPtrCellKeys();
     for (int ipart=imin ; ipart<imax ; ipart++ ) {
         double particle_position     = position[ipart];
@@ -308,16 +308,16 @@ void remove_particle_wall( Species *species, int imin, int imax, int direction,
     }
 }
 
-void remove_particle_AM( Species *species, int imin, int imax, int /*direction*/, double limit_sup, double /*dt*/, std::vector<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
+void remove_particle_AM( Species *species, int imin, int imax, int /*direction*/, double limit_sup, double /*dt*/, dynamics_buffer<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
 {
     energy_change = 0.;
-    double* position_y = species->particles->getPtrPosition(1);
-    double* position_z = species->particles->getPtrPosition(2);
-    double* momentum_x = species->particles->getPtrMomentum(0);
-    double* momentum_y = species->particles->getPtrMomentum(1);
-    double* momentum_z = species->particles->getPtrMomentum(2);
+    particle_real* position_y = species->particles->getPtrPosition(1);
+    particle_real* position_z = species->particles->getPtrPosition(2);
+    particle_real* momentum_x = species->particles->getPtrMomentum(0);
+    particle_real* momentum_y = species->particles->getPtrMomentum(1);
+    particle_real* momentum_z = species->particles->getPtrMomentum(2);
     short* charge    = species->particles->getPtrCharge();
-    double* weight   = species->particles->getPtrWeight();
+    particle_real* weight   = species->particles->getPtrWeight();
     int* cell_keys   = species->particles->getPtrCellKeys();
     for (int ipart=imin ; ipart<imax ; ipart++ ) {
         double distance2ToAxis = position_y[ipart]*position_y[ipart]+position_z[ipart]*position_z[ipart];
@@ -331,14 +331,14 @@ void remove_particle_AM( Species *species, int imin, int imax, int /*direction*/
 }
 
 //! Delete photon (mass_==0) at the boundary and keep the energy for diagnostics
-void remove_photon_inf( Species *species, int imin, int imax, int direction, double limit_inf, double /*dt*/, std::vector<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
+void remove_photon_inf( Species *species, int imin, int imax, int direction, double limit_inf, double /*dt*/, dynamics_buffer<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
 {
     energy_change = 0.;
-    double* position = species->particles->getPtrPosition(direction);
-    double* momentum_x = species->particles->getPtrMomentum(0);
-    double* momentum_y = species->particles->getPtrMomentum(1);
-    double* momentum_z = species->particles->getPtrMomentum(2);
-    double* weight     = species->particles->getPtrWeight();
+    particle_real* position = species->particles->getPtrPosition(direction);
+    particle_real* momentum_x = species->particles->getPtrMomentum(0);
+    particle_real* momentum_y = species->particles->getPtrMomentum(1);
+    particle_real* momentum_z = species->particles->getPtrMomentum(2);
+    particle_real* weight     = species->particles->getPtrWeight();
     short* charge    = species->particles->getPtrCharge();
     int* cell_keys   = species->particles->getPtrCellKeys();
     for (int ipart=imin ; ipart<imax ; ipart++ ) {
@@ -351,14 +351,14 @@ void remove_photon_inf( Species *species, int imin, int imax, int direction, dou
     }
 }
 
-void remove_photon_sup( Species *species, int imin, int imax, int direction, double limit_sup, double /*dt*/, std::vector<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
+void remove_photon_sup( Species *species, int imin, int imax, int direction, double limit_sup, double /*dt*/, dynamics_buffer<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
 {
     energy_change = 0.;
-    double* position = species->particles->getPtrPosition(direction);
-    double* momentum_x = species->particles->getPtrMomentum(0);
-    double* momentum_y = species->particles->getPtrMomentum(1);
-    double* momentum_z = species->particles->getPtrMomentum(2);
-    double* weight     = species->particles->getPtrWeight();
+    particle_real* position = species->particles->getPtrPosition(direction);
+    particle_real* momentum_x = species->particles->getPtrMomentum(0);
+    particle_real* momentum_y = species->particles->getPtrMomentum(1);
+    particle_real* momentum_z = species->particles->getPtrMomentum(2);
+    particle_real* weight     = species->particles->getPtrWeight();
     short* charge    = species->particles->getPtrCharge();
     int* cell_keys   = species->particles->getPtrCellKeys();
     for (int ipart=imin ; ipart<imax ; ipart++ ) {
@@ -371,14 +371,14 @@ void remove_photon_sup( Species *species, int imin, int imax, int direction, dou
     }
 }
 
-void stop_particle_inf( Species *species, int imin, int imax, int direction, double limit_inf, double /*dt*/, std::vector<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
+void stop_particle_inf( Species *species, int imin, int imax, int direction, double limit_inf, double /*dt*/, dynamics_buffer<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
 {
     energy_change = 0;
-    double* position = species->particles->getPtrPosition(direction);
-    double* momentum_x = species->particles->getPtrMomentum(0);
-    double* momentum_y = species->particles->getPtrMomentum(1);
-    double* momentum_z = species->particles->getPtrMomentum(2);
-    double* weight     = species->particles->getPtrWeight();
+    particle_real* position = species->particles->getPtrPosition(direction);
+    particle_real* momentum_x = species->particles->getPtrMomentum(0);
+    particle_real* momentum_y = species->particles->getPtrMomentum(1);
+    particle_real* momentum_z = species->particles->getPtrMomentum(2);
+    particle_real* weight     = species->particles->getPtrWeight();
     for (int ipart=imin ; ipart<imax ; ipart++ ) {
         if ( position[ ipart ] < limit_inf) {
             double LorentzFactor = sqrt( 1.+pow( momentum_x[ipart], 2 )+pow( momentum_y[ipart], 2 )+pow( momentum_z[ipart], 2 ) );
@@ -391,14 +391,14 @@ void stop_particle_inf( Species *species, int imin, int imax, int direction, dou
     }
 }
 
-void stop_particle_sup( Species *species, int imin, int imax, int direction, double limit_sup, double /*dt*/, std::vector<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
+void stop_particle_sup( Species *species, int imin, int imax, int direction, double limit_sup, double /*dt*/, dynamics_buffer<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
 {
     energy_change = 0;
-    double* position = species->particles->getPtrPosition(direction);
-    double* momentum_x = species->particles->getPtrMomentum(0);
-    double* momentum_y = species->particles->getPtrMomentum(1);
-    double* momentum_z = species->particles->getPtrMomentum(2);
-    double* weight     = species->particles->getPtrWeight();
+    particle_real* position = species->particles->getPtrPosition(direction);
+    particle_real* momentum_x = species->particles->getPtrMomentum(0);
+    particle_real* momentum_y = species->particles->getPtrMomentum(1);
+    particle_real* momentum_z = species->particles->getPtrMomentum(2);
+    particle_real* weight     = species->particles->getPtrWeight();
     for (int ipart=imin ; ipart<imax ; ipart++ ) {
         if ( position[ ipart ] >= limit_sup) {
             double LorentzFactor = sqrt( 1.+pow( momentum_x[ipart], 2 )+pow( momentum_y[ipart], 2 )+pow( momentum_z[ipart], 2 ) );
@@ -411,15 +411,15 @@ void stop_particle_sup( Species *species, int imin, int imax, int direction, dou
     }
 }
 
-void stop_particle_wall( Species *species, int imin, int imax, int direction, double wall_position, double dt, std::vector<double> &invgf, Random * /*rand*/, double &energy_change )
+void stop_particle_wall( Species *species, int imin, int imax, int direction, double wall_position, double dt, dynamics_buffer<double> &invgf, Random * /*rand*/, double &energy_change )
 {
     energy_change = 0;
-    double* position = species->particles->getPtrPosition(direction);
-    double* momentum = species->particles->getPtrMomentum(direction);
-    double* momentum_x = species->particles->getPtrMomentum(0);
-    double* momentum_y = species->particles->getPtrMomentum(1);
-    double* momentum_z = species->particles->getPtrMomentum(2);
-    double* weight     = species->particles->getPtrWeight();
+    particle_real* position = species->particles->getPtrPosition(direction);
+    particle_real* momentum = species->particles->getPtrMomentum(direction);
+    particle_real* momentum_x = species->particles->getPtrMomentum(0);
+    particle_real* momentum_y = species->particles->getPtrMomentum(1);
+    particle_real* momentum_z = species->particles->getPtrMomentum(2);
+    particle_real* weight     = species->particles->getPtrWeight();
     for (int ipart=imin ; ipart<imax ; ipart++ ) {
         double particle_position     = position[ipart];
         double particle_position_old = particle_position - dt*invgf[ipart]*momentum[ipart];
@@ -434,14 +434,14 @@ void stop_particle_wall( Species *species, int imin, int imax, int direction, do
     }
 }
 
-void stop_particle_AM( Species *species, int imin, int imax, int /*direction*/, double limit_sup, double /*dt*/, std::vector<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
+void stop_particle_AM( Species *species, int imin, int imax, int /*direction*/, double limit_sup, double /*dt*/, dynamics_buffer<double> &/*invgf*/, Random * /*rand*/, double &energy_change )
 {
-    double* position_y = species->particles->getPtrPosition(1);
-    double* position_z = species->particles->getPtrPosition(2);
-    double* momentum_x = species->particles->getPtrMomentum(0);
-    double* momentum_y = species->particles->getPtrMomentum(1);
-    double* momentum_z = species->particles->getPtrMomentum(2);
-    double* weight     = species->particles->getPtrWeight();
+    particle_real* position_y = species->particles->getPtrPosition(1);
+    particle_real* position_z = species->particles->getPtrPosition(2);
+    particle_real* momentum_x = species->particles->getPtrMomentum(0);
+    particle_real* momentum_y = species->particles->getPtrMomentum(1);
+    particle_real* momentum_z = species->particles->getPtrMomentum(2);
+    particle_real* weight     = species->particles->getPtrWeight();
 
     energy_change = 0;
     for (int ipart=imin ; ipart<imax ; ipart++ ) {
@@ -468,17 +468,17 @@ void stop_particle_AM( Species *species, int imin, int imax, int /*direction*/,
     
 }
 
-void thermalize_particle_inf( Species *species, int imin, int imax, int direction, double limit_inf, double /*dt*/, std::vector<double> &/*invgf*/, Random * rand, double &energy_change )
+void thermalize_particle_inf( Species *species, int imin, int imax, int direction, double limit_inf, double /*dt*/, dynamics_buffer<double> &/*invgf*/, Random * rand, double &energy_change )
 {
     int nDim = species->nDim_particle;
-    double* position = species->particles->getPtrPosition(direction);
-    double* momentum = species->particles->getPtrMomentum(direction);
-    double* momentumRefl_2D = species->particles->getPtrMomentum((direction+1)%nDim);
-    double* momentumRefl_3D = species->particles->getPtrMomentum((direction+2)%nDim);
-    double* momentum_x = species->particles->getPtrMomentum(0);
-    double* momentum_y = species->particles->getPtrMomentum(1);
-    double* momentum_z = species->particles->getPtrMomentum(2);
-    double* weight     = species->particles->getPtrWeight();
+    particle_real* position = species->particles->getPtrPosition(direction);
+    particle_real* momentum = species->particles->getPtrMomentum(direction);
+    particle_real* momentumRefl_2D = species->particles->getPtrMomentum((direction+1)%nDim);
+    particle_real* momentumRefl_3D = species->particles->getPtrMomentum((direction+2)%nDim);
+    particle_real* momentum_x = species->particles->getPtrMomentum(0);
+    particle_real* momentum_y = species->particles->getPtrMomentum(1);
+    particle_real* momentum_z = species->particles->getPtrMomentum(2);
+    particle_real* weight     = species->particles->getPtrWeight();
 
     energy_change = 0;
     for (int ipart=imin ; ipart<imax ; ipart++ ) {
@@ -570,17 +570,17 @@ void thermalize_particle_inf( Species *species, int imin, int imax, int directio
     }
 }
 
-void thermalize_particle_sup( Species *species, int imin, int imax, int direction, double limit_sup, double /*dt*/, std::vector<double> &/*invgf*/, Random * rand, double &energy_change )
+void thermalize_particle_sup( Species *species, int imin, int imax, int direction, double limit_sup, double /*dt*/, dynamics_buffer<double> &/*invgf*/, Random * rand, double &energy_change )
 {
     int nDim = species->nDim_particle;
-    double* position = species->particles->getPtrPosition(direction);
-    double* momentum = species->particles->getPtrMomentum(direction);
-    double* momentumRefl_2D = species->particles->getPtrMomentum((direction+1)%nDim);
-    double* momentumRefl_3D = species->particles->getPtrMomentum((direction+2)%nDim);
-    double* momentum_x = species->particles->getPtrMomentum(0);
-    double* momentum_y = species->particles->getPtrMomentum(1);
-    double* momentum_z = species->particles->getPtrMomentum(2);
-    double* weight     = species->particles->getPtrWeight();
+    particle_real* position = species->particles->getPtrPosition(direction);
+    particle_real* momentum = species->particles->getPtrMomentum(direction);
+    particle_real* momentumRefl_2D = species->particles->getPtrMomentum((direction+1)%nDim);
+    particle_real* momentumRefl_3D = species->particles->getPtrMomentum((direction+2)%nDim);
+    particle_real* momentum_x = species->particles->getPtrMomentum(0);
+    particle_real* momentum_y = species->particles->getPtrMomentum(1);
+    particle_real* momentum_z = species->particles->getPtrMomentum(2);
+    particle_real* weight     = species->particles->getPtrWeight();
 
     energy_change = 0;
     for (int ipart=imin ; ipart<imax ; ipart++ ) {
@@ -673,17 +673,17 @@ void thermalize_particle_sup( Species *species, int imin, int imax, int directio
 }
 
 
-void thermalize_particle_wall( Species *species, int imin, int imax, int direction, double wall_position, double dt, std::vector<double> &invgf, Random * rand, double &energy_change )
+void thermalize_particle_wall( Species *species, int imin, int imax, int direction, double wall_position, double dt, dynamics_buffer<double> &invgf, Random * rand, double &energy_change )
 {
     int nDim = species->nDim_particle;
-    double* position = species->particles->getPtrPosition(direction);
-    double* momentum = species->particles->getPtrMomentum(direction);
-    double* momentumRefl_2D = species->particles->getPtrMomentum((direction+1)%nDim);
-    double* momentumRefl_3D = species->particles->getPtrMomentum((direction+2)%nDim);
-    double* momentum_x = species->particles->getPtrMomentum(0);
-    double* momentum_y = species->particles->getPtrMomentum(1);
-    double* momentum_z = species->particles->getPtrMomentum(2);
-    double* weight     = species->particles->getPtrWeight();
+    particle_real* position = species->particles->getPtrPosition(direction);
+    particle_real* momentum = species->particles->getPtrMomentum(direction);
+    particle_real* momentumRefl_2D = species->particles->getPtrMomentum((direction+1)%nDim);
+    particle_real* momentumRefl_3D = species->particles->getPtrMomentum((direction+2)%nDim);
+    particle_real* momentum_x = species->particles->getPtrMomentum(0);
+    particle_real* momentum_y = species->particles->getPtrMomentum(1);
+    particle_real* momentum_z = species->particles->getPtrMomentum(2);
+    particle_real* weight     = species->particles->getPtrWeight();
 
     energy_change = 0;
     for (int ipart=imin ; ipart<imax ; ipart++ ) {
@@ -84,13 +84,13 @@ PartBoundCond::PartBoundCond( Params &params, Species *species, Patch *patch )
     // Define the kind of applied boundary conditions
     // ----------------------------------------------
     
-    void ( *remove_inf )( Species*, int, int, int, double, double, std::vector<double>&, Random *rand, double& );
+    void ( *remove_inf )( Species*, int, int, int, double, double, dynamics_buffer<double>&, Random *rand, double& );
     if( species->mass_ == 0 ) {
         remove_inf = &remove_photon_inf;
     } else {
         remove_inf = &remove_particle_inf;
     }
-    void ( *remove_sup)( Species*, int, int, int, double, double, std::vector<double>&, Random *rand, double& );
+    void ( *remove_sup)( Species*, int, int, int, double, double, dynamics_buffer<double>&, Random *rand, double& );
     if( species->mass_ == 0 ) {
         remove_sup = &remove_photon_sup;
     } else {
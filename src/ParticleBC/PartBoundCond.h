@@ -5,6 +5,7 @@
 #include "Species.h"
 #include "Particles.h"
 #include "tabulatedFunctions.h"
+#include "DynamicsArena.h"
 
 class Patch;
 
@@ -21,22 +22,22 @@ public:
     
     //! Xmin particles boundary conditions pointers (same prototypes for all conditions)
     //! @see BoundaryConditionType.h for functions that this pointers will target
-    void ( *bc_xmin )( Species *species, int imin, int imax, int direction, double limit_inf, double dt, std::vector<double> &invgf, Random * rand, double &energy_change );
+    void ( *bc_xmin )( Species *species, int imin, int imax, int direction, double limit_inf, double dt, dynamics_buffer<double> &invgf, Random * rand, double &energy_change );
     //! Xmax particles boundary conditions pointers
-    void ( *bc_xmax )( Species *species, int imin, int imax, int direction, double limit_inf, double dt, std::vector<double> &invgf, Random * rand, double &energy_change );
+    void ( *bc_xmax )( Species *species, int imin, int imax, int direction, double limit_inf, double dt, dynamics_buffer<double> &invgf, Random * rand, double &energy_change );
     //! Ymin particles boundary conditions pointers
-    void ( *bc_ymin )( Species *species, int imin, int imax, int direction, double limit_inf, double dt, std::vector<double> &invgf, Random * rand, double &energy_change );
+    void ( *bc_ymin )( Species *species, int imin, int imax, int direction, double limit_inf, double dt, dynamics_buffer<double> &invgf, Random * rand, double &energy_change );
     //! Ymax particles boundary conditions pointers
-    void ( *bc_ymax )( Species *species, int imin, int imax, int direction, double limit_inf, double dt, std::vector<double> &invgf, Random * rand, double &energy_change );
+    void ( *bc_ymax )( Species *species, int imin, int imax, int direction, double limit_inf, double dt, dynamics_buffer<double> &invgf, Random * rand, double &energy_change );
     //! Zmin particles boundary conditions pointers
-    void ( *bc_zmin )( Species *species, int imin, int imax, int direction, double limit_inf, double dt, std::vector<double> &invgf, Random * rand, double &energy_change );
+    void ( *bc_zmin )( Species *species, int imin, int imax, int direction, double limit_inf, double dt, dynamics_buffer<double> &invgf, Random * rand, double &energy_change );
     //! Zmax particles boundary conditions pointers
-    void ( *bc_zmax )( Species *species, int imin, int imax, int direction, double limit_inf, double dt, std::vector<double> &invgf, Random * rand, double &energy_change );
+    void ( *bc_zmax )( Species *species, int imin, int imax, int direction, double limit_inf, double dt, dynamics_buffer<double> &invgf, Random * rand, double &energy_change );
 
     //! Method which applies particles boundary conditions.
     //! If the MPI process is not a border process, particles will be flagged as an exchange particle returning 0
     //! Conditions along X are applied first, then Y, then Z.
-    inline void apply( Species *species, int imin, int imax, std::vector<double> &invgf, Random *rand, double &energy_tot )
+    inline void apply( Species *species, int imin, int imax, dynamics_buffer<double> &invgf, Random *rand, double &energy_tot )
     {
         if( parameters_->isGPUParticleBinningAvailable() ) {
             // EMPTY because we need the keys NOT to be cleared for the gpu particle clustering/binning.
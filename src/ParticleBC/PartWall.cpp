@@ -36,7 +36,7 @@ PartWall::PartWall( double pos, unsigned short dir, string kind, double dt ) :
 }
 
 // Applies the wall's boundary condition to one particle
-void PartWall::apply( Species *species, int imin, int imax, std::vector<double> &invgf, Random * rand, double &energy_change )
+void PartWall::apply( Species *species, int imin, int imax, dynamics_buffer<double> &invgf, Random * rand, double &energy_change )
 {
     ( *wall )( species, imin, imax, direction, position, dt_, invgf, rand, energy_change );
 }
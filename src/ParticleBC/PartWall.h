@@ -4,6 +4,7 @@
 #include "Params.h"
 #include "Random.h"
 #include "tabulatedFunctions.h"
+#include "DynamicsArena.h"
 
 class Patch;
 class Species;
@@ -22,10 +23,10 @@ public:
     
     //! Wall boundary condition pointer (same prototypes for all conditions)
     //! @see BoundaryConditionType.h for functions that this pointer will target
-    void ( *wall )( Species *species, int imin, int imax, int direction, double limit_inf, double dt, std::vector<double> &invgf, Random * rand, double &energy_change );
+    void ( *wall )( Species *species, int imin, int imax, int direction, double limit_inf, double dt, dynamics_buffer<double> &invgf, Random * rand, double &energy_change );
     
     //! Method which applies particles wall
-    void apply( Species *species, int imin, int imax, std::vector<double> &invgf, Random * rand, double &energy_change );
+    void apply( Species *species, int imin, int imax, dynamics_buffer<double> &invgf, Random * rand, double &energy_change );
     
     double dt_;
 
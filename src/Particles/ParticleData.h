@@ -96,6 +96,10 @@ public:
     {
         return ( PyArrayObject * ) PyArray_SimpleNewFromData( 1, dims, NPY_DOUBLE, ( double * )( &vec[start] ) );
     };
+    inline PyArrayObject *vector2numpy( std::vector<float> &vec )
+    {
+        return ( PyArrayObject * ) PyArray_SimpleNewFromData( 1, dims, NPY_FLOAT, ( float * )( &vec[start] ) );
+    };
     inline PyArrayObject *vector2numpy( std::vector<uint64_t> &vec )
     {
         return ( PyArrayObject * ) PyArray_SimpleNewFromData( 1, dims, NPY_UINT64, ( uint64_t * )( &vec[start] ) );
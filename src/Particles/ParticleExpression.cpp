@@ -0,0 +1,574 @@
+#include "ParticleExpression.h"
+#include "Particles.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+
+using namespace std;
+
+// Functions of one argument, and their names in numpy
+enum { SQRT, EXP, LOG, LOG10, LOG2, EXPM1, LOG1P, SIN, COS, TAN, ARCSIN, ARCCOS, ARCTAN,
+    SINH, COSH, TANH, ABS, FLOOR, CEIL, SQUARE };
+static const vector<pair<string, int> > functions1 = {
+    {"sqrt", SQRT}, {"exp", EXP}, {"log", LOG}, {"log10", LOG10}, {"log2", LOG2}, {"expm1", EXPM1}, {"log1p", LOG1P},
+    {"sin", SIN}, {"cos", COS}, {"tan", TAN}, {"arcsin", ARCSIN}, {"arccos", ARCCOS}, {"arctan", ARCTAN},
+    {"sinh", SINH}, {"cosh", COSH}, {"tanh", TANH}, {"abs", ABS}, {"absolute", ABS}, {"fabs", ABS},
+    {"floor", FLOOR}, {"ceil", CEIL}, {"square", SQUARE}
+};
+
+// Functions of two arguments, and their names in numpy
+enum { ARCTAN2, HYPOT, MINIMUM, MAXIMUM, FMIN, FMAX };
+static const vector<pair<string, int> > functions2 = {
+    {"arctan2", ARCTAN2}, {"hypot", HYPOT}, {"minimum", MINIMUM}, {"maximum", MAXIMUM}, {"fmin", FMIN}, {"fmax", FMAX}
+};
+
+// Attributes of the particles, as named in ParticleData
+static const vector<string> attributes = {
+    "x", "y", "z", "px", "py", "pz", "weight", "charge", "chi",
+    "Ex", "Ey", "Ez", "Bx", "By", "Bz", "Wx", "Wy", "Wz"
+};
+
+// Python operators `%` and `//` on floats (same as numpy, the result has the sign of b)
+static inline double pyModulo( double a, double b )
+{
+    double mod = fmod( a, b );
+    if( b == 0. ) {
+        return mod;
+    }
+    if( mod != 0. ) {
+        if( ( b < 0. ) != ( mod < 0. ) ) {
+            mod += b;
+        }
+    } else {
+        mod = copysign( 0., b );
+    }
+    return mod;
+}
+static inline double pyFloorDivide( double a, double b )
+{
+    if( b == 0. ) {
+        return a / b;
+    }
+    double mod = fmod( a, b );
+    double div = ( a - mod ) / b;
+    if( mod != 0. && ( b < 0. ) != ( mod < 0. ) ) {
+        div -= 1.;
+    }
+    if( div == 0. ) {
+        return copysign( 0., a / b );
+    }
+    double floordiv = floor( div );
+    if( div - floordiv > 0.5 ) {
+        floordiv += 1.;
+    }
+    return floordiv;
+}
+
+template<typename F>
+static inline void unary( double *a, unsigned int n, F f )
+{
+    #pragma omp simd
+    for( unsigned int i = 0; i < n; i++ ) {
+        a[i] = f( a[i] );
+    }
+}
+
+template<typename F>
+static inline void binary( double *a, const double *b, bool immediate, double c, unsigned int n, F f )
+{
+    if( immediate ) {
+        #pragma omp simd
+        for( unsigned int i = 0; i < n; i++ ) {
+            a[i] = f( a[i], c );
+        }
+    } else {
+        #pragma omp simd
+        for( unsigned int i = 0; i < n; i++ ) {
+            a[i] = f( a[i], b[i] );
+        }
+    }
+}
+
+static bool tokenize( const string &s, vector<string> &tokens )
+{
+    static const vector<string> operators2 = {"**", "//", "<=", ">=", "==", "!="};
+    static const string operators1 = "+-*/%<>&|^~(),";
+    size_t i = 0;
+    while( i < s.size() ) {
+        size_t j = i;
+        if( isspace( s[i] ) ) {
+            i++;
+            continue;
+        } else if( isdigit( s[i] ) || ( s[i] == '.' && i+1 < s.size() && isdigit( s[i+1] ) ) ) {
+            while( j < s.size() && ( isdigit( s[j] ) || s[j] == '.' || s[j] == 'e' || s[j] == 'E'
+                || ( ( s[j] == '+' || s[j] == '-' ) && ( s[j-1] == 'e' || s[j-1] == 'E' ) ) ) ) {
+                j++;
+            }
+        } else if( isalpha( s[i] ) || s[i] == '_' ) {
+            while( j < s.size() && ( isalnum( s[j] ) || s[j] == '_' || s[j] == '.' ) ) {
+                j++;
+            }
+        } else if( find( operators2.begin(), operators2.end(), s.substr( i, 2 ) ) != operators2.end() ) {
+            j += 2;
+        } else if( operators1.find( s[i] ) != string::npos ) {
+            j++;
+        } else {
+            return false;
+        }
+        tokens.push_back( s.substr( i, j-i ) );
+        i = j;
+    }
+    return true;
+}
+
+const unsigned int ParticleExpression::block_;
+
+ParticleExpression::ParticleExpression( string expression, unsigned int nDim_particle, Particles *reference, bool boolean ) :
+    expression_( expression ),
+    depth_( 0 ),
+    itoken_( 0 ),
+    nDim_particle_( nDim_particle ),
+    reference_( reference )
+{
+    if( ! tokenize( expression, tokens_ ) ) {
+        error_ = "unexpected character";
+        return;
+    }
+    Type type = parseComparison();
+    if( type != INVALID && itoken_ < tokens_.size() ) {
+        type = fail( "unexpected `" + tokens_[itoken_] + "`" );
+    }
+    if( type == NUMBER && boolean ) {
+        fail( "the result is not a boolean" );
+    } else if( type == BOOLEAN && ! boolean ) {
+        fail( "the result is a boolean" );
+    }
+    tokens_.clear();
+    reference_ = NULL;
+    if( ! error_.empty() ) {
+        program_.clear();
+        return;
+    }
+
+    // Size of the stack
+    unsigned int size = 0;
+    for( const Instruction &instruction : program_ ) {
+        if( instruction.operation == CONSTANT || instruction.operation == ATTRIBUTE ) {
+            size++;
+        } else if( instruction.operation >= ADD && ! instruction.immediate ) {
+            size--;
+        }
+        depth_ = max( depth_, size );
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Compile the python function, translated into an expression by python
+// ---------------------------------------------------------------------------------------------------------------------
+ParticleExpression *ParticleExpression::create( PyObject *function, unsigned int nDim_particle, Particles *reference, bool boolean, string name )
+{
+    PyObject *translate = PyObject_GetAttrString( PyImport_AddModule( "__main__" ), "_particle_expression" );
+    PyObject *result = translate ? PyObject_CallFunctionObjArgs( translate, function, NULL ) : NULL;
+    PyTools::checkPyError();
+    Py_XDECREF( translate );
+    string expression = ( result && result != Py_None ) ? PyTools::repr( result ) : "";
+    Py_XDECREF( result );
+
+    if( expression.empty() ) {
+        MESSAGE( 2, name << " evaluated by python (not a simple expression)" );
+        return NULL;
+    }
+    ParticleExpression *compiled = new ParticleExpression( expression, nDim_particle, reference, boolean );
+    if( ! compiled->error_.empty() ) {
+        MESSAGE( 2, name << " evaluated by python (" << compiled->error_ << " in " << expression << ")" );
+        delete compiled;
+        return NULL;
+    }
+    MESSAGE( 2, name << " compiled as " << expression );
+    return compiled;
+}
+
+void ParticleExpression::evaluate( Particles *particles, unsigned int istart, unsigned int iend, double *result ) const
+{
+    vector<double> stack( depth_ * block_ );
+    for( unsigned int i = istart; i < iend; i += block_ ) {
+        unsigned int n = min( block_, iend - i );
+        run( particles, i, n, stack.data() );
+        copy( stack.begin(), stack.begin() + n, result + ( i - istart ) );
+    }
+}
+
+void ParticleExpression::select( Particles *particles, unsigned int istart, unsigned int iend, vector<unsigned int> &selection ) const
+{
+    vector<double> stack( depth_ * block_ );
+    for( unsigned int i = istart; i < iend; i += block_ ) {
+        unsigned int n = min( block_, iend - i );
+        run( particles, i, n, stack.data() );
+        for( unsigned int j = 0; j < n; j++ ) {
+            if( stack[j] != 0. ) {
+                selection.push_back( i + j );
+            }
+        }
+    }
+}
+
+void ParticleExpression::run( Particles *particles, unsigned int istart, unsigned int n, double *stack ) const
+{
+    unsigned int size = 0;
+    for( const Instruction &instruction : program_ ) {
+        double *a = stack + size * block_;
+        if( instruction.operation == CONSTANT ) {
+            fill( a, a + n, instruction.value );
+            size++;
+        } else if( instruction.operation == ATTRIBUTE ) {
+            const int k = instruction.index;
+            if( k == 7 ) {
+                const short *charge = &particles->Charge[istart];
+                for( unsigned int i = 0; i < n; i++ ) {
+                    a[i] = ( double ) charge[i];
+                }
+            } else {
+                // Attributes may be stored in single precision
+                const particle_real *attribute =
+                      k < 3 ? &particles->Position[k][istart]
+                    : k < 6 ? &particles->Momentum[k-3][istart]
+                    : k == 6 ? &particles->Weight[istart]
+                    : k == 8 ? &particles->Chi[istart]
+                    : &particles->interpolated_fields_->F_[k-9][istart];
+                for( unsigned int i = 0; i < n; i++ ) {
+                    a[i] = ( double ) attribute[i];
+                }
+            }
+            size++;
+        } else if( instruction.operation < ADD || instruction.immediate ) {
+            apply( instruction, a - block_, NULL, n );
+        } else {
+            apply( instruction, a - 2*block_, a - block_, n );
+            size--;
+        }
+    }
+}
+
+void ParticleExpression::apply( const Instruction &instruction, double *a, const double *b, unsigned int n )
+{
+    const bool im = instruction.immediate;
+    const double c = instruction.value;
+    switch( instruction.operation ) {
+        case NEGATIVE:      unary( a, n, []( double x ) { return -x; } ); break;
+        case NOT:           unary( a, n, []( double x ) { return 1. - x; } ); break;
+        case ADD:           binary( a, b, im, c, n, []( double x, double y ) { return x + y; } ); break;
+        case SUBTRACT:      binary( a, b, im, c, n, []( double x, double y ) { return x - y; } ); break;
+        case MULTIPLY:      binary( a, b, im, c, n, []( double x, double y ) { return x * y; } ); break;
+        case DIVIDE:        binary( a, b, im, c, n, []( double x, double y ) { return x / y; } ); break;
+        case FLOOR_DIVIDE:  binary( a, b, im, c, n, pyFloorDivide ); break;
+        case MODULO:        binary( a, b, im, c, n, pyModulo ); break;
+        case LESS:          binary( a, b, im, c, n, []( double x, double y ) { return ( double )( x < y ); } ); break;
+        case LESS_EQUAL:    binary( a, b, im, c, n, []( double x, double y ) { return ( double )( x <= y ); } ); break;
+        case GREATER:       binary( a, b, im, c, n, []( double x, double y ) { return ( double )( x > y ); } ); break;
+        case GREATER_EQUAL: binary( a, b, im, c, n, []( double x, double y ) { return ( double )( x >= y ); } ); break;
+        case EQUAL:         binary( a, b, im, c, n, []( double x, double y ) { return ( double )( x == y ); } ); break;
+        case NOT_EQUAL:     binary( a, b, im, c, n, []( double x, double y ) { return ( double )( x != y ); } ); break;
+        case AND:           binary( a, b, im, c, n, []( double x, double y ) { return ( double )( x != 0. && y != 0. ); } ); break;
+        case OR:            binary( a, b, im, c, n, []( double x, double y ) { return ( double )( x != 0. || y != 0. ); } ); break;
+        case XOR:           binary( a, b, im, c, n, []( double x, double y ) { return ( double )( ( x != 0. ) != ( y != 0. ) ); } ); break;
+        case POWER:
+            // Same shortcuts as numpy for usual exponents
+            if( im && c == 2. ) {
+                unary( a, n, []( double x ) { return x * x; } );
+            } else if( im && c == 0.5 ) {
+                unary( a, n, []( double x ) { return sqrt( x ); } );
+            } else if( im && c == -1. ) {
+                unary( a, n, []( double x ) { return 1. / x; } );
+            } else if( ! ( im && c == 1. ) ) {
+                binary( a, b, im, c, n, []( double x, double y ) { return pow( x, y ); } );
+            }
+            break;
+        case FUNCTION1:
+            switch( instruction.index ) {
+                case SQRT:   unary( a, n, []( double x ) { return sqrt( x ); } ); break;
+                case EXP:    unary( a, n, []( double x ) { return exp( x ); } ); break;
+                case LOG:    unary( a, n, []( double x ) { return log( x ); } ); break;
+                case LOG10:  unary( a, n, []( double x ) { return log10( x ); } ); break;
+                case LOG2:   unary( a, n, []( double x ) { return log2( x ); } ); break;
+                case EXPM1:  unary( a, n, []( double x ) { return expm1( x ); } ); break;
+                case LOG1P:  unary( a, n, []( double x ) { return log1p( x ); } ); break;
+                case SIN:    unary( a, n, []( double x ) { return sin( x ); } ); break;
+                case COS:    unary( a, n, []( double x ) { return cos( x ); } ); break;
+                case TAN:    unary( a, n, []( double x ) { return tan( x ); } ); break;
+                case ARCSIN: unary( a, n, []( double x ) { return asin( x ); } ); break;
+                case ARCCOS: unary( a, n, []( double x ) { return acos( x ); } ); break;
+                case ARCTAN: unary( a, n, []( double x ) { return atan( x ); } ); break;
+                case SINH:   unary( a, n, []( double x ) { return sinh( x ); } ); break;
+                case COSH:   unary( a, n, []( double x ) { return cosh( x ); } ); break;
+                case TANH:   unary( a, n, []( double x ) { return tanh( x ); } ); break;
+                case ABS:    unary( a, n, []( double x ) { return fabs( x ); } ); break;
+                case FLOOR:  unary( a, n, []( double x ) { return floor( x ); } ); break;
+                case CEIL:   unary( a, n, []( double x ) { return ceil( x ); } ); break;
+                case SQUARE: unary( a, n, []( double x ) { return x * x; } ); break;
+            }
+            break;
+        case FUNCTION2:
+            switch( instruction.index ) {
+                case ARCTAN2: binary( a, b, im, c, n, []( double x, double y ) { return atan2( x, y ); } ); break;
+                case HYPOT:   binary( a, b, im, c, n, []( double x, double y ) { return hypot( x, y ); } ); break;
+                case MINIMUM: binary( a, b, im, c, n, []( double x, double y ) { return ( x < y || x != x ) ? x : y; } ); break;
+                case MAXIMUM: binary( a, b, im, c, n, []( double x, double y ) { return ( x > y || x != x ) ? x : y; } ); break;
+                case FMIN:    binary( a, b, im, c, n, []( double x, double y ) { return fmin( x, y ); } ); break;
+                case FMAX:    binary( a, b, im, c, n, []( double x, double y ) { return fmax( x, y ); } ); break;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Parser: each function parses one level of precedence, appends the corresponding
+// instructions to the program, and returns the type of the result
+// ---------------------------------------------------------------------------------------------------------------------
+bool ParticleExpression::accept( string token )
+{
+    if( itoken_ < tokens_.size() && tokens_[itoken_] == token ) {
+        itoken_++;
+        return true;
+    }
+    return false;
+}
+
+ParticleExpression::Type ParticleExpression::fail( string message )
+{
+    if( error_.empty() ) {
+        error_ = message;
+    }
+    return INVALID;
+}
+
+ParticleExpression::Type ParticleExpression::parseComparison()
+{
+    static const vector<pair<string, Operation> > comparisons = {
+        {"<", LESS}, {"<=", LESS_EQUAL}, {">", GREATER}, {">=", GREATER_EQUAL}, {"==", EQUAL}, {"!=", NOT_EQUAL}
+    };
+    Type a = parseOr();
+    for( auto &comparison : comparisons ) {
+        if( accept( comparison.first ) ) {
+            Type result = emit( comparison.second, a, parseOr() );
+            for( auto &other : comparisons ) {
+                if( accept( other.first ) ) {
+                    return fail( "chained comparison" );
+                }
+            }
+            return result;
+        }
+    }
+    return a;
+}
+
+ParticleExpression::Type ParticleExpression::parseOr()
+{
+    Type a = parseXor();
+    while( accept( "|" ) ) {
+        a = emit( OR, a, parseXor() );
+    }
+    return a;
+}
+
+ParticleExpression::Type ParticleExpression::parseXor()
+{
+    Type a = parseAnd();
+    while( accept( "^" ) ) {
+        a = emit( XOR, a, parseAnd() );
+    }
+    return a;
+}
+
+ParticleExpression::Type ParticleExpression::parseAnd()
+{
+    Type a = parseSum();
+    while( accept( "&" ) ) {
+        a = emit( AND, a, parseSum() );
+    }
+    return a;
+}
+
+ParticleExpression::Type ParticleExpression::parseSum()
+{
+    Type a = parseProduct();
+    while( true ) {
+        if( accept( "+" ) ) {
+            a = emit( ADD, a, parseProduct() );
+        } else if( accept( "-" ) ) {
+            a = emit( SUBTRACT, a, parseProduct() );
+        } else {
+            return a;
+        }
+    }
+}
+
+ParticleExpression::Type ParticleExpression::parseProduct()
+{
+    Type a = parseUnary();
+    while( true ) {
+        if( accept( "*" ) ) {
+            a = emit( MULTIPLY, a, parseUnary() );
+        } else if( accept( "/" ) ) {
+            a = emit( DIVIDE, a, parseUnary() );
+        } else if( accept( "//" ) ) {
+            a = emit( FLOOR_DIVIDE, a, parseUnary() );
+        } else if( accept( "%" ) ) {
+            a = emit( MODULO, a, parseUnary() );
+        } else {
+            return a;
+        }
+    }
+}
+
+ParticleExpression::Type ParticleExpression::parseUnary()
+{
+    if( accept( "-" ) ) {
+        return emit( NEGATIVE, parseUnary(), INVALID );
+    } else if( accept( "+" ) ) {
+        Type a = parseUnary();
+        return a == BOOLEAN ? fail( "unary + on a boolean" ) : a;
+    } else if( accept( "~" ) ) {
+        return emit( NOT, parseUnary(), INVALID );
+    }
+    return parsePower();
+}
+
+ParticleExpression::Type ParticleExpression::parsePower()
+{
+    Type a = parseAtom();
+    if( accept( "**" ) ) {
+        return emit( POWER, a, parseUnary() );
+    }
+    return a;
+}
+
+ParticleExpression::Type ParticleExpression::parseAtom()
+{
+    if( itoken_ >= tokens_.size() ) {
+        return fail( "unexpected end" );
+    }
+    string token = tokens_[itoken_++];
+
+    // Parentheses
+    if( token == "(" ) {
+        Type a = parseComparison();
+        return accept( ")" ) ? a : fail( "missing `)`" );
+    }
+
+    // Numbers and constants
+    Instruction constant = { CONSTANT, 0, 0., false };
+    Type type = NUMBER;
+    if( isdigit( token[0] ) || token[0] == '.' ) {
+        char *end;
+        constant.value = strtod( token.c_str(), &end );
+        if( *end != '\0' ) {
+            return fail( "wrong number `" + token + "`" );
+        }
+    } else if( token == "True" || token == "False" ) {
+        constant.value = token == "True" ? 1. : 0.;
+        type = BOOLEAN;
+    } else if( token == "numpy.pi" || token == "math.pi" ) {
+        constant.value = M_PI;
+    } else if( token == "numpy.e" || token == "math.e" ) {
+        constant.value = M_E;
+
+    // Particle attributes
+    } else if( token.substr( 0, 2 ) == "p." ) {
+        string name = token.substr( 2 );
+        size_t k = find( attributes.begin(), attributes.end(), name ) - attributes.begin();
+        bool available =
+              k < 3 ? k < nDim_particle_
+            : k == 8 ? reference_->has_quantum_parameter
+            : k > 8 && k < attributes.size() ? reference_->interpolated_fields_ && reference_->interpolated_fields_->mode_[k-9] > 0
+            : k < attributes.size();
+        if( ! available ) {
+            return fail( "attribute `" + name + "` not available" );
+        }
+        program_.push_back( { ATTRIBUTE, ( int ) k, 0., false } );
+        return NUMBER;
+
+    // Functions
+    } else if( itoken_ < tokens_.size() && tokens_[itoken_] == "(" && ( token.substr( 0, 6 ) == "numpy." || token == "abs" ) ) {
+        itoken_++;
+        string name = token == "abs" ? token : token.substr( 6 );
+        vector<Type> args;
+        if( ! accept( ")" ) ) {
+            do {
+                args.push_back( parseComparison() );
+            } while( accept( "," ) );
+            if( ! accept( ")" ) ) {
+                return fail( "missing `)`" );
+            }
+        }
+        for( auto &f : functions1 ) {
+            if( f.first == name && args.size() == 1 ) {
+                return emit( FUNCTION1, args[0], INVALID, f.second );
+            }
+        }
+        for( auto &f : functions2 ) {
+            if( f.first == name && args.size() == 2 ) {
+                return emit( FUNCTION2, args[0], args[1], f.second );
+            }
+        }
+        if( name == "power" && args.size() == 2 ) {
+            return emit( POWER, args[0], args[1] );
+        }
+        return fail( "unknown function `" + token + "`" );
+    } else {
+        return fail( "unknown name `" + token + "`" );
+    }
+    program_.push_back( constant );
+    return type;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Check the types of the operands, append the operation and fold the constants
+// ---------------------------------------------------------------------------------------------------------------------
+ParticleExpression::Type ParticleExpression::emit( Operation operation, Type a, Type b, int index )
+{
+    const bool is_binary = operation >= ADD;
+    if( a == INVALID || ( is_binary && b == INVALID ) ) {
+        return INVALID;
+    }
+
+    // Types follow numpy, except for the operations that numpy would treat as integers
+    Type type = NUMBER;
+    const bool booleans = a == BOOLEAN && ( ! is_binary || b == BOOLEAN );
+    if( operation == NEGATIVE && booleans ) {
+        return fail( "negative of a boolean" );
+    } else if( operation == SUBTRACT && booleans ) {
+        return fail( "subtraction of booleans" );
+    } else if( operation == ADD && booleans ) {
+        operation = OR;
+        type = BOOLEAN;
+    } else if( operation == MULTIPLY && booleans ) {
+        operation = AND;
+        type = BOOLEAN;
+    } else if( operation == NOT || operation == AND || operation == OR || operation == XOR ) {
+        if( ! booleans ) {
+            return fail( "bitwise operation on numbers" );
+        }
+        type = BOOLEAN;
+    } else if( operation >= LESS ) {
+        type = BOOLEAN;
+    }
+
+    Instruction instruction = { operation, index, 0., false };
+    // A constant second operand becomes part of the instruction
+    if( is_binary && program_.back().operation == CONSTANT ) {
+        instruction.immediate = true;
+        instruction.value = program_.back().value;
+        program_.pop_back();
+    }
+    // If the (first) operand is also constant, the result is constant
+    if( ( ! is_binary || instruction.immediate ) && program_.back().operation == CONSTANT ) {
+        apply( instruction, &program_.back().value, NULL, 1 );
+        return type;
+    }
+    program_.push_back( instruction );
+    return type;
+}
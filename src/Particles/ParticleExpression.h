@@ -0,0 +1,90 @@
+#ifndef PARTICLEEXPRESSION_H
+#define PARTICLEEXPRESSION_H
+
+#include "PyTools.h"
+
+#include <string>
+#include <vector>
+
+class Particles;
+
+//! Native evaluation of a simple expression of the particle attributes, e.g. `((p.px > 0.1) & (p.x < 10.0))`.
+//! The expressions are a restricted subset of the python syntax: numbers, particle attributes,
+//! arithmetic operators, comparisons, `&`, `|`, `^` and `~` between booleans, and a few numpy functions.
+//! They are compiled once into a stack program that is applied to blocks of particles.
+//! Booleans are stored as 0. or 1.
+class ParticleExpression
+{
+public:
+    //! Compile an expression of the attributes available in `reference` (positions up to nDim_particle).
+    //! `boolean` tells whether the result must be a boolean (filter) or a number (rate).
+    //! On failure, `error_` contains the reason.
+    ParticleExpression( std::string expression, unsigned int nDim_particle, Particles *reference, bool boolean );
+
+    //! Try to compile a python function of the particles (see _particle_expression in pycontrol.py).
+    //! Returns NULL when the function must be evaluated by python.
+    static ParticleExpression *create( PyObject *function, unsigned int nDim_particle, Particles *reference, bool boolean, std::string name );
+
+    //! Compute the expression for the particles istart to iend-1 (thread-safe)
+    void evaluate( Particles *particles, unsigned int istart, unsigned int iend, double *result ) const;
+
+    //! Append the indices of the particles istart to iend-1 for which the expression is true (thread-safe)
+    void select( Particles *particles, unsigned int istart, unsigned int iend, std::vector<unsigned int> &selection ) const;
+
+    //! Text of the expression
+    std::string expression_;
+
+    //! Reason why the expression could not be compiled (empty if compiled)
+    std::string error_;
+
+private:
+
+    //! Number of particles treated at once
+    static const unsigned int block_ = 256;
+
+    enum Operation { CONSTANT, ATTRIBUTE, NEGATIVE, NOT, FUNCTION1,
+        ADD, SUBTRACT, MULTIPLY, DIVIDE, FLOOR_DIVIDE, MODULO, POWER, FUNCTION2,
+        LESS, LESS_EQUAL, GREATER, GREATER_EQUAL, EQUAL, NOT_EQUAL, AND, OR, XOR };
+    enum Type { INVALID, NUMBER, BOOLEAN };
+
+    //! One step of the stack program. Binary operations with `immediate` take their
+    //! second operand from `value` instead of the stack.
+    struct Instruction {
+        Operation operation;
+        int index; // attribute or function index
+        double value;
+        bool immediate;
+    };
+
+    //! Program in reverse polish notation
+    std::vector<Instruction> program_;
+
+    //! Maximum depth of the stack
+    unsigned int depth_;
+
+    //! Compute the expression for n <= block_ particles in the first row of `stack`
+    void run( Particles *particles, unsigned int istart, unsigned int n, double *stack ) const;
+
+    //! Apply one operation to arrays a (and b) of size n
+    static void apply( const Instruction &instruction, double *a, const double *b, unsigned int n );
+
+    // Recursive descent parser, following the python operator precedence
+    std::vector<std::string> tokens_;
+    size_t itoken_;
+    unsigned int nDim_particle_;
+    Particles *reference_;
+    Type parseComparison();
+    Type parseOr();
+    Type parseXor();
+    Type parseAnd();
+    Type parseSum();
+    Type parseProduct();
+    Type parseUnary();
+    Type parsePower();
+    Type parseAtom();
+    Type emit( Operation operation, Type a, Type b, int index = 0 );
+    Type fail( std::string message );
+    bool accept( std::string token );
+};
+
+#endif
@@ -296,7 +296,7 @@ void Particles::resizeCellKeys(unsigned int nParticles)
 void Particles::shrinkToFit(const bool compute_cell_keys)
 {
     for( unsigned int iprop=0 ; iprop<double_prop_.size() ; iprop++ ) {
-        std::vector<double>( *double_prop_[iprop] ).swap( *double_prop_[iprop] );
+        std::vector<particle_real>( *double_prop_[iprop] ).swap( *double_prop_[iprop] );
     }
 
     for( unsigned int iprop=0 ; iprop<short_prop_.size() ; iprop++ ) {
@@ -1353,10 +1353,89 @@ void Particles::copyLeavingParticlesToBuffer( Particles* )
     ERROR( "Device only feature, should not have come here!" );
 }
 
+void Particles::copyLeavingParticlesToAllBuffers( const vector<double> &min_local, const vector<double> &max_local,
+                                                  const vector<Particles*> &buffer )
+{
+    const unsigned int ndim = min_local.size();
+
+    for( size_t ipart = 0; ipart < size(); ipart++ ) {
+        if( cell_keys[ipart] < -1 ) {
+            // The dimension encoded in the cell key is the first one crossed by the particle;
+            // the other ones are found from the position, as in Patch::cornersParticles
+            int direction = -cell_keys[ipart] - 2;
+            unsigned int k = 0, stride = 1;
+            for( unsigned int idim = 0; idim < ndim; idim++ ) {
+                unsigned int side = 1;
+                if( ( int )idim == direction/2 ) {
+                    side = 2*( direction%2 );
+                } else if( Position[idim][ipart] < min_local[idim] ) {
+                    side = 0;
+                } else if( Position[idim][ipart] >= max_local[idim] ) {
+                    side = 2;
+                }
+                k += side * stride;
+                stride *= 3;
+            }
+            if( buffer[k] ) {
+                copyParticle( ipart, *buffer[k] );
+            }
+        }
+    }
+}
+
+size_t Particles::packedSize( unsigned int nPart ) const
+{
+    return nPart * ( double_prop_.size()*sizeof( particle_real )
+                     + short_prop_.size()*sizeof( short )
+                     + uint64_prop_.size()*sizeof( uint64_t ) );
+}
+
+char *Particles::packParticles( char *buffer ) const
+{
+    const size_t npart = size();
+    if( npart == 0 ) {
+        return buffer;
+    }
+
+    for( unsigned int iprop=0 ; iprop<double_prop_.size() ; iprop++ ) {
+        memcpy( buffer, double_prop_[iprop]->data(), npart*sizeof( particle_real ) );
+        buffer += npart*sizeof( particle_real );
+    }
+    for( unsigned int iprop=0 ; iprop<short_prop_.size() ; iprop++ ) {
+        memcpy( buffer, short_prop_[iprop]->data(), npart*sizeof( short ) );
+        buffer += npart*sizeof( short );
+    }
+    for( unsigned int iprop=0 ; iprop<uint64_prop_.size() ; iprop++ ) {
+        memcpy( buffer, uint64_prop_[iprop]->data(), npart*sizeof( uint64_t ) );
+        buffer += npart*sizeof( uint64_t );
+    }
+    return buffer;
+}
+
+const char *Particles::unpackParticles( const char *buffer, unsigned int nPart )
+{
+    const size_t offset = size();
+    resize( offset + nPart );
+
+    for( unsigned int iprop=0 ; iprop<double_prop_.size() ; iprop++ ) {
+        memcpy( double_prop_[iprop]->data() + offset, buffer, nPart*sizeof( particle_real ) );
+        buffer += nPart*sizeof( particle_real );
+    }
+    for( unsigned int iprop=0 ; iprop<short_prop_.size() ; iprop++ ) {
+        memcpy( short_prop_[iprop]->data() + offset, buffer, nPart*sizeof( short ) );
+        buffer += nPart*sizeof( short );
+    }
+    for( unsigned int iprop=0 ; iprop<uint64_prop_.size() ; iprop++ ) {
+        memcpy( uint64_prop_[iprop]->data() + offset, buffer, nPart*sizeof( uint64_t ) );
+        buffer += nPart*sizeof( uint64_t );
+    }
+    return buffer;
+}
+
 
 void Particles::savePositions() {
     unsigned int ndim = Position.size(), npart = size();
-    double *p[3], *pold[3];
+    particle_real *p[3], *pold[3];
     for( unsigned int i = 0 ; i<ndim ; i++ ) {
         p[i] =  &( Position[i][0] );
         pold[i] =  &( Position_old[i][0] );
@@ -1462,9 +1541,9 @@ void Particles::copyInterpolatedFields( double *Ebuffer, double *Bbuffer, vector
             if( i < 6 ) { // E or B fields
                 copy( buffers[i], buffers[i] + n,  &( interpolated_fields_->F_[i][start] ) );
             } else { // work Wx, Wy or Wz (accumulated over time)
-                double *px = Momentum[0].data(), *py = Momentum[1].data(), *pz = Momentum[2].data();
+                particle_real *px = Momentum[0].data(), *py = Momentum[1].data(), *pz = Momentum[2].data();
                 double *px_old = pold[0].data(), *py_old = pold[1].data(), *pz_old = pold[2].data();
-                double * p = Momentum[i-6].data();
+                particle_real * p = Momentum[i-6].data();
                 double * p_old = pold[i-6].data();
                 for( size_t ip = 0; ip < n; ip++ ) {
                     const double g = sqrt( 1.0 + px[ip]*px[ip] + py[ip]*py[ip] + pz[ip]*pz[ip] );
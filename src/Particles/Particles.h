@@ -28,6 +28,7 @@
 
 #include "Tools.h"
 #include "TimeSelection.h"
+#include "particle_real.h"
 
 class Particle;
 
@@ -38,7 +39,7 @@ struct InterpolatedFields {
     //! Tells the way each interpolated field is treated: 0 = not kept, 1 = kept, 2 = accumulated
     std::vector<int> mode_;
     //! arrays of fields interpolated on the particle positions. The order is Ex, Ey, Ez, Bx, By, Bz, Wx, Wy, Wz
-    std::vector<std::vector<double>> F_;
+    std::vector<std::vector<particle_real>> F_;
 };
 
 
@@ -225,12 +226,12 @@ public:
     bool isParticleInDomain( unsigned int ipart, Patch *patch );
 
     //! Method used to get the Particle position
-    inline double  position( unsigned int idim, unsigned int ipart ) const
+    inline particle_real  position( unsigned int idim, unsigned int ipart ) const
     {
         return Position[idim][ipart];
     }
     //! Method used to set a new value to the Particle former position
-    inline double &position( unsigned int idim, unsigned int ipart )
+    inline particle_real &position( unsigned int idim, unsigned int ipart )
     {
         return Position[idim][ipart];
     }
@@ -242,50 +243,50 @@ public:
     }
 
     //! Method used to get the Particle position
-    inline double  position_old( unsigned int idim, unsigned int ipart ) const
+    inline particle_real  position_old( unsigned int idim, unsigned int ipart ) const
     {
         return Position_old[idim][ipart];
     }
     //! Method used to set a new value to the Particle former position
-    inline double &position_old( unsigned int idim, unsigned int ipart )
+    inline particle_real &position_old( unsigned int idim, unsigned int ipart )
     {
         return Position_old[idim][ipart];
     }
 
     //! Method used to get the list of Particle position
-    inline std::vector<double>  position( unsigned int idim ) const
+    inline std::vector<particle_real>  position( unsigned int idim ) const
     {
         return Position[idim];
     }
 
     //! Method used to get the Particle momentum
-    inline double  momentum( unsigned int idim, unsigned int ipart ) const
+    inline particle_real  momentum( unsigned int idim, unsigned int ipart ) const
     {
         return Momentum[idim][ipart];
     }
     //! Method used to set a new value to the Particle momentum
-    inline double &momentum( unsigned int idim, unsigned int ipart )
+    inline particle_real &momentum( unsigned int idim, unsigned int ipart )
     {
         return Momentum[idim][ipart];
     }
     //! Method used to get the Particle momentum
-    inline std::vector<double>  momentum( unsigned int idim ) const
+    inline std::vector<particle_real>  momentum( unsigned int idim ) const
     {
         return Momentum[idim];
     }
 
     //! Method used to get the Particle weight
-    inline double  weight( unsigned int ipart ) const
+    inline particle_real  weight( unsigned int ipart ) const
     {
         return Weight[ipart];
     }
     //! Method used to set a new value to the Particle weight
-    inline double &weight( unsigned int ipart )
+    inline particle_real &weight( unsigned int ipart )
     {
         return Weight[ipart];
     }
     //! Method used to get the Particle weight
-    inline std::vector<double>  weight() const
+    inline std::vector<particle_real>  weight() const
     {
         return Weight;
     }
@@ -352,34 +353,34 @@ public:
     void sortById();
 
     //! Method used to get the Particle chi factor
-    inline double  chi( unsigned int ipart ) const
+    inline particle_real  chi( unsigned int ipart ) const
     {
         return Chi[ipart];
     }
     //! Method used to set a new value to the Particle chi factor
-    inline double &chi( unsigned int ipart )
+    inline particle_real &chi( unsigned int ipart )
     {
         return Chi[ipart];
     }
     //! Method used to get the Particle chi factor
-    inline std::vector<double>  chi() const
+    inline std::vector<particle_real>  chi() const
     {
         return Chi;
     }
 
     //! Method used to get the Particle optical depth
-    inline double  tau( unsigned int ipart ) const
+    inline particle_real  tau( unsigned int ipart ) const
     {
         return Tau[ipart];
     }
     //! Method used to set a new value to
     //! the Particle optical depth
-    inline double &tau( unsigned int ipart )
+    inline particle_real &tau( unsigned int ipart )
     {
         return Tau[ipart];
     }
     //! Method used to get the Particle optical depth
-    inline std::vector<double>  tau() const
+    inline std::vector<particle_real>  tau() const
     {
         return Tau;
     }
@@ -387,7 +388,8 @@ public:
     //! Method to keep the positions for the next timesteps
     void savePositions();
 
-    std::vector< std::vector<double  >*> double_prop_;
+    //! Floating-point properties, stored as particle_real (see particle_real.h)
+    std::vector< std::vector<particle_real>*> double_prop_;
     std::vector< std::vector<short   >*> short_prop_;
     std::vector< std::vector<uint64_t>*> uint64_prop_;
 
@@ -424,7 +426,7 @@ public:
     {
         prop = short_prop_[iprop];
     }
-    void getProperty( size_t iprop, std::vector<double> *&prop )
+    void getProperty( size_t iprop, std::vector<particle_real> *&prop )
     {
         prop = double_prop_[iprop];
     }
@@ -438,21 +440,21 @@ public:
     virtual void copyFromDeviceToHost( bool copy_keys = false );
 
     //! Return the pointer toward the Position[idim] vector
-    virtual double* getPtrPosition( int idim ) {
+    virtual particle_real* getPtrPosition( int idim ) {
         return ((std::size_t)idim < Position.size()) ? Position[idim].data() : nullptr;
     };
     //! Return the pointer toward the Position_old[idim] vector
-    virtual double* getPtrPositionOld( int idim ) {
+    virtual particle_real* getPtrPositionOld( int idim ) {
         return ((std::size_t)idim < Position_old.size()) ? Position_old[idim].data() : nullptr;
     };
     //! Return the pointer toward the Momentum[idim] vector
-    virtual double* getPtrMomentum( int idim ) {
+    virtual particle_real* getPtrMomentum( int idim ) {
         return ((std::size_t)idim < Momentum.size()) ? Momentum[idim].data() : nullptr;
     };
-    virtual double* getPtrWeight() {
+    virtual particle_real* getPtrWeight() {
         return &(Weight[0]);
     };
-    virtual double* getPtrChi() {
+    virtual particle_real* getPtrChi() {
         return (has_quantum_parameter ? Chi.data() : nullptr);
     };
     virtual short* getPtrCharge() {
@@ -461,7 +463,7 @@ public:
     virtual uint64_t* getPtrId() {
         return &(Id[0]);
     };
-    virtual double* getPtrTau() {
+    virtual particle_real* getPtrTau() {
         return (has_Monte_Carlo_process ? Tau.data() : nullptr);
     };
     virtual int* getPtrCellKeys() {
@@ -478,6 +480,22 @@ public:
     void copyLeavingParticlesToBuffers( const std::vector<bool> copy, const std::vector<Particles*> buffer );
     virtual void copyLeavingParticlesToBuffer( Particles* buffer );
 
+    // -----------------------------------------------------------------------------
+    //! Extract particles leaving the box to the buffers of all the surrounding patches
+    //! (faces, edges and corners, indexed as Patch::all_neighbor_), the destination
+    //! being found from the particle position. Null buffers are skipped.
+    // -----------------------------------------------------------------------------
+    void copyLeavingParticlesToAllBuffers( const std::vector<double> &min_local, const std::vector<double> &max_local,
+                                           const std::vector<Particles*> &buffer );
+
+    //! Number of bytes used by nPart particles in packParticles
+    size_t packedSize( unsigned int nPart ) const;
+    //! Copy all the particles to a raw buffer of packedSize( size() ) bytes, property by property,
+    //! return the end of the data written
+    char *packParticles( char *buffer ) const;
+    //! Append nPart particles read from a raw buffer filled by packParticles, return the end of the data read
+    const char *unpackParticles( const char *buffer, unsigned int nPart );
+
     // -----------------------------------------------------------------------------
     //! Erase particles leaving the patch object on device
     // -----------------------------------------------------------------------------
@@ -516,22 +534,22 @@ public:
     // partiles properties, respect type order : all double, all short, all unsigned int
 
     //! array of particle positions
-    std::vector< std::vector<double> > Position;
+    std::vector< std::vector<particle_real> > Position;
 
     //! array of particle former (old) positions
-    std::vector< std::vector<double> >Position_old;
+    std::vector< std::vector<particle_real> >Position_old;
 
     //! array of particle momenta
-    std::vector< std::vector<double> >  Momentum;
+    std::vector< std::vector<particle_real> >  Momentum;
 
     //! array of particle weights: equivalent to a density normalized to the number of macro-particles per cell
-    std::vector<double> Weight;
+    std::vector<particle_real> Weight;
 
     //! array of particle quantum parameters
-    std::vector<double> Chi;
+    std::vector<particle_real> Chi;
 
     //! array of optical depths for the Monte-Carlo process
-    std::vector<double> Tau;
+    std::vector<particle_real> Tau;
 
     //! array of particle charges
     std::vector<short> Charge;
@@ -526,7 +526,7 @@ namespace detail {
                                                          const Patch&     a_parent_patch )
     {
         const auto first = thrust::make_zip_iterator( thrust::make_tuple( particle_container.getPtrCellKeys(),
-                                                                          static_cast<const double*>( particle_container.getPtrPosition( 0 ) ) ) );
+                                                                          static_cast<const particle_real*>( particle_container.getPtrPosition( 0 ) ) ) );
         const auto last  = first + particle_container.deviceSize();
         int CellStartingGlobalIndex_for_x = a_parent_patch.getCellStartingGlobalIndex_noGC(0);
         doComputeParticleClusterKey( first, last,
@@ -542,8 +542,8 @@ namespace detail {
                                                          const Patch&     a_parent_patch )
     {
         const auto first = thrust::make_zip_iterator( thrust::make_tuple( particle_container.getPtrCellKeys(),
-                                                                          static_cast<const double*>( particle_container.getPtrPosition( 0 ) ),
-                                                                          static_cast<const double*>( particle_container.getPtrPosition( 1 ) ) ) );
+                                                                          static_cast<const particle_real*>( particle_container.getPtrPosition( 0 ) ),
+                                                                          static_cast<const particle_real*>( particle_container.getPtrPosition( 1 ) ) ) );
         const auto last  = first + particle_container.deviceSize();
         int CellStartingGlobalIndex_for_x = a_parent_patch.getCellStartingGlobalIndex_noGC(0);
         int CellStartingGlobalIndex_for_y = a_parent_patch.getCellStartingGlobalIndex_noGC(1);
@@ -563,9 +563,9 @@ namespace detail {
                                                          const Patch&     a_parent_patch )
     {
         const auto first = thrust::make_zip_iterator( thrust::make_tuple( particle_container.getPtrCellKeys(),
-                                                                          static_cast<const double*>( particle_container.getPtrPosition( 0 ) ),
-                                                                          static_cast<const double*>( particle_container.getPtrPosition( 1 ) ),
-                                                                          static_cast<const double*>( particle_container.getPtrPosition( 2 ) ) ) );
+                                                                          static_cast<const particle_real*>( particle_container.getPtrPosition( 0 ) ),
+                                                                          static_cast<const particle_real*>( particle_container.getPtrPosition( 1 ) ),
+                                                                          static_cast<const particle_real*>( particle_container.getPtrPosition( 2 ) ) ) );
         const auto last  = first + particle_container.deviceSize();
         int CellStartingGlobalIndex_for_x = a_parent_patch.getCellStartingGlobalIndex_noGC(0);
         int CellStartingGlobalIndex_for_y = a_parent_patch.getCellStartingGlobalIndex_noGC(1);
@@ -632,7 +632,7 @@ void nvidiaParticles::deviceReserve( unsigned int particle_count, float growth_f
 void nvidiaParticles::deviceFree()
 {
     for( auto prop: nvidia_double_prop_ ) {
-        thrust::device_vector<double>().swap( *prop );
+        thrust::device_vector<particle_real>().swap( *prop );
     }
 
     for( auto prop: nvidia_short_prop_ ) {
@@ -1045,7 +1045,7 @@ void nvidiaParticles::sortParticleByKey()
     thrust::sort_by_key( thrust::device, nvidia_cell_keys_.begin(), nvidia_cell_keys_.end(), index.begin() );
     
     // Sort particles using thrust::gather, according to the sorting map
-    thrust::device_vector<double> buffer( gpu_nparts_ );
+    thrust::device_vector<particle_real> buffer( gpu_nparts_ );
     for( auto prop: nvidia_double_prop_ ) {
         thrust::gather( thrust::device, index.begin(), index.end(), prop->begin(), buffer.begin() );
         prop->swap( buffer );
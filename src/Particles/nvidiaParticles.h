@@ -74,22 +74,22 @@ public:
         return gpu_nparts_;
     }
 
-    double* getPtrPosition( int idim ) override {
+    particle_real* getPtrPosition( int idim ) override {
         return thrust::raw_pointer_cast( nvidia_position_[idim].data() );
     };
-    double* getPtrMomentum( int idim ) override {
+    particle_real* getPtrMomentum( int idim ) override {
         return thrust::raw_pointer_cast( nvidia_momentum_[idim].data() );
     };
-    double* getPtrWeight() override {
+    particle_real* getPtrWeight() override {
         return thrust::raw_pointer_cast( nvidia_weight_.data() );
     };
     short * getPtrCharge() override {
         return thrust::raw_pointer_cast( nvidia_charge_.data() );
     };
-    double * getPtrChi() override {
+    particle_real* getPtrChi() override {
         return thrust::raw_pointer_cast( nvidia_chi_.data() );
     };
-    double * getPtrTau() override {
+    particle_real* getPtrTau() override {
         return thrust::raw_pointer_cast( nvidia_tau_.data() );
     };
     int * getPtrCellKeys() override {
@@ -199,13 +199,13 @@ protected:
     void naiveImportAndSortParticles( nvidiaParticles* particles_to_inject );
 
     //! Position vector on device
-    std::vector<thrust::device_vector<double>> nvidia_position_;
+    std::vector<thrust::device_vector<particle_real>> nvidia_position_;
 
     //! Momentum vector on device
-    std::vector<thrust::device_vector<double>> nvidia_momentum_;
+    std::vector<thrust::device_vector<particle_real>> nvidia_momentum_;
 
     //! Weight
-    thrust::device_vector<double> nvidia_weight_;
+    thrust::device_vector<particle_real> nvidia_weight_;
 
     //! Charge on GPU
     thrust::device_vector<short> nvidia_charge_;
@@ -214,16 +214,16 @@ protected:
     thrust::device_vector<int> nvidia_cell_keys_;
 
     //! Quantum parameter
-    thrust::device_vector<double> nvidia_chi_;
+    thrust::device_vector<particle_real> nvidia_chi_;
 
     //! Monte-Carlo parameter
-    thrust::device_vector<double> nvidia_tau_;
+    thrust::device_vector<particle_real> nvidia_tau_;
 
     //! Particle IDs
     thrust::device_vector<uint64_t> nvidia_id_;
 
     //! List of double* arrays
-    std::vector<thrust::device_vector<double>*> nvidia_double_prop_;
+    std::vector<thrust::device_vector<particle_real>*> nvidia_double_prop_;
 
     //! List of short* arrays
     std::vector<thrust::device_vector<short>*> nvidia_short_prop_;
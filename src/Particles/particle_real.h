@@ -0,0 +1,30 @@
+#ifndef PARTICLE_REAL_H
+#define PARTICLE_REAL_H
+
+// -----------------------------------------------------------------------------
+//! Floating-point type used to store the particle properties:
+//! positions, old positions, momenta, weights, quantum parameter (chi),
+//! optical depth (tau) and the fields interpolated at the particle positions.
+//!
+//! It is selected at compile time (make config=particle_single_precision)
+//! so that all the particle kernels (pushers, interpolators, projectors, ...)
+//! are compiled for this type, without any runtime conversion of the arrays.
+//! Reductions (energies, diagnostics) keep accumulating in double precision.
+// -----------------------------------------------------------------------------
+
+#ifdef SMILEI_PARTICLE_SINGLE_PRECISION
+
+typedef float particle_real;
+
+//! MPI datatype matching particle_real
+#define SMILEI_MPI_PARTICLE_REAL MPI_FLOAT
+
+#else
+
+typedef double particle_real;
+
+#define SMILEI_MPI_PARTICLE_REAL MPI_DOUBLE
+
+#endif
+
+#endif
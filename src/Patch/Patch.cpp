@@ -48,7 +48,8 @@ Patch::Patch( Params &params, SmileiMPI *, DomainDecomposition *domain_decomposi
     nDim_fields_ = params.nDim_field;
     
     if( ( dynamic_cast<HilbertDomainDecomposition *>( domain_decomposition ) )
-        || ( dynamic_cast<LinearizedDomainDecomposition *>( domain_decomposition ) ) ) {
+        || ( dynamic_cast<LinearizedDomainDecomposition *>( domain_decomposition ) )
+        || ( dynamic_cast<RCBDomainDecomposition *>( domain_decomposition ) ) ) {
         size_ = params.patch_size_;
         oversize = params.oversize;
     }
@@ -63,6 +64,7 @@ Patch::Patch( Params &params, SmileiMPI *, DomainDecomposition *domain_decomposi
     
     initStep1( params );
     
+    dynamics_time_ = -1.;
     
 
 #ifdef  __DETAILED_TIMERS
@@ -75,6 +77,9 @@ Patch::Patch( Params &params, SmileiMPI *, DomainDecomposition *domain_decomposi
 
     patch_timers_.resize( 15 * number_of_threads_, 0. );
     patch_tmp_timers_.resize( 15 * number_of_threads_, 0. );
+    measured_load_ = 0.;
+    measured_iterations_ = 0;
+    smoothed_load_ = -1.;
 #endif
 
 } // END Patch::Patch
@@ -94,6 +99,8 @@ Patch::Patch( Patch *patch, Params &params, SmileiMPI *, unsigned int ipatch )
     
     initStep1( params );
 
+    dynamics_time_ = -1.;
+
 #ifdef  __DETAILED_TIMERS
 
 #ifdef _OPENMP
@@ -105,6 +112,9 @@ Patch::Patch( Patch *patch, Params &params, SmileiMPI *, unsigned int ipatch )
     // Initialize timers
     patch_timers_.resize( 15 * number_of_threads_, 0. );
     patch_tmp_timers_.resize( 15 * number_of_threads_, 0. );
+    measured_load_ = 0.;
+    measured_iterations_ = 0;
+    smoothed_load_ = -1.;
 #endif
 
 }
@@ -124,6 +134,7 @@ void Patch::initStep1( Params &params )
         MPI_neighbor_[iDim].resize( 2, MPI_PROC_NULL );
         tmp_MPI_neighbor_[iDim].resize( 2, MPI_PROC_NULL );
     }
+    all_neighbor_hindex_ = -1;
     
     // Initialize the random number generator
     rand_ = new Random( params.random_seed + hindex );
@@ -510,6 +521,11 @@ void Patch::updateMPIenv( SmileiMPI *smpi )
 //            }
         }
 
+    // Surrounding patches of the direct particle exchange
+    for( unsigned int k=0 ; k<all_neighbor_.size() ; k++ ) {
+        all_MPI_neighbor_[k] = smpi->hrank( all_neighbor_[k] );
+    }
+
 } // END updateMPIenv
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -800,6 +816,136 @@ void Patch::cornersParticles( int ispec, Params &params, int iDim )
     } //loop i Neighbor
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Compute the Hilbert index and MPI rank of the 3^nDim surrounding patches (faces, edges and corners)
+//   The moving window changes the hindex of the patches: only recompute when it changed
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::updateAllNeighbors( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition )
+{
+    if( all_neighbor_hindex_ == ( int )hindex ) {
+        return;
+    }
+    all_neighbor_hindex_ = hindex;
+
+    unsigned int ndim = params.nDim_field;
+    unsigned int n_all = 1;
+    for( unsigned int iDim = 0; iDim < ndim; iDim++ ) {
+        n_all *= 3;
+    }
+    all_neighbor_.resize( n_all );
+    all_MPI_neighbor_.resize( n_all );
+
+    std::vector<int> xcall( ndim );
+    for( unsigned int k = 0; k < n_all; k++ ) {
+        bool outside = false;
+        for( unsigned int iDim = 0, stride = 1; iDim < ndim; iDim++, stride *= 3 ) {
+            xcall[iDim] = ( int )Pcoordinates[iDim] + ( int )( ( k/stride )%3 ) - 1;
+            if( params.EM_BCs[iDim][0]=="periodic" ) {
+                if( xcall[iDim] < 0 ) {
+                    xcall[iDim] += domain_decomposition->ndomain_[iDim];
+                } else if( xcall[iDim] >= ( int )domain_decomposition->ndomain_[iDim] ) {
+                    xcall[iDim] -= domain_decomposition->ndomain_[iDim];
+                }
+            }
+            if( xcall[iDim] < 0 || xcall[iDim] >= ( int )domain_decomposition->ndomain_[iDim] ) {
+                outside = true;
+            }
+        }
+        if( outside ) {
+            all_neighbor_[k] = MPI_PROC_NULL;
+        } else {
+            all_neighbor_[k] = domain_decomposition->getDomainId( xcall );
+        }
+        all_MPI_neighbor_[k] = smpi->hrank( all_neighbor_[k] );
+    }
+} // END updateAllNeighbors
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Copy the leaving particles to the buffers of all the surrounding patches, in a single pass
+//   Particles crossing a periodic boundary are wrapped, as in prepareParticles
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::copyExchParticlesToAllBuffers( int ispec, Params &params, SmileiMPI *smpi )
+{
+    SpeciesMPIbuffers &buffer = vecSpecies[ispec]->MPI_buffer_;
+    Particles &part = *vecSpecies[ispec]->particles;
+    unsigned int ndim = params.nDim_field;
+
+    cleanMPIBuffers( ispec, params );
+
+    // Only the buffers towards existing patches are filled
+    vector<Particles*> sendBuffer( buffer.partSendAll.size(), nullptr );
+    for( unsigned int k = 0; k < buffer.partSendAll.size(); k++ ) {
+        if( buffer.partSendAll[k] ) {
+            buffer.partSendAll[k]->clear();
+            if( all_neighbor_[k] != MPI_PROC_NULL ) {
+                sendBuffer[k] = buffer.partSendAll[k];
+            }
+        }
+    }
+
+    part.copyLeavingParticlesToAllBuffers( min_local_, max_local_, sendBuffer );
+
+    // Enabled periodicity
+    for( unsigned int k = 0; k < sendBuffer.size(); k++ ) {
+        if( ! sendBuffer[k] || sendBuffer[k]->size() == 0 ) {
+            continue;
+        }
+        Particles &partSend = *sendBuffer[k];
+        for( unsigned int iDim = 0, stride = 1; iDim < ndim; iDim++, stride *= 3 ) {
+            unsigned int side = ( k/stride )%3;
+            if( smpi->periods_[iDim]!=1 || side == 1 ) {
+                continue;
+            }
+            double x_max = params.cell_length[iDim]*( params.global_size_[iDim] );
+            if( side == 0 && Pcoordinates[iDim] == 0 ) {
+                for( size_t iPart=0; iPart < partSend.size(); iPart++ ) {
+                    if( partSend.position( iDim, iPart ) < 0. ) {
+                        partSend.position( iDim, iPart ) += x_max;
+                    }
+                }
+            }
+            if( side == 2 && Pcoordinates[iDim] == params.number_of_patches[iDim]-1 ) {
+                for( size_t iPart=0; iPart < partSend.size(); iPart++ ) {
+                    if( partSend.position( iDim, iPart ) >= x_max ) {
+                        partSend.position( iDim, iPart ) -= x_max;
+                    }
+                }
+            }
+        }
+    }
+
+} // END copyExchParticlesToAllBuffers
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Append the particles sent by the surrounding patches of the same MPI process to the receive buffers
+//   The particles from other MPI processes have already been unpacked by SmileiMPI::recvDirectParticles
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::importParticlesFromLocalNeighbors( int ispec, Params &, VectorPatch *vecPatch )
+{
+    SpeciesMPIbuffers &buffer = vecSpecies[ispec]->MPI_buffer_;
+    unsigned int n_all = all_neighbor_.size();
+
+    for( unsigned int k = 0; k < n_all; k++ ) {
+        if( k == n_all/2 || all_neighbor_[k] == MPI_PROC_NULL || all_MPI_neighbor_[k] != MPI_me_ ) {
+            continue;
+        }
+        // The neighbour at offset k sent its particles with the opposite offset
+        unsigned int k_sent = n_all-1-k;
+        Particles &partSent = *( *vecPatch )( all_neighbor_[k] - vecPatch->refHindex_ )->vecSpecies[ispec]->MPI_buffer_.partSendAll[k_sent];
+        if( partSent.size() == 0 ) {
+            continue;
+        }
+        unsigned int iDim, iNeighbor;
+        directRecvBuffer( k_sent, iDim, iNeighbor );
+        Particles &partRecv = *buffer.partRecv[iDim][iNeighbor];
+        partSent.copyParticles( 0, partSent.size(), partRecv, partRecv.size() );
+    }
+
+} // END importParticlesFromLocalNeighbors
+
+
 //! Import particles exchanged with surrounding patches/mpi and sort at the same time
 void Patch::importAndSortParticles( int ispec, Params &params )
 {
@@ -832,6 +978,12 @@ void Patch::cleanParticlesOverhead( Params &params )
                 buffer.partSend[idim][iNeighbor]->shrinkToFit( );
             }
         }
+        for( unsigned int k = 0; k < buffer.partSendAll.size(); k++ ) {
+            if( buffer.partSendAll[k] ) {
+                buffer.partSendAll[k]->clear();
+                buffer.partSendAll[k]->shrinkToFit( );
+            }
+        }
         
         vecSpecies[ispec]->particles->shrinkToFit(  );
     }
@@ -41,6 +41,7 @@ class Patch
     friend class SimWindow;
     friend class SyncVectorPatch;
     friend class AsyncMPIbuffers;
+    friend class AggregatedFieldMPIbuffers;
 public:
     //! Constructor for Patch
     Patch( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch );
@@ -120,6 +121,10 @@ public:
     // 12 - Push Pos
     // 13 - Sorting
 
+    //! Time of the particle operations of the patch at the last iteration, negative if not measured
+    //! (Main.patch_scheduling = "cost")
+    double dynamics_time_;
+
 #ifdef  __DETAILED_TIMERS
 
     // OpenMP properties
@@ -136,6 +141,13 @@ public:
     //! temporary timers
     std::vector<double> patch_tmp_timers_;
 
+    //! Time measured by the detailed timers since the last load balancing, and number of iterations
+    //! it covers (LoadBalancing.load_model="measured")
+    double measured_load_;
+    unsigned int measured_iterations_;
+    //! Exponential moving average of the measured time per iteration, negative before the first measure
+    double smoothed_load_;
+
 #endif
 
 #ifdef __DETAILED_TIMERS
@@ -187,6 +199,23 @@ public:
     void waitExchParticles( int ispec, int iDim );
     //! Treat diagonalParticles
     void cornersParticles( int ispec, Params &params, int iDim );
+    //! Compute all_neighbor_ and all_MPI_neighbor_, if the patch moved since the last call (direct exchange)
+    void updateAllNeighbors( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition );
+    //! Copy the leaving particles to the buffers of all the surrounding patches (direct exchange)
+    void copyExchParticlesToAllBuffers( int ispec, Params &params, SmileiMPI *smpi );
+    //! Get the particles sent by the surrounding patches of the same MPI process (direct exchange)
+    void importParticlesFromLocalNeighbors( int ispec, Params &params, VectorPatch *vecPatch );
+    //! Receive buffer partRecv[iDim][iNeighbor] of the particles sent to the neighbour all_neighbor_[k]:
+    //! iDim is the first dimension crossed, as in the exchange per dimension
+    static inline void directRecvBuffer( unsigned int k, unsigned int &iDim, unsigned int &iNeighbor )
+    {
+        iDim = 0;
+        while( k%3 == 1 ) {
+            k /= 3;
+            iDim++;
+        }
+        iNeighbor = ( k%3 == 2 ) ? 0 : 1;
+    }
     //! inject particles received in main data structure and particles sorting
     void importAndSortParticles( int ispec, Params &params );
     //! clean memory resizing particles structure
@@ -468,6 +497,14 @@ protected:
     //! MPI rank of neighbors patch
     std::vector< std::vector<int> > MPI_neighbor_, tmp_MPI_neighbor_;
     
+    //! Hilbert index of the 3^nDim surrounding patches (faces, edges and corners), the offset (ix,iy,iz)
+    //! being stored at (ix+1) + 3*(iy+1) + 9*(iz+1). Only computed for the direct particle exchange
+    std::vector<int> all_neighbor_;
+    //! MPI rank of the patches in all_neighbor_
+    std::vector<int> all_MPI_neighbor_;
+    //! hindex of the patch when all_neighbor_ was computed
+    int all_neighbor_hindex_;
+    
     //! "Real" min limit of local sub-subdomain (ghost data not concerned)
     //!     - "0." on rank 0
     std::vector<double> min_local_;
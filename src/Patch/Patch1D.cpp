@@ -18,9 +18,10 @@ using namespace std;
 Patch1D::Patch1D( Params &params, SmileiMPI *smpi, DomainDecomposition *domain_decomposition, unsigned int ipatch, unsigned int n_moved )
     : Patch( params, smpi, domain_decomposition, ipatch )
 {
-    // Test if the patch is a particle patch (Hilbert or Linearized are for VectorPatch)
+    // Test if the patch is a particle patch (Hilbert, Linearized or RCB are for VectorPatch)
     if( ( dynamic_cast<HilbertDomainDecomposition *>( domain_decomposition ) )
-        || ( dynamic_cast<LinearizedDomainDecomposition *>( domain_decomposition ) ) ) {
+        || ( dynamic_cast<LinearizedDomainDecomposition *>( domain_decomposition ) )
+        || ( dynamic_cast<RCBDomainDecomposition *>( domain_decomposition ) ) ) {
         initStep2( params, domain_decomposition );
         initStep3( params, smpi, n_moved );
         finishCreation( params, smpi, domain_decomposition );
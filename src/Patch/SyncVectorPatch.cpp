@@ -26,6 +26,11 @@ template void SyncVectorPatch::exchangeAlongAllDirectionsNoOMP<complex<double>,c
 
 void SyncVectorPatch::initExchParticles( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi )
 {
+    if( params.direct_particle_exchange ) {
+        SyncVectorPatch::initExchParticlesDirect( vecPatches, ispec, params, smpi );
+        return;
+    }
+
     #pragma omp for schedule(runtime)
     for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
         vecPatches( ipatch )->copyExchParticlesToBuffers( ispec, params );
@@ -43,6 +48,11 @@ void SyncVectorPatch::initExchParticles( VectorPatch &vecPatches, int ispec, Par
 // ---------------------------------------------------------------------------------------------------------------------
 void SyncVectorPatch::finalizeExchParticlesAndSort( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi )
 {
+    if( params.direct_particle_exchange ) {
+        SyncVectorPatch::finalizeExchParticlesDirect( vecPatches, ispec, params, smpi );
+        return;
+    }
+
     // finish exchange along dimension 0 only
     SyncVectorPatch::finalizeExchParticlesAlongDimension( vecPatches, ispec, 0, params, smpi );
     
@@ -90,6 +100,39 @@ void SyncVectorPatch::finalizeExchParticlesAndSort( VectorPatch &vecPatches, int
 
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+//! Direct exchange (Main.particle_exchange="direct"): each leaving particle is copied to the buffer of the
+//! face, edge or corner neighbour containing it, then all the particles towards a given MPI process are sent
+//! in a single message
+// ---------------------------------------------------------------------------------------------------------------------
+void SyncVectorPatch::initExchParticlesDirect( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi )
+{
+    #pragma omp for schedule(runtime)
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        vecPatches( ipatch )->updateAllNeighbors( params, smpi, vecPatches.domain_decomposition_ );
+        vecPatches( ipatch )->copyExchParticlesToAllBuffers( ispec, params, smpi );
+    }
+
+    #pragma omp single
+    smpi->isendDirectParticles( vecPatches, ispec );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Direct exchange: receive the particles from the other MPI processes, get those of the local neighbours,
+//! then import and sort them. No corner particles are left to forward.
+// ---------------------------------------------------------------------------------------------------------------------
+void SyncVectorPatch::finalizeExchParticlesDirect( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi )
+{
+    #pragma omp single
+    smpi->recvDirectParticles( vecPatches, ispec );
+
+    #pragma omp for schedule(runtime)
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        vecPatches( ipatch )->importParticlesFromLocalNeighbors( ispec, params, &vecPatches );
+        vecPatches( ipatch )->importAndSortParticles( ispec, params );
+    }
+}
+
 void SyncVectorPatch::initExchParticlesAlongDimension( VectorPatch &vecPatches, int ispec, int iDim, Params &params, SmileiMPI *smpi )
 {
     // Exchange numbers of particles in direction 0 only
@@ -150,10 +193,10 @@ void SyncVectorPatch::finalizeExchParticlesAlongDimension( VectorPatch &vecPatch
 // ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 
-void SyncVectorPatch::sumRhoJ( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi )
+void SyncVectorPatch::sumRhoJ( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi, bool defer_currents )
 {
     // Sum Jx, Jy and Jz
-    SyncVectorPatch::sumAllComponents( vecPatches.densities, vecPatches, smpi );
+    SyncVectorPatch::sumAllComponents( vecPatches.densities, vecPatches, smpi, defer_currents );
     // Sum rho
     if( ( vecPatches.diag_flag ) || ( params.is_spectral ) ) {
         SyncVectorPatch::sum<double,Field>( vecPatches.listrho_, vecPatches, smpi );
@@ -231,7 +274,9 @@ void SyncVectorPatch::sumRhoJs( Params &, VectorPatch &vecPatches, int imode, Sm
 //         - densitiesLocalx : fields which have local neighbor along X (a same field can be adressed by both)
 //         - ... for Y and Z
 //     - These fields are identified with lists of index MPIxIdx and LocalxIdx (... for Y and Z)
-void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatch &vecPatches, SmileiMPI *smpi )
+//     - if defer_last_dimension, the MPI sums along the last dimension are left in flight,
+//       they are completed by finalizeSumAllComponents
+void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatch &vecPatches, SmileiMPI *smpi, bool defer_last_dimension )
 {
     unsigned int h0, oversize[3], size[3];
     double *pt1, *pt2;
@@ -249,6 +294,9 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
 
     int nDim = vecPatches( 0 )->EMfields->Jx_->dims_.size();
 
+    // Main.field_exchange="aggregated": one message per neighbouring MPI process, held by the first field
+    const bool aggregated = smpi->aggregatedFieldExchange();
+
     // -----------------
     // Sum per direction :
 
@@ -283,10 +331,22 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
 // #endif
             }
         }
+        if( aggregated )
+            continue;
         vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIx[ifield             ], 0, smpi, true ); // Jx
         vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIx[ifield+  nPatchMPIx], 0, smpi, true ); // Jy
         vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0, smpi, true ); // Jz
     }
+    if( aggregated ) {
+        #pragma omp single
+        {
+            std::vector<Patch *> patches( nPatchMPIx );
+            for( unsigned int i=0 ; i<nPatchMPIx ; i++ ) {
+                patches[i] = vecPatches( vecPatches.MPIxIdx[i] );
+            }
+            fields[0]->aggregatedMPIbuff.init( vecPatches.densitiesMPIx, patches, 0, 3+0, smpi );
+        }
+    }
 
     // iDim = 0, local
     const int nFieldLocalx = vecPatches.densitiesLocalx.size() / 3;
@@ -346,6 +406,13 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
     }
 
     // iDim = 0, finalize (waitall)
+    if( defer_last_dimension && nDim==1 ) {
+        return;
+    }
+    if( aggregated ) {
+        #pragma omp single
+        fields[0]->aggregatedMPIbuff.finalize( 3+0 );
+    }
 #ifndef _NO_MPI_TM
     #pragma omp for schedule(static)
 #else
@@ -353,9 +420,11 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
 #endif
     for( unsigned int ifield=0 ; ifield<nPatchMPIx ; ifield++ ) {
         unsigned int ipatch = vecPatches.MPIxIdx[ifield];
-        vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIx[ifield             ], 0 ); // Jx
-        vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIx[ifield+nPatchMPIx  ], 0 ); // Jy
-        vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0 ); // Jz
+        if( ! aggregated ) {
+            vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIx[ifield             ], 0 ); // Jx
+            vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIx[ifield+nPatchMPIx  ], 0 ); // Jy
+            vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0 ); // Jz
+        }
         for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
             if ( vecPatches( ipatch )->is_a_MPI_neighbor( 0, ( iNeighbor+1 )%2 ) ) {
 // #ifdef SMILEI_ACCELERATOR_GPU_OACC
@@ -416,10 +485,22 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
 // #endif
                 }
             }
+            if( aggregated )
+                continue;
             vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIy[ifield             ], 1, smpi, true ); // Jx
             vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1, smpi, true ); // Jy
             vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1, smpi, true ); // Jz
         }
+        if( aggregated ) {
+            #pragma omp single
+            {
+                std::vector<Patch *> patches( nPatchMPIy );
+                for( unsigned int i=0 ; i<nPatchMPIy ; i++ ) {
+                    patches[i] = vecPatches( vecPatches.MPIyIdx[i] );
+                }
+                fields[0]->aggregatedMPIbuff.init( vecPatches.densitiesMPIy, patches, 1, 3+1, smpi );
+            }
+        }
 
         // iDim = 1,
         const int nFieldLocaly = vecPatches.densitiesLocaly.size() / 3;
@@ -484,6 +565,13 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
         }
 
         // iDim = 1, finalize (waitall)
+        if( defer_last_dimension && nDim==2 ) {
+            return;
+        }
+        if( aggregated ) {
+            #pragma omp single
+            fields[0]->aggregatedMPIbuff.finalize( 3+1 );
+        }
 #ifndef _NO_MPI_TM
         #pragma omp for schedule(static)
 #else
@@ -491,9 +579,11 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
 #endif
         for( unsigned int ifield=0 ; ifield<nPatchMPIy ; ifield=ifield+1 ) {
             unsigned int ipatch = vecPatches.MPIyIdx[ifield];
-            vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIy[ifield             ], 1 ); // Jx
-            vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1 ); // Jy
-            vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1 ); // Jz
+            if( ! aggregated ) {
+                vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIy[ifield             ], 1 ); // Jx
+                vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1 ); // Jy
+                vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1 ); // Jz
+            }
             for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
                 if ( vecPatches( ipatch )->is_a_MPI_neighbor( 1, ( iNeighbor+1 )%2 ) ) {
 // #ifdef SMILEI_ACCELERATOR_GPU_OACC
@@ -552,10 +642,22 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
 // #endif
                     }
                 }
+                if( aggregated )
+                    continue;
                 vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIz[ifield             ], 2, smpi, true ); // Jx
                 vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2, smpi, true ); // Jy
                 vecPatches( ipatch )->initSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2, smpi, true ); // Jz
             }
+            if( aggregated ) {
+                #pragma omp single
+                {
+                    std::vector<Patch *> patches( nPatchMPIz );
+                    for( unsigned int i=0 ; i<nPatchMPIz ; i++ ) {
+                        patches[i] = vecPatches( vecPatches.MPIzIdx[i] );
+                    }
+                    fields[0]->aggregatedMPIbuff.init( vecPatches.densitiesMPIz, patches, 2, 3+2, smpi );
+                }
+            }
 
             // iDim = 2 local
             const int nFieldLocalz = vecPatches.densitiesLocalz.size() / 3;
@@ -618,6 +720,13 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
             }
 
             // iDim = 2, complete non local sync through MPIfinalize (waitall)
+            if( defer_last_dimension ) {
+                return;
+            }
+            if( aggregated ) {
+                #pragma omp single
+                fields[0]->aggregatedMPIbuff.finalize( 3+2 );
+            }
 #ifndef _NO_MPI_TM
             #pragma omp for schedule(static)
 #else
@@ -625,9 +734,11 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
 #endif
             for( unsigned int ifield=0 ; ifield<nPatchMPIz ; ifield=ifield+1 ) {
                 unsigned int ipatch = vecPatches.MPIzIdx[ifield];
-                vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIz[ifield             ], 2 ); // Jx
-                vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2 ); // Jy
-                vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2 ); // Jz
+                if( ! aggregated ) {
+                    vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIz[ifield             ], 2 ); // Jx
+                    vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2 ); // Jy
+                    vecPatches( ipatch )->finalizeSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2 ); // Jz
+                }
                 for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
                     if ( vecPatches( ipatch )->is_a_MPI_neighbor( 2, ( iNeighbor+1 )%2 ) ) {
 // #ifdef SMILEI_ACCELERATOR_GPU_OACC
@@ -658,6 +769,54 @@ void SyncVectorPatch::sumAllComponents( std::vector<Field *> &fields, VectorPatc
 }
 
 
+// Complete the MPI sums along the last dimension left in flight by sumAllComponents( ..., defer_last_dimension=true )
+void SyncVectorPatch::finalizeSumAllComponents( std::vector<Field *> &fields, VectorPatch &vecPatches )
+{
+    int nDim = vecPatches( 0 )->EMfields->Jx_->dims_.size();
+    int iDim = nDim-1;
+    unsigned int oversize = vecPatches( 0 )->EMfields->oversize[iDim];
+
+    std::vector<Field *> *densitiesMPI;
+    std::vector<int> *MPIIdx;
+    if( iDim == 0 ) {
+        densitiesMPI = &vecPatches.densitiesMPIx;
+        MPIIdx       = &vecPatches.MPIxIdx;
+    } else if( iDim == 1 ) {
+        densitiesMPI = &vecPatches.densitiesMPIy;
+        MPIIdx       = &vecPatches.MPIyIdx;
+    } else {
+        densitiesMPI = &vecPatches.densitiesMPIz;
+        MPIIdx       = &vecPatches.MPIzIdx;
+    }
+    unsigned int nPatchMPI = MPIIdx->size();
+
+    const bool aggregated = fields[0]->aggregatedMPIbuff.active( 3+iDim );
+    if( aggregated ) {
+        #pragma omp single
+        fields[0]->aggregatedMPIbuff.finalize( 3+iDim );
+    }
+#ifndef _NO_MPI_TM
+    #pragma omp for schedule(static)
+#else
+    #pragma omp single
+#endif
+    for( unsigned int ifield=0 ; ifield<nPatchMPI ; ifield++ ) {
+        unsigned int ipatch = ( *MPIIdx )[ifield];
+        if( ! aggregated ) {
+            vecPatches( ipatch )->finalizeSumField( ( *densitiesMPI )[ifield            ], iDim ); // Jx
+            vecPatches( ipatch )->finalizeSumField( ( *densitiesMPI )[ifield+nPatchMPI  ], iDim ); // Jy
+            vecPatches( ipatch )->finalizeSumField( ( *densitiesMPI )[ifield+2*nPatchMPI], iDim ); // Jz
+        }
+        for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+            if( vecPatches( ipatch )->is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
+                ( *densitiesMPI )[ifield            ]->inject_fields_sum( iDim, iNeighbor, oversize );
+                ( *densitiesMPI )[ifield+nPatchMPI  ]->inject_fields_sum( iDim, iNeighbor, oversize );
+                ( *densitiesMPI )[ifield+2*nPatchMPI]->inject_fields_sum( iDim, iNeighbor, oversize );
+            }
+        }
+    }
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 // ----------------------------------------------         FIELDS          ----------------------------------------------
@@ -729,6 +888,29 @@ void SyncVectorPatch::exchangeB( Params &params, VectorPatch &vecPatches, Smilei
     }
 }
 
+// exchangeB in two steps, to overlap the MPI exchange along X with the update of the other patches
+// (solvers which exchange B per component, i.e. not full_B_exchange) :
+//     - exchangeBBorders   : once the patches which have an MPI neighbor along X are updated
+//     - completeExchangeB  : once all patches are updated
+void SyncVectorPatch::exchangeBBorders( Params &, VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    SyncVectorPatch::initExchangeAllComponentsAlongX( vecPatches, smpi );
+}
+
+void SyncVectorPatch::completeExchangeB( Params &, VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    // Exchange Bs0 : By_ and Bz_ (dual in X)
+    SyncVectorPatch::exchangeLocalAllComponentsAlongX( vecPatches.Bs0, vecPatches );
+    if( vecPatches.listBx_[0]->dims_.size()>1 ) {
+        // Exchange Bs1 : Bx_ and Bz_ (dual in Y)
+        SyncVectorPatch::exchangeAllComponentsAlongY( vecPatches.Bs1, vecPatches, smpi );
+        if( vecPatches.listBx_[0]->dims_.size()>2 ) {
+            // Exchange Bs2 : Bx_ and By_ (dual in Z)
+            SyncVectorPatch::exchangeAllComponentsAlongZ( vecPatches.Bs2, vecPatches, smpi );
+        }
+    }
+}
+
 void SyncVectorPatch::finalizeexchangeB( Params &params, VectorPatch &vecPatches )
 {
     // full_B_exchange is true if (Buneman BC, Lehe, Bouchard or spectral solvers)
@@ -1020,6 +1202,8 @@ void SyncVectorPatch::exchangeAlongAllDirections( std::vector<Field *> fields, V
     oversize[1] = vecPatches( 0 )->EMfields->oversize[1];
     oversize[2] = vecPatches( 0 )->EMfields->oversize[2];
 
+    const bool aggregated = smpi->aggregatedFieldExchange();
+
     for( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ ) {
 #ifndef _NO_MPI_TM
         #pragma omp for schedule(static)
@@ -1033,11 +1217,18 @@ void SyncVectorPatch::exchangeAlongAllDirections( std::vector<Field *> fields, V
                     fields[ipatch]->extract_fields_exch( iDim, iNeighbor, oversize[iDim] );
                 }
             }
+            if( aggregated )
+                continue;
             if ( !dynamic_cast<cField*>( fields[ipatch] ) )
                 vecPatches( ipatch )->initExchange       ( fields[ipatch], iDim, smpi );
             else
                 vecPatches( ipatch )->initExchangeComplex( fields[ipatch], iDim, smpi );
         }
+        // One message per neighbouring MPI process, held by the first field of the list
+        if( aggregated ) {
+            #pragma omp single
+            fields[0]->aggregatedMPIbuff.init( fields, vecPatches.patches_, iDim, iDim, smpi );
+        }
     } // End for iDim
 
     unsigned int nx_, ny_( 1 ), nz_( 1 ), h0, size[3], gsp[3];
@@ -1119,13 +1310,20 @@ void SyncVectorPatch::finalizeExchangeAlongAllDirections( std::vector<Field *> f
     oversize[2] = vecPatches( 0 )->EMfields->oversize[2];
 
     for( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ ) {
+        const bool aggregated = fields[0]->aggregatedMPIbuff.active( iDim );
+        if( aggregated ) {
+            #pragma omp single
+            fields[0]->aggregatedMPIbuff.finalize( iDim );
+        }
 #ifndef _NO_MPI_TM
         #pragma omp for schedule(static)
 #else
         #pragma omp single
 #endif
         for( unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++ ) {
-            vecPatches( ipatch )->finalizeExchange( fields[ipatch], iDim );
+            if( ! aggregated ) {
+                vecPatches( ipatch )->finalizeExchange( fields[ipatch], iDim );
+            }
 
             for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
                 if ( vecPatches( ipatch )->is_a_MPI_neighbor( iDim, ( iNeighbor+1 )%2 ) ) {
@@ -1470,6 +1668,13 @@ void SyncVectorPatch::exchangeSynchronizedPerDirection( std::vector<Field *> fie
 //         - B_Localx : fields which have local neighbor along X (a same field can be adressed by both)
 //     - These fields are identified with lists of index MPIxIdx and LocalxIdx
 void SyncVectorPatch::exchangeAllComponentsAlongX( std::vector<Field *> &fields, VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    SyncVectorPatch::initExchangeAllComponentsAlongX( vecPatches, smpi );
+    SyncVectorPatch::exchangeLocalAllComponentsAlongX( fields, vecPatches );
+}
+
+// Post the MPI part of exchangeAllComponentsAlongX : only reads the patches which have an MPI neighbor along X
+void SyncVectorPatch::initExchangeAllComponentsAlongX( VectorPatch &vecPatches, SmileiMPI *smpi )
 {
     unsigned oversize = vecPatches( 0 )->EMfields->oversize[0];
 
@@ -1501,6 +1706,12 @@ void SyncVectorPatch::exchangeAllComponentsAlongX( std::vector<Field *> &fields,
         vecPatches( ipatch )->initExchange( vecPatches.B_MPIx[ifield      ], 0, smpi, true ); // By
         vecPatches( ipatch )->initExchange( vecPatches.B_MPIx[ifield+nMPIx], 0, smpi, true ); // Bz
     }
+}
+
+// Local part of exchangeAllComponentsAlongX : copies between patches of the same MPI process
+void SyncVectorPatch::exchangeLocalAllComponentsAlongX( std::vector<Field *> &fields, VectorPatch &vecPatches )
+{
+    unsigned oversize = vecPatches( 0 )->EMfields->oversize[0];
 
     unsigned int h0, size;
     double *pt1, *pt2;
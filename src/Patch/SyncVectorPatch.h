@@ -19,11 +19,13 @@ public :
     //! Particles synchronization
     static void initExchParticles( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi );
     static void finalizeExchParticlesAndSort( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi );
+    static void initExchParticlesDirect( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi );
+    static void finalizeExchParticlesDirect( VectorPatch &vecPatches, int ispec, Params &params, SmileiMPI *smpi );
     static void initExchParticlesAlongDimension( VectorPatch &vecPatches, int ispec, int iDim, Params &params, SmileiMPI *smpi );
     static void finalizeExchParticlesAlongDimension( VectorPatch &vecPatches, int ispec, int iDim, Params &params, SmileiMPI *smpi );
 
     //! Densities synchronization
-    static void sumRhoJ( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi );
+    static void sumRhoJ( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi, bool defer_currents=false );
     //! Densities synchronization per mode
     static void sumRhoJ( Params &params, VectorPatch &vecPatches, int imode, SmileiMPI *smpi );
     //! Densities synchronization per species
@@ -58,6 +60,9 @@ public :
 
         unsigned int nComp = fields.size()/nPatches;
 
+        // Main.field_exchange="aggregated": one message per neighbouring MPI process, held by the first field
+        const bool aggregated = smpi->aggregatedFieldExchange();
+
         // -----------------
         // Sum per direction :
 
@@ -79,11 +84,17 @@ public :
 // #endif
                 }
             }
+            if( aggregated )
+                continue;
             if ( !dynamic_cast<cField*>( fields[ipatch] ) )
                 vecPatches( ipatch )->initSumField( fields[ifield], 0, smpi, true );
             else
                 vecPatches( ipatch )->initSumFieldComplex( fields[ifield], 0, smpi );
         }
+        if( aggregated ) {
+            #pragma omp single
+            fields[0]->aggregatedMPIbuff.init( fields, vecPatches.patches_, 0, 3+0, smpi );
+        }
 
         // iDim = 0, local
 
@@ -144,6 +155,10 @@ public :
         }
 
         // iDim = 0, finalize (waitall)
+        if( aggregated ) {
+            #pragma omp single
+            fields[0]->aggregatedMPIbuff.finalize( 3+0 );
+        }
     #ifndef _NO_MPI_TM
         #pragma omp for schedule(static)
     #else
@@ -151,7 +166,9 @@ public :
     #endif
         for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
             unsigned int ipatch = ifield%nPatches;
-            vecPatches( ipatch )->finalizeSumField( fields[ifield], 0 );
+            if( ! aggregated ) {
+                vecPatches( ipatch )->finalizeSumField( fields[ifield], 0 );
+            }
             for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
                 if ( vecPatches( ipatch )->is_a_MPI_neighbor( 0, ( iNeighbor+1 )%2 ) ) {
                     fields[ifield]->inject_fields_sum( 0, iNeighbor, oversize[0] );
@@ -184,11 +201,17 @@ public :
 // #endif
                     }
                 }
+                if( aggregated )
+                    continue;
                 if ( !dynamic_cast<cField*>( fields[ipatch] ) )
                     vecPatches( ipatch )->initSumField( fields[ifield], 1, smpi, true );
                 else
                     vecPatches( ipatch )->initSumFieldComplex( fields[ifield], 1, smpi );
             }
+            if( aggregated ) {
+                #pragma omp single
+                fields[0]->aggregatedMPIbuff.init( fields, vecPatches.patches_, 1, 3+1, smpi );
+            }
 
             // iDim = 1, local
 
@@ -249,6 +272,10 @@ public :
             }
 
             // iDim = 1, finalize (waitall)
+            if( aggregated ) {
+                #pragma omp single
+                fields[0]->aggregatedMPIbuff.finalize( 3+1 );
+            }
     #ifndef _NO_MPI_TM
             #pragma omp for schedule(static)
     #else
@@ -256,7 +283,9 @@ public :
     #endif
             for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
                 unsigned int ipatch = ifield%nPatches;
-                vecPatches( ipatch )->finalizeSumField( fields[ifield], 1 );
+                if( ! aggregated ) {
+                    vecPatches( ipatch )->finalizeSumField( fields[ifield], 1 );
+                }
                 for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
                     if ( vecPatches( ipatch )->is_a_MPI_neighbor( 1, ( iNeighbor+1 )%2 ) ) {
                         fields[ifield]->inject_fields_sum( 1, iNeighbor, oversize[1] );
@@ -288,8 +317,14 @@ public :
 // #endif                       
                         }
                     }
+                    if( aggregated )
+                        continue;
                     vecPatches( ipatch )->initSumField( fields[ifield], 2, smpi, true );
                 }
+                if( aggregated ) {
+                    #pragma omp single
+                    fields[0]->aggregatedMPIbuff.init( fields, vecPatches.patches_, 2, 3+2, smpi );
+                }
 
                 // iDim = 2 local
 
@@ -348,6 +383,10 @@ public :
                 }
 
                 // iDim = 2, complete non local sync through MPIfinalize (waitall)
+                if( aggregated ) {
+                    #pragma omp single
+                    fields[0]->aggregatedMPIbuff.finalize( 3+2 );
+                }
     #ifndef _NO_MPI_TM
                 #pragma omp for schedule(static)
     #else
@@ -355,7 +394,9 @@ public :
     #endif
                 for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
                     unsigned int ipatch = ifield%nPatches;
-                    vecPatches( ipatch )->finalizeSumField( fields[ifield], 2 );
+                    if( ! aggregated ) {
+                        vecPatches( ipatch )->finalizeSumField( fields[ifield], 2 );
+                    }
                     for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
                         if ( vecPatches( ipatch )->is_a_MPI_neighbor( 2, ( iNeighbor+1 )%2 ) ) {
                             fields[ifield]->inject_fields_sum( 2, iNeighbor, oversize[2] );
@@ -370,7 +411,9 @@ public :
         } // End if dims_.size()>1
     };
 
-    static void sumAllComponents( std::vector<Field *> &fields, VectorPatch &vecPatches, SmileiMPI *smpi );
+    static void sumAllComponents( std::vector<Field *> &fields, VectorPatch &vecPatches, SmileiMPI *smpi, bool defer_last_dimension=false );
+    //! Complete the sums along the last dimension deferred by sumAllComponents
+    static void finalizeSumAllComponents( std::vector<Field *> &fields, VectorPatch &vecPatches );
 
     void templateGenerator();
 
@@ -379,6 +422,10 @@ public :
     static void finalizeexchangeE( Params &params, VectorPatch &vecPatches );
     static void exchangeB( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi );
     static void finalizeexchangeB( Params &params, VectorPatch &vecPatches );
+    //! exchangeB split in two steps, to update the patches which have no MPI neighbor along X while
+    //! the MPI messages along X are in flight. Only for solvers which do not need full_B_exchange
+    static void exchangeBBorders( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi );
+    static void completeExchangeB( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi );
     static void exchangeBmBTIS3( Params &params, VectorPatch &vecPatches, int imode, SmileiMPI *smpi );
     static void finalizeexchangeBmBTIS3( Params &params, VectorPatch &vecPatches, int imode );
     static void exchangeBmBTIS3( Params &params, VectorPatch &vecPatches, SmileiMPI *smpi );
@@ -414,6 +461,10 @@ public :
     static void exchangeSynchronizedPerDirection( std::vector<Field *> fields, VectorPatch &vecPatches, SmileiMPI *smpi );
 
     static void exchangeAllComponentsAlongX( std::vector<Field *> &fields, VectorPatch &vecPatches, SmileiMPI *smpi );
+    //! MPI part of exchangeAllComponentsAlongX, which only needs the patches with an MPI neighbor along X
+    static void initExchangeAllComponentsAlongX( VectorPatch &vecPatches, SmileiMPI *smpi );
+    //! Local part of exchangeAllComponentsAlongX, to be called once all patches are updated
+    static void exchangeLocalAllComponentsAlongX( std::vector<Field *> &fields, VectorPatch &vecPatches );
     static void finalizeExchangeAllComponentsAlongX( VectorPatch &vecPatches );
     static void exchangeAllComponentsAlongY( std::vector<Field *> &fields, VectorPatch &vecPatches, SmileiMPI *smpi );
     static void finalizeExchangeAllComponentsAlongY( VectorPatch &vecPatches );
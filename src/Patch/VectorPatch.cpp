@@ -1,5 +1,6 @@
 #include "VectorPatch.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include <cstdlib>
@@ -39,12 +40,28 @@ using namespace std;
 VectorPatch::VectorPatch()
 {
     domain_decomposition_ = NULL ;
+    currents_sum_pending_ = false;
+    lb_particles_time_ = 0.;
+    lb_max_time_ = 0.;
+    lb_mean_time_ = 0.;
+    lb_exchange_time_ = 0.;
+    lb_migration_time_ = 0.;
+    lb_new_distribution_ = false;
+    thread_idle_time_ = 0.;
 }
 
 
 VectorPatch::VectorPatch( Params &params )
 {
     domain_decomposition_ = DomainDecompositionFactory::create( params );
+    currents_sum_pending_ = false;
+    lb_particles_time_ = 0.;
+    lb_max_time_ = 0.;
+    lb_mean_time_ = 0.;
+    lb_exchange_time_ = 0.;
+    lb_migration_time_ = 0.;
+    lb_new_distribution_ = false;
+    thread_idle_time_ = 0.;
 }
 
 
@@ -388,7 +405,25 @@ void VectorPatch::dynamics( Params &params,
 #  endif
 
     timers.particles.update( params.printNow( itime ) );
+#ifndef _OMPTASKS
+    // Time waited by the threads at the end of the particle loop, averaged over the threads
+    #pragma omp master
+    {
+#ifdef _OPENMP
+        int thread_number = omp_get_num_threads();
+#else
+        int thread_number = 1;
+#endif
+        timers.threadIdle.add( thread_idle_time_ / thread_number, params.printNow( itime ) );
+        thread_idle_time_ = 0.;
+    }
+#endif
 #ifdef __DETAILED_TIMERS
+    // One more iteration in the measured load of each patch
+    #pragma omp single nowait
+    for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+        ( *this )( ipatch )->measured_iterations_++;
+    }
     timers.interpolator.updateThreaded( *this, params.printNow( itime ) );
     timers.pusher.updateThreaded( *this, params.printNow( itime ) );
     timers.projector.updateThreaded( *this, params.printNow( itime ) );
@@ -475,6 +510,10 @@ void VectorPatch::finalizeExchParticlesAndSort( Params &params, SmileiMPI *smpi,
 
     }
 
+#ifdef __DETAILED_TIMERS
+    timers.sorting.update( *this, params.printNow( itime ) );
+#endif
+
     // Particle importation from physical mechanisms
     // ----------------------------------------
 
@@ -635,13 +674,13 @@ void VectorPatch::injectParticlesFromBoundaries(Params &params, Timers &timers,
                     position_shift[axis] = params.cell_length[axis];
                 }
 
-                double * __restrict__ position_x = particles->getPtrPosition( 0 );
-                double * __restrict__ position_y = particles->getPtrPosition( 1 );
-                double * __restrict__ position_z = particles->getPtrPosition( 2 );
+                particle_real * __restrict__ position_x = particles->getPtrPosition( 0 );
+                particle_real * __restrict__ position_y = particles->getPtrPosition( 1 );
+                particle_real * __restrict__ position_z = particles->getPtrPosition( 2 );
 
-                double * __restrict__ momentum_x = particles->getPtrMomentum( 0 );
-                double * __restrict__ momentum_y = particles->getPtrMomentum( 1 );
-                double * __restrict__ momentum_z = particles->getPtrMomentum( 2 );
+                particle_real * __restrict__ momentum_x = particles->getPtrMomentum( 0 );
+                particle_real * __restrict__ momentum_y = particles->getPtrMomentum( 1 );
+                particle_real * __restrict__ momentum_z = particles->getPtrMomentum( 2 );
 
                 if (params.nDim_particle == 1) {
 
@@ -739,13 +778,13 @@ void VectorPatch::injectParticlesFromBoundaries(Params &params, Timers &timers,
                     local_particles_vector[i_injector].resize( particle_number );
                 }
                 // Pointers injector 1
-                double *const __restrict__ px         = local_particles_vector[i_injector].getPtrPosition(0);
-                double *const __restrict__ py         = local_particles_vector[i_injector].getPtrPosition(1);
-                double *const __restrict__ pz         = local_particles_vector[i_injector].getPtrPosition(2);
+                particle_real *const __restrict__ px         = local_particles_vector[i_injector].getPtrPosition(0);
+                particle_real *const __restrict__ py         = local_particles_vector[i_injector].getPtrPosition(1);
+                particle_real *const __restrict__ pz         = local_particles_vector[i_injector].getPtrPosition(2);
                 // Pointers injector 2
-                const double *const __restrict__ lpvx = local_particles_vector[i_injector_2].getPtrPosition(0);
-                const double *const __restrict__ lpvy = local_particles_vector[i_injector_2].getPtrPosition(1);
-                const double *const __restrict__ lpvz = local_particles_vector[i_injector_2].getPtrPosition(2);
+                const particle_real *const __restrict__ lpvx = local_particles_vector[i_injector_2].getPtrPosition(0);
+                const particle_real *const __restrict__ lpvy = local_particles_vector[i_injector_2].getPtrPosition(1);
+                const particle_real *const __restrict__ lpvz = local_particles_vector[i_injector_2].getPtrPosition(2);
                 if (params.nDim_particle == 3) {
                     #pragma omp simd
                     for ( unsigned int ip = 0; ip < particle_number ; ip++ ) {
@@ -871,8 +910,19 @@ void VectorPatch::sumDensities( Params &params, double time_dual, Timers &timers
 
     timers.syncDens.restart();
     if( params.geometry != "AMcylindrical" ) {
+        // The MPI sum of J along the last dimension can be completed in solveMaxwell, once the
+        // patches which do not need it are updated, if nothing else reads J in the meantime
+        bool defer_currents = ( itime > 0 )
+                              && ( !params.multiple_decomposition )
+                              && ( !params.is_spectral )
+                              && ( !diag_flag )
+                              && ( params.currentFilter_passes.size() == 0 )
+                              && ( nAntennas == 0 )
+                              && ( time_dual > params.time_fields_frozen );
         if ( (!params.multiple_decomposition)||(itime==0) )
-            SyncVectorPatch::sumRhoJ( params, ( *this ), smpi ); // MPI
+            SyncVectorPatch::sumRhoJ( params, ( *this ), smpi, defer_currents ); // MPI
+        #pragma omp single
+        currents_sum_pending_ = defer_currents;
     } else {
 
         if ( (!params.multiple_decomposition)||(itime==0) )
@@ -1022,16 +1072,83 @@ void VectorPatch::solveMaxwell( Params &params, SimWindow *simWindow, int itime,
         }
     }
 
-    #pragma omp for schedule(static)
-    for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-        if( !params.is_spectral ) {
-            // Saving magnetic fields (to compute centered fields used in the particle pusher)
-            // Stores B at time n in B_m.
+    if( currents_sum_pending_ ) {
+        // The MPI sum of J along the last dimension is still in flight (see sumDensities) :
+        // first update the patches which do not receive any contribution along this dimension
+        unsigned int lastDim = params.nDim_field-1;
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            if( ( *this )( ipatch )->has_an_MPI_neighbor( lastDim ) ) {
+                continue;
+            }
             ( *this )( ipatch )->EMfields->saveMagneticFields( params.is_spectral );
+            ( *( *this )( ipatch )->EMfields->MaxwellAmpereSolver_ )( ( *this )( ipatch )->EMfields );
+        }
+        timers.maxwell.update();
+
+        timers.syncDens.restart();
+        SyncVectorPatch::finalizeSumAllComponents( densities, *this );
+        timers.syncDens.update( params.printNow( itime ) );
+
+        timers.maxwell.restart();
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            if( ! ( *this )( ipatch )->has_an_MPI_neighbor( lastDim ) ) {
+                continue;
+            }
+            ( *this )( ipatch )->EMfields->saveMagneticFields( params.is_spectral );
+            ( *( *this )( ipatch )->EMfields->MaxwellAmpereSolver_ )( ( *this )( ipatch )->EMfields );
+        }
+        #pragma omp single
+        currents_sum_pending_ = false;
+    } else {
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            if( !params.is_spectral ) {
+                // Saving magnetic fields (to compute centered fields used in the particle pusher)
+                // Stores B at time n in B_m.
+                ( *this )( ipatch )->EMfields->saveMagneticFields( params.is_spectral );
+            }
+            // Computes Ex_, Ey_, Ez_ on all points.
+            // E is already synchronized because J has been synchronized before.
+            ( *( *this )( ipatch )->EMfields->MaxwellAmpereSolver_ )( ( *this )( ipatch )->EMfields );
+        }
+    }
+
+    // B is exchanged per component : the MPI exchange along X can start as soon as the patches
+    // which have an MPI neighbor along X are updated, the other patches are updated meanwhile
+    bool overlap_B_exchange = ( !params.is_spectral )
+                              && ( params.geometry != "AMcylindrical" )
+                              && ( !params.multiple_decomposition )
+                              && ( ( !params.full_B_exchange ) || ( params.nDim_field == 1 ) );
+
+    if( overlap_B_exchange ) {
+        #pragma omp for schedule(static)
+        for( unsigned int ifield=0 ; ifield<MPIxIdx.size() ; ifield++ ) {
+            unsigned int ipatch = MPIxIdx[ifield];
+            // Computes Bx_, By_, Bz_ at time n+1 on interior points.
+            ( *( *this )( ipatch )->EMfields->MaxwellFaradaySolver_ )( ( *this )( ipatch )->EMfields );
+        }
+        timers.maxwell.update();
+
+        timers.syncField.restart();
+        SyncVectorPatch::exchangeBBorders( params, ( *this ), smpi );
+        timers.syncField.update();
+
+        timers.maxwell.restart();
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            if( ( *this )( ipatch )->has_an_MPI_neighbor( 0 ) ) {
+                continue;
+            }
+            ( *( *this )( ipatch )->EMfields->MaxwellFaradaySolver_ )( ( *this )( ipatch )->EMfields );
         }
-        // Computes Ex_, Ey_, Ez_ on all points.
-        // E is already synchronized because J has been synchronized before.
-        ( *( *this )( ipatch )->EMfields->MaxwellAmpereSolver_ )( ( *this )( ipatch )->EMfields );
+        timers.maxwell.update( params.printNow( itime ) );
+
+        timers.syncField.restart();
+        SyncVectorPatch::completeExchangeB( params, ( *this ), smpi );
+        timers.syncField.update( params.printNow( itime ) );
+        return;
     }
 
     #pragma omp for schedule(static)
@@ -1255,6 +1372,31 @@ void VectorPatch::closeAllDiags( SmileiMPI *smpi )
 }
 
 
+bool VectorPatch::diagsWriteHDF5( unsigned int itime )
+{
+    for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
+        if( globalDiags[idiag]->writesHDF5( itime ) ) {
+            return true;
+        }
+    }
+    for( unsigned int idiag = 0 ; idiag < localDiags.size() ; idiag++ ) {
+        if( localDiags[idiag]->writesHDF5( itime ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// HDF5 is not thread-safe: background writes must end before anything else uses the library
+void VectorPatch::waitAllDiagsWrite()
+{
+    for( unsigned int idiag = 0 ; idiag < localDiags.size() ; idiag++ ) {
+        localDiags[idiag]->waitWrite();
+    }
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // For all patch, Compute and Write all diags
 //   - Scalars, Probes, Phases, TrackParticles, Fields, Average fields
@@ -1275,6 +1417,15 @@ void VectorPatch::runAllDiags( Params &/*params*/, SmileiMPI *smpi, unsigned int
     // Global diags: scalars + particles
     timers.diags.restart();
 
+    // Fields may still be written in the background
+    // (writesHDF5 updates the time selections: a single thread queries them)
+    #pragma omp single
+    {
+        if( diagsWriteHDF5( itime ) ) {
+            waitAllDiagsWrite();
+        }
+    }
+
     // Determine which data is required from the device
 #if defined( SMILEI_ACCELERATOR_GPU )
     bool need_particles = false;
@@ -1448,6 +1599,8 @@ void VectorPatch::runAllDiags( Params &/*params*/, SmileiMPI *smpi, unsigned int
                 globalDiags[idiag]->run( ( *this )( ipatch ), itime, simWindow );
             }
             SMILEI_PY_RESTORE_MASTER_THREAD
+            // Threads sum their private contributions
+            globalDiags[idiag]->reduceThreads();
             // MPI procs gather the data and compute
             #pragma omp single
             smpi->computeGlobalDiags( globalDiags[idiag], itime );
@@ -1531,6 +1684,11 @@ void VectorPatch::runAllDiagsTasks( Params &, SmileiMPI *smpi, unsigned int itim
     timers.diags.restart();
     #pragma omp single
     {
+        // Fields may still be written in the background
+        if( diagsWriteHDF5( itime ) ) {
+            waitAllDiagsWrite();
+        }
+
         for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
 
             diag_timers_[idiag]->restartInTask();
@@ -1577,6 +1735,8 @@ void VectorPatch::runAllDiagsTasks( Params &, SmileiMPI *smpi, unsigned int itim
 
     for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
         if( globalDiags[idiag]->theTimeIsNow_ ) {
+            // Threads sum their private contributions
+            globalDiags[idiag]->reduceThreads();
             // MPI procs gather the data and compute
             #pragma omp single
             {
@@ -2943,11 +3103,65 @@ void VectorPatch::solveRelativisticPoissonAM( Params &params, SmileiMPI *smpi, d
 // ---------------------------------------------------------------------------------------------------------------------
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Tells if the load must be balanced this iteration
+//   - fixed schedule: at the iterations selected by LoadBalancing.every
+//   - imbalance_threshold: the time of the particle operations of this iteration is reduced over the processes
+//     (largest and average). The load is balanced when, since the last balancing,
+//       * the largest over average time exceeds the threshold
+//       * the time lost waiting for the slowest process exceeds the time of the last exchange of patches,
+//         i.e. a balancing would pay off if the next period is as long as the previous one
+//   - and at each iteration while patches are migrating by batches (LoadBalancing.migration_budget)
+// ---------------------------------------------------------------------------------------------------------------------
+bool VectorPatch::loadBalancingNow( Params &params, SmileiMPI *smpi, Timers &timers, unsigned int itime )
+{
+    if( params.imbalance_threshold <= 0. ) {
+        lb_new_distribution_ = params.load_balancing_time_selection->theTimeIsNow( itime );
+    } else {
+        double time_step = max( timers.particles.getTime() - lb_particles_time_, 0. );
+        lb_particles_time_ = timers.particles.getTime();
+
+        double time_max, time_sum;
+        smpi->maxAndSum( time_step, time_max, time_sum );
+        lb_max_time_  += time_max;
+        lb_mean_time_ += time_sum / smpi->getSize();
+
+        // No new distribution before the end of the current migration
+        lb_new_distribution_ = migration_target_.empty()
+                               && lb_mean_time_ > 0.
+                               && lb_max_time_ > params.imbalance_threshold * lb_mean_time_
+                               && lb_max_time_ - lb_mean_time_ > lb_exchange_time_;
+    }
+
+    return lb_new_distribution_ || ! migration_target_.empty();
+}
+
+
 void VectorPatch::loadBalance( Params &params, double time_dual, SmileiMPI *smpi, SimWindow *simWindow, unsigned int itime )
 {
 
-    // Compute new patch distribution
-    smpi->recompute_patch_count( params, *this, time_dual );
+    std::vector<int> patch_count = smpi->patch_count;
+
+    if( lb_new_distribution_ ) {
+        // Compute new patch distribution
+        smpi->recompute_patch_count( params, *this, time_dual );
+
+        // With a migration budget, it is only the target of the next migration batches
+        if( params.migration_budget > 0. ) {
+            migration_target_ = smpi->patch_refHindexes;
+            smpi->patch_count = patch_count;
+            for( int rk=1 ; rk<smpi->getSize() ; rk++ ) {
+                smpi->patch_refHindexes[rk] = smpi->patch_refHindexes[rk-1] + patch_count[rk-1];
+            }
+        }
+    }
+
+    // Next batch of patches to migrate toward the target distribution
+    if( ! migration_target_.empty() ) {
+        nextMigrationBatch( params, smpi );
+    }
+
+    double exchange_start = MPI_Wtime();
 
     // Create empty patches according to this new distribution
     this->createPatches( params, smpi, simWindow );
@@ -2955,12 +3169,96 @@ void VectorPatch::loadBalance( Params &params, double time_dual, SmileiMPI *smpi
     // Proceed to patch exchange, and delete patch which moved
     this->exchangePatches( smpi, params );
 
+    // Cost of the exchange (all its batches) and new period for the imbalance-triggered balancing
+    // (an exchange which moved no patch does not tell the cost of the next one)
+    if( params.imbalance_threshold > 0. ) {
+        double exchange_time = MPI_Wtime() - exchange_start;
+        if( patch_count != smpi->patch_count ) {
+            double batch_time;
+            MPI_Allreduce( &exchange_time, &batch_time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
+            lb_migration_time_ += batch_time;
+        }
+        if( migration_target_.empty() ) {
+            if( lb_migration_time_ > 0. ) {
+                lb_exchange_time_ = lb_migration_time_;
+            }
+            lb_migration_time_ = 0.;
+            lb_max_time_ = 0.;
+            lb_mean_time_ = 0.;
+        }
+    }
+
+    // The neighbours of the patches changed: the persistent field exchanges must be rebuilt
+    smpi->invalidateFieldExchanges();
+
     // Tell that the patches moved this iteration (needed for probes)
     lastIterationPatchesMoved = itime;
 
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Set in smpi->patch_count the next step from the current distribution toward migration_target_
+//   - across each boundary between two processes, the sender gives the patches closest to the boundary
+//     until their particles exceed LoadBalancing.migration_budget (at least one patch)
+//   - the patches which do not move yet keep being computed by their current owner
+//   - the new positions of the boundaries are gathered to all processes
+// ---------------------------------------------------------------------------------------------------------------------
+void VectorPatch::nextMigrationBatch( Params &params, SmileiMPI *smpi )
+{
+    int rank = smpi->getRank();
+    int nrank = smpi->getSize();
+    std::vector<int> &current = smpi->patch_refHindexes;
+
+    // New position of my first and last boundaries, if I send patches across them (-1 otherwise)
+    int moved[2] = { -1, -1 };
+    if( rank > 0 && migration_target_[rank] > current[rank] ) {
+        moved[0] = current[rank] + migrationBatchSize( params, 0, 1, migration_target_[rank] - current[rank] );
+    }
+    if( rank < nrank-1 && migration_target_[rank+1] < current[rank+1] ) {
+        moved[1] = current[rank+1] - migrationBatchSize( params, size()-1, -1, current[rank+1] - migration_target_[rank+1] );
+    }
+    std::vector<int> all_moved( 2*nrank );
+    MPI_Allgather( moved, 2, MPI_INT, &all_moved[0], 2, MPI_INT, MPI_COMM_WORLD );
+
+    int npatches = current[nrank-1] + smpi->patch_count[nrank-1];
+    for( int rk=1 ; rk<nrank ; rk++ ) {
+        if( all_moved[2*rk] >= 0 ) {
+            current[rk] = all_moved[2*rk];
+        } else if( all_moved[2*rk-1] >= 0 ) {
+            current[rk] = all_moved[2*rk-1];
+        }
+    }
+    for( int rk=0 ; rk<nrank-1 ; rk++ ) {
+        smpi->patch_count[rk] = current[rk+1] - current[rk];
+    }
+    smpi->patch_count[nrank-1] = npatches - current[nrank-1];
+
+    if( current == migration_target_ ) {
+        migration_target_.clear();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Number of patches, from ipatch in the direction step, which fit in the migration budget (at least one, at most max)
+// ---------------------------------------------------------------------------------------------------------------------
+unsigned int VectorPatch::migrationBatchSize( Params &params, int ipatch, int step, unsigned int max )
+{
+    unsigned int n = 0;
+    double nparticles = 0.;
+    for( ; n < max ; n++, ipatch += step ) {
+        double patch_particles = 0.;
+        for( unsigned int ispec=0 ; ispec<( *this )( ipatch )->vecSpecies.size() ; ispec++ ) {
+            patch_particles += ( *this )( ipatch )->vecSpecies[ispec]->getNbrOfParticles();
+        }
+        if( n > 0 && nparticles + patch_particles > params.migration_budget ) {
+            break;
+        }
+        nparticles += patch_particles;
+    }
+    return n;
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Explicits patch movement regarding new patch distribution stored in smpi->patch_count
 //   - compute send_patch_id_
@@ -4961,62 +5259,106 @@ void VectorPatch::dynamicsWithoutTasks( Params &params,
     diag_PartEventTracing = smpi->diagPartEventTracing( time_dual, params.timestep);
 #endif
 
-    #pragma omp for schedule(runtime)
+    if( params.cost_ordered_patches ) {
+        // Longest processing time first: the patches, sorted by decreasing time at the previous
+        // iteration (not measured yet first), are taken one by one by the available threads
+        #pragma omp single
+        {
+            patch_order_.resize( this->size() );
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                patch_order_[ipatch] = ipatch;
+            }
+            stable_sort( patch_order_.begin(), patch_order_.end(), [this]( unsigned int a, unsigned int b ) {
+                double ta = ( *this )( a )->dynamics_time_, tb = ( *this )( b )->dynamics_time_;
+                return ( ta < 0. && tb >= 0. ) || ta > tb;
+            } );
+        }
+        #pragma omp for schedule(dynamic,1) nowait
+        for( unsigned int iorder=0 ; iorder<patch_order_.size() ; iorder++ ) {
+            unsigned int ipatch = patch_order_[iorder];
+            double patch_start = MPI_Wtime();
+            dynamicsWithoutTasks( ipatch, params, smpi, simWindow, RadiationTables, MultiphotonBreitWheelerTables, time_dual );
+            ( *this )( ipatch )->dynamics_time_ = MPI_Wtime() - patch_start;
+        }
+    } else {
+        #pragma omp for schedule(runtime) nowait
         for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->restartRhoJ();
-            for( unsigned int ispec=0 ; ispec<( *this )( ipatch )->vecSpecies.size() ; ispec++ ) {
-                Species *spec = species( ipatch, ispec );
+            dynamicsWithoutTasks( ipatch, params, smpi, simWindow, RadiationTables, MultiphotonBreitWheelerTables, time_dual );
+        }
+    }
 
-                if( params.keep_position_old ) {
-                    spec->particles->savePositions();
-                }
+    // Time waited by this thread for the others
+    double thread_end = MPI_Wtime();
+    #pragma omp barrier
+    double thread_idle = MPI_Wtime() - thread_end;
+    #pragma omp atomic
+    thread_idle_time_ += thread_idle;
+}
 
-                if( params.Laser_Envelope_model ) {
-                    continue;
-                }
+// ---------------------------------------------------------------------------------------------------------------------
+// Macro-particle operations of one patch, without tasks
+// ---------------------------------------------------------------------------------------------------------------------
+void VectorPatch::dynamicsWithoutTasks( unsigned int ipatch,
+                                        Params &params,
+                                        SmileiMPI *smpi,
+                                        SimWindow *simWindow,
+                                        RadiationTables &RadiationTables,
+                                        MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables,
+                                        double time_dual )
+{
+    ( *this )( ipatch )->EMfields->restartRhoJ();
+    for( unsigned int ispec=0 ; ispec<( *this )( ipatch )->vecSpecies.size() ; ispec++ ) {
+        Species *spec = species( ipatch, ispec );
+
+        if( params.keep_position_old ) {
+            spec->particles->savePositions();
+        }
+
+        if( params.Laser_Envelope_model ) {
+            continue;
+        }
 
-                if( spec->isProj( time_dual, simWindow ) || diag_flag ) {
+        if( spec->isProj( time_dual, simWindow ) || diag_flag ) {
 
 #if defined( SMILEI_ACCELERATOR_GPU )
-                    if (diag_flag) {
-                        spec->Species::prepareSpeciesCurrentAndChargeOnDevice(
-                            ispec,
-                            emfields( ipatch )
-                        );
-                    }
+            if (diag_flag) {
+                spec->Species::prepareSpeciesCurrentAndChargeOnDevice(
+                    ispec,
+                    emfields( ipatch )
+                );
+            }
 #endif
 
-                    // Dynamics with vectorized operators
-                    if( spec->vectorized_operators ) {
-                        spec->dynamics( time_dual, ispec,
-                                        emfields( ipatch ),
-                                        params, diag_flag, partwalls( ipatch ),
-                                        ( *this )( ipatch ), smpi,
-                                        RadiationTables,
-                                        MultiphotonBreitWheelerTables );
-                    }
-                    // Dynamics with scalar operators
-                    else {
-                        if( params.vectorization_mode == "adaptive" ) {
-                            spec->scalarDynamics( time_dual, ispec,
-                                                   emfields( ipatch ),
-                                                   params, diag_flag, partwalls( ipatch ),
-                                                   ( *this )( ipatch ), smpi,
-                                                   RadiationTables,
-                                                   MultiphotonBreitWheelerTables );
-                        } else {
-                            spec->Species::dynamics( time_dual, ispec,
-                                                     emfields( ipatch ),
-                                                     params, diag_flag, partwalls( ipatch ),
-                                                     ( *this )( ipatch ), smpi,
-                                                     RadiationTables,
-                                                     MultiphotonBreitWheelerTables );
-                        }
-                    } // end if condition on vectorization
-                } // end if condition on species
-            } // end loop on species
-            //MESSAGE("species dynamics");
-        } // end loop on patches
+            // Dynamics with vectorized operators
+            if( spec->vectorized_operators ) {
+                spec->dynamics( time_dual, ispec,
+                                emfields( ipatch ),
+                                params, diag_flag, partwalls( ipatch ),
+                                ( *this )( ipatch ), smpi,
+                                RadiationTables,
+                                MultiphotonBreitWheelerTables );
+            }
+            // Dynamics with scalar operators
+            else {
+                if( params.vectorization_mode == "adaptive" ) {
+                    spec->scalarDynamics( time_dual, ispec,
+                                           emfields( ipatch ),
+                                           params, diag_flag, partwalls( ipatch ),
+                                           ( *this )( ipatch ), smpi,
+                                           RadiationTables,
+                                           MultiphotonBreitWheelerTables );
+                } else {
+                    spec->Species::dynamics( time_dual, ispec,
+                                             emfields( ipatch ),
+                                             params, diag_flag, partwalls( ipatch ),
+                                             ( *this )( ipatch ), smpi,
+                                             RadiationTables,
+                                             MultiphotonBreitWheelerTables );
+                }
+            } // end if condition on vectorization
+        } // end if condition on species
+    } // end loop on species
+    //MESSAGE("species dynamics");
 }
 
 void VectorPatch::ponderomotiveUpdateSusceptibilityAndMomentumWithoutTasks( Params &params,
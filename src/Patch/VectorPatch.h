@@ -155,6 +155,15 @@ public :
                    MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables,
                    double time_dual,
                    Timers &timers, int itime );
+
+    //! macro-particle operations of one patch without tasks
+    void dynamicsWithoutTasks( unsigned int ipatch,
+                   Params &params,
+                   SmileiMPI *smpi,
+                   SimWindow *simWindow,
+                   RadiationTables &RadiationTables,
+                   MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables,
+                   double time_dual );
     
     //! For all patches, exchange particles and sort them.
     void initExchParticles( Params &params, SmileiMPI *smpi, SimWindow *simWindow,
@@ -240,6 +249,10 @@ public :
     void runAllDiagsTasks( Params &params, SmileiMPI *smpi, unsigned int itime, Timers &timers, SimWindow *simWindow );
     void initAllDiags( Params &params, SmileiMPI *smpi );
     void closeAllDiags( SmileiMPI *smpi );
+    //! Tells whether any diag writes to an HDF5 file at this iteration (by a single thread: it updates the time selections)
+    bool diagsWriteHDF5( unsigned int itime );
+    //! Waits for the diags writing their files in the background
+    void waitAllDiagsWrite();
     
     //! Check if rho is null (MPI & patch sync)
     bool isRhoNull( SmileiMPI *smpi );
@@ -280,9 +293,20 @@ public :
     //  Balancing methods
     // ------------------
     
+    //! Tells if the load must be balanced this iteration: at the iterations of LoadBalancing.every, or
+    //! when the measured imbalance is worth a balancing (LoadBalancing.imbalance_threshold), or if
+    //! patches are still migrating by batches. Collective
+    bool loadBalancingNow( Params &params, SmileiMPI *smpi, Timers &timers, unsigned int itime );
+
     //! Wrapper of load balancing methods, including SmileiMPI::recompute_patch_count. Called from main program
     void loadBalance( Params &params, double time_dual, SmileiMPI *smpi, SimWindow *simWindow, unsigned int itime );
     
+    //! Set in smpi->patch_count the next migration batch toward migration_target_ (LoadBalancing.migration_budget)
+    void nextMigrationBatch( Params &params, SmileiMPI *smpi );
+
+    //! Number of patches, from ipatch in the direction step, whose particles fit in the migration budget
+    unsigned int migrationBatchSize( Params &params, int ipatch, int step, unsigned int max );
+
     //! Explicits patch movement regarding new patch distribution stored in smpi->patch_count
     void createPatches( Params &params, SmileiMPI *smpi, SimWindow *simWindow );
     
@@ -464,11 +488,33 @@ public :
     
     // Keep track if we need the needsRhoJsNow
     int diag_flag;
+
+    //! True if sumDensities left the MPI sum of J along the last dimension for solveMaxwell to complete
+    bool currents_sum_pending_;
     
     int nrequests;
     
     //! Tells which iteration was last time the patches moved (by moving window or load balancing)
     unsigned int lastIterationPatchesMoved;
+
+    //! Imbalance-triggered load balancing: time of the particle timer at the previous iteration,
+    //! sums of the largest and average time per iteration of the processes since the last balancing,
+    //! and time taken by the last exchange of patches
+    double lb_particles_time_;
+    double lb_max_time_;
+    double lb_mean_time_;
+    double lb_exchange_time_;
+    //! Time of the migration batches of the current exchange
+    double lb_migration_time_;
+    //! True if loadBalancingNow asked for a new patch distribution
+    bool lb_new_distribution_;
+    //! Index of the first patch of each process in the distribution reached by batches, empty if reached
+    std::vector<int> migration_target_;
+
+    //! Order of the patches in the particle loop (Main.patch_scheduling = "cost")
+    std::vector<unsigned int> patch_order_;
+    //! Time waited by the threads at the end of the particle loop, summed over the threads
+    double thread_idle_time_;
     
     DomainDecomposition *domain_decomposition_;
     
@@ -196,9 +196,9 @@ void Projector1D2OrderGPU::currentsAndDensityWrapper( ElectroMagn *EMfields,
                                                       int  icell, 
                                                       int  ipart_ref ) // icell and ipart_ref unused
 {
-    std::vector<int>    &iold  = smpi->dynamics_iold[ithread];
-    std::vector<double> &delta = smpi->dynamics_deltaold[ithread];
-    std::vector<double> &invgf = smpi->dynamics_invgf[ithread];
+    dynamics_buffer<int> &iold = smpi->dynamics_iold[ithread];
+    dynamics_buffer<double> &delta = smpi->dynamics_deltaold[ithread];
+    dynamics_buffer<double> &invgf = smpi->dynamics_invgf[ithread];
 
     if( diag_flag ) {
 
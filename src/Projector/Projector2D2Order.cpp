@@ -497,9 +497,9 @@ void Projector2D2Order::ionizationCurrents( Field *Jx, Field *Jy, Field *Jz, Par
 // ---------------------------------------------------------------------------------------------------------------------
 void Projector2D2Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool is_spectral, int ispec, int /*icell*/, int /*ipart_ref*/ )
 {
-    std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    dynamics_buffer<int> *iold = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *invgf = &( smpi->dynamics_invgf[ithread] );
     Jx_  =  &( *EMfields->Jx_ )( 0 );
     Jy_  =  &( *EMfields->Jy_ )( 0 );
     Jz_  =  &( *EMfields->Jz_ )( 0 );
@@ -536,10 +536,10 @@ void Projector2D2Order::susceptibility( ElectroMagn *EMfields, Particles &partic
 {
     double *Chi_envelope = &( *EMfields->Env_Chi_ )( 0 );
     
-    std::vector<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
-    std::vector<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
+    dynamics_buffer<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
     
     int iloc;
     
@@ -644,10 +644,10 @@ void Projector2D2Order::susceptibilityOnBuffer( ElectroMagn */*EMfields*/, doubl
 
 {
     
-    std::vector<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
-    std::vector<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
+    dynamics_buffer<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
     
     int iloc;
     
@@ -851,9 +851,9 @@ void Projector2D2Order::ionizationCurrentsForTasks( double *b_Jx, double *b_Jy,
 // ---------------------------------------------------------------------------------------------------------------------
 void Projector2D2Order::currentsAndDensityWrapperOnBuffers( double *b_Jx, double *b_Jy, double *b_Jz, double *b_rho, int bin_shift, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool is_spectral, int /*ispec*/, int /*icell*/, int /*ipart_ref*/ )
 {
-    std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    dynamics_buffer<int> *iold = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *invgf = &( smpi->dynamics_invgf[ithread] );
     
     // If no field diagnostics this timestep, then the projection is done directly on the total arrays
     if( !diag_flag ) {
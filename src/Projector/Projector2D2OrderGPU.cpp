@@ -340,9 +340,9 @@ void Projector2D2OrderGPU::currentsAndDensityWrapper( ElectroMagn *EMfields,
                                                       int  /*icell*/,
                                                       int  /*ipart_ref */)
 {
-    std::vector<int>    &iold  = smpi->dynamics_iold[ithread];
-    std::vector<double> &delta = smpi->dynamics_deltaold[ithread];
-    std::vector<double> &invgf = smpi->dynamics_invgf[ithread];
+    dynamics_buffer<int> &iold = smpi->dynamics_iold[ithread];
+    dynamics_buffer<double> &delta = smpi->dynamics_deltaold[ithread];
+    dynamics_buffer<double> &invgf = smpi->dynamics_invgf[ithread];
 
     if( diag_flag ) {
         // TODO(Etienne M): DIAGS. Find a way to get rho. We could:
@@ -82,9 +82,9 @@ void Projector2D2OrderV::currentsAndDensity( double * __restrict__ Jx,
     double charge_weight[8] __attribute__( ( aligned( 64 ) ) );
 
     // Pointer for GPU and vectorization on ARM processors
-    double * __restrict__ position_x = particles.getPtrPosition(0);
-    double * __restrict__ position_y = particles.getPtrPosition(1);
-    double * __restrict__ weight     = particles.getPtrWeight();
+    particle_real * __restrict__ position_x = particles.getPtrPosition(0);
+    particle_real * __restrict__ position_y = particles.getPtrPosition(1);
+    particle_real * __restrict__ weight     = particles.getPtrWeight();
     short  * __restrict__ charge     = particles.getPtrCharge();
 
     // Closest multiple of 8 higher or equal than npart = iend-istart.
@@ -388,10 +388,10 @@ void Projector2D2OrderV::currents( double * __restrict__ Jx,
     double crz_p[8] __attribute__( ( aligned( 64 ) ) );
 
     // Pointer for GPU and vectorization on ARM processors
-    double * __restrict__ position_x = particles.getPtrPosition(0);
-    double * __restrict__ position_y = particles.getPtrPosition(1);
-    double * __restrict__ momentum_z = particles.getPtrMomentum(2);
-    double * __restrict__ weight     = particles.getPtrWeight();
+    particle_real * __restrict__ position_x = particles.getPtrPosition(0);
+    particle_real * __restrict__ position_y = particles.getPtrPosition(1);
+    particle_real * __restrict__ momentum_z = particles.getPtrMomentum(2);
+    particle_real * __restrict__ weight     = particles.getPtrWeight();
     short  * __restrict__ charge     = particles.getPtrCharge();
 
     #pragma omp simd
@@ -625,8 +625,8 @@ void Projector2D2OrderV::currentsAndDensityWrapper( ElectroMagn *EMfields, Parti
 
     //Independent of cell. Should not be here
     //{
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *invgf = &( smpi->dynamics_invgf[ithread] );
     //}
     int iold[2];
     iold[0] = scell/nscelly_+oversize[0];
@@ -673,8 +673,8 @@ void Projector2D2OrderV::currentsAndDensityWrapperOnBuffers( double *b_Jx, doubl
     
     //Independent of cell. Should not be here
     //{
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *invgf = &( smpi->dynamics_invgf[ithread] );
     //}
     int iold[2];
     iold[0] = scell/nscelly_+oversize[0];
@@ -642,9 +642,9 @@ void  Projector2D4Order::ionizationCurrentsForTasks( double *b_Jx, double *b_Jy,
 // ---------------------------------------------------------------------------------------------------------------------
 void Projector2D4Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool is_spectral, int ispec, int /*icell*/, int /*ipart_ref*/ )
 {
-    std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    dynamics_buffer<int> *iold = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *invgf = &( smpi->dynamics_invgf[ithread] );
     Jx_  =  &( *EMfields->Jx_ )( 0 );
     Jy_  =  &( *EMfields->Jy_ )( 0 );
     Jz_  =  &( *EMfields->Jz_ )( 0 );
@@ -684,9 +684,9 @@ void Projector2D4Order::susceptibility( ElectroMagn *, Particles &, double , Smi
 // ---------------------------------------------------------------------------------------------------------------------
 void Projector2D4Order::currentsAndDensityWrapperOnBuffers( double *b_Jx, double *b_Jy, double *b_Jz, double *b_rho, int bin_shift, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool is_spectral, int /*ispec*/, int /*icell*/, int /*ipart_ref*/ )
 {
-    std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    dynamics_buffer<int> *iold = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *invgf = &( smpi->dynamics_invgf[ithread] );
     
     // If no field diagnostics this timestep, then the projection is done directly on the total arrays
     if( !diag_flag ) {
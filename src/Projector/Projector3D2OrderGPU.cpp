@@ -389,9 +389,9 @@ void Projector3D2OrderGPU::currentsAndDensityWrapper( ElectroMagn *EMfields,
 
     // Perform first current deposition
 
-    std::vector<int>    &iold  = smpi->dynamics_iold[ithread];
-    std::vector<double> &delta = smpi->dynamics_deltaold[ithread];
-    std::vector<double> &invgf = smpi->dynamics_invgf[ithread];
+    dynamics_buffer<int> &iold = smpi->dynamics_iold[ithread];
+    dynamics_buffer<double> &delta = smpi->dynamics_deltaold[ithread];
+    dynamics_buffer<double> &invgf = smpi->dynamics_invgf[ithread];
 
     if (diag_flag) {
         double *const __restrict__ Jx_  = EMfields->Jx_s[ispec] ? EMfields->Jx_s[ispec]->data() : EMfields->Jx_->data();
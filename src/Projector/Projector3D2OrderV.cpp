@@ -542,10 +542,10 @@ void Projector3D2OrderV::currents( double * __restrict__ Jx,
     double charge_weight[8] __attribute__( ( aligned( 64 ) ) );
 
     // Pointer for GPU and vectorization on ARM processors
-    double * __restrict__ position_x = particles.getPtrPosition(0);
-    double * __restrict__ position_y = particles.getPtrPosition(1);
-    double * __restrict__ position_z = particles.getPtrPosition(2);
-    double * __restrict__ weight     = particles.getPtrWeight();
+    particle_real * __restrict__ position_x = particles.getPtrPosition(0);
+    particle_real * __restrict__ position_y = particles.getPtrPosition(1);
+    particle_real * __restrict__ position_z = particles.getPtrPosition(2);
+    particle_real * __restrict__ weight     = particles.getPtrWeight();
     short  * __restrict__ charge     = particles.getPtrCharge();
 
     // Closest multiple of 8 higher or equal than npart = iend-istart.
@@ -667,8 +667,8 @@ void Projector3D2OrderV::currentsAndDensityWrapper( ElectroMagn *EMfields,
 
     //Independent of cell. Should not be here
     //{
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *invgf = &( smpi->dynamics_invgf[ithread] );
     //}
     int iold[3];
 
@@ -712,9 +712,9 @@ void Projector3D2OrderV::susceptibility( ElectroMagn *EMfields, Particles &parti
     iold[2] = ( ( scell%( nscelly*nscellz ) ) % nscellz )+oversize[2];
 
 
-    std::vector<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
     double * __restrict__ inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread][0] );
 
     int nparts = smpi->dynamics_invgf[ithread].size();
@@ -735,13 +735,13 @@ void Projector3D2OrderV::susceptibility( ElectroMagn *EMfields, Particles &parti
     double Sz1[24] __attribute__( ( aligned( 64 ) ) );
     double charge_weight[8] __attribute__( ( aligned( 64 ) ) );
 
-    double * __restrict__ position_x = particles.getPtrPosition(0);
-    double * __restrict__ position_y = particles.getPtrPosition(1);
-    double * __restrict__ position_z = particles.getPtrPosition(2);
-    double * __restrict__ momentum_x = particles.getPtrMomentum(0);
-    double * __restrict__ momentum_y = particles.getPtrMomentum(1);
-    double * __restrict__ momentum_z = particles.getPtrMomentum(2);
-    double * __restrict__ weight     = particles.getPtrWeight();
+    particle_real * __restrict__ position_x = particles.getPtrPosition(0);
+    particle_real * __restrict__ position_y = particles.getPtrPosition(1);
+    particle_real * __restrict__ position_z = particles.getPtrPosition(2);
+    particle_real * __restrict__ momentum_x = particles.getPtrMomentum(0);
+    particle_real * __restrict__ momentum_y = particles.getPtrMomentum(1);
+    particle_real * __restrict__ momentum_z = particles.getPtrMomentum(2);
+    particle_real * __restrict__ weight     = particles.getPtrWeight();
     short  * __restrict__ charge     = particles.getPtrCharge();
 
     // Closest multiple of 8 higher or equal than npart = iend-istart.
@@ -906,10 +906,10 @@ void Projector3D2OrderV::susceptibilityOnBuffer( ElectroMagn */*EMfields*/, doub
     iold[2] = ( ( icell%( nscelly*nscellz ) ) % nscellz )+oversize[2];
     
     
-    std::vector<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
-    std::vector<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
+    dynamics_buffer<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
     
     int nparts = smpi->dynamics_invgf[ithread].size();
     double *Ex       = &( ( *Epart )[0*nparts] );
@@ -1093,8 +1093,8 @@ void Projector3D2OrderV::currentsAndDensityWrapperOnBuffers( double *b_Jx,
     
     //Independent of cell. Should not be here
     //{
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *invgf = &( smpi->dynamics_invgf[ithread] );
     //}
     int iold[3];
     
@@ -60,9 +60,9 @@ public:
 private:
     double dt, dts2, dts4;
 
-    inline void __attribute__((always_inline)) compute_distances(  double * __restrict__ position_x,
-                                                                   double * __restrict__ position_y,
-                                    double * __restrict__ position_z,
+    inline void __attribute__((always_inline)) compute_distances(  particle_real * __restrict__ position_x,
+                                                                   particle_real * __restrict__ position_y,
+                                    particle_real * __restrict__ position_z,
                                     int npart_total, int ipart, int istart, int ipart_ref,
                                     double *delta0, int *iold, double *Sx0, double *Sy0,
                                     double *Sz0, double *DSx, double *DSy, double *DSz )
@@ -221,9 +221,9 @@ private:
 
     };
 
-    inline void __attribute__((always_inline)) compute_distances(  double * __restrict__ position_x,
-                                    double * __restrict__ position_y,
-                                    double * __restrict__ position_z,
+    inline void __attribute__((always_inline)) compute_distances(  particle_real * __restrict__ position_x,
+                                    particle_real * __restrict__ position_y,
+                                    particle_real * __restrict__ position_z,
                                     int,
                                     int ipart, int istart,
                                     double *, int *iold, double *Sx1, double *Sy1, double *Sz1 )
@@ -156,7 +156,7 @@ void ProjectorAM1Order::currents( ElectroMagnAM *emAM, Particles &particles, uns
     
     std::complex<double> theta_old = array_eitheta_old[0]; // theta at t = t0 - dt
     rp = sqrt( particles.position( 1, ipart )*particles.position( 1, ipart )+particles.position( 2, ipart )*particles.position( 2, ipart ) );
-    std::complex<double> eitheta = ( particles.position( 1, ipart ) + Icpx * particles.position( 2, ipart ) ) / rp ; //exp(i theta)
+    std::complex<double> eitheta = ( ( double )particles.position( 1, ipart ) + Icpx * ( double )particles.position( 2, ipart ) ) / rp ; //exp(i theta)
 
     std::complex<double> e_delta_m1 = std::sqrt(eitheta * (2.*std::real(theta_old) - theta_old)); // std::sqrt keeps the root with positive real part which is what we need here.
 
@@ -333,10 +333,10 @@ void ProjectorAM1Order::apply_axisBC(std::complex<double> *rho, unsigned int imo
 void ProjectorAM1Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool /*is_spectral*/, int ispec, int /*icell*/, int /*ipart_ref*/ )
 {
         
-    std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
-    std::vector<std::complex<double>> *array_eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
+    dynamics_buffer<int> *iold = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    dynamics_buffer<std::complex<double>> *array_eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
     
     ElectroMagnAM *emAM = static_cast<ElectroMagnAM *>( EMfields );
 
@@ -363,10 +363,10 @@ void ProjectorAM1Order::susceptibility( ElectroMagn *EMfields, Particles &partic
 
     double *Chi_envelope = &( *EMfields->Env_Chi_ )( 0 );
     
-    std::vector<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
-    std::vector<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
+    dynamics_buffer<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
     
 
     double gamma_ponderomotive, gamma0, gamma0_sq;
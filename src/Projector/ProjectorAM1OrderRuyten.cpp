@@ -112,7 +112,7 @@ void ProjectorAM1OrderRuyten::currents(   ElectroMagnAM *emAM,
 
     double rp = sqrt( particles.position( 1, ipart )*particles.position( 1, ipart )+particles.position( 2, ipart )*particles.position( 2, ipart ) );
     std::complex<double> eitheta_old = array_eitheta_old[0];
-    std::complex<double> eitheta = ( particles.position( 1, ipart ) + Icpx * particles.position( 2, ipart ) ) / rp ; //exp(i theta)
+    std::complex<double> eitheta = ( ( double )particles.position( 1, ipart ) + Icpx * ( double )particles.position( 2, ipart ) ) / rp ; //exp(i theta)
     e_bar = 1.;
     // locate the particle on the primal grid at current time-step & calculate coeff. S1
     xpn = particles.position( 0, ipart ) * dl_inv_;
@@ -293,7 +293,7 @@ void ProjectorAM1OrderRuyten::basicForComplex( complex<double> *rhoj, Particles
         }
     }
 
-    complex<double> e_theta = ( particles.position( 1, ipart ) + Icpx*particles.position( 2, ipart ) )/r;
+    complex<double> e_theta = ( ( double )particles.position( 1, ipart ) + Icpx*( double )particles.position( 2, ipart ) )/r;
     complex<double> C_m = 1.;
     if( imode > 0 ) {
         C_m = 2.;
@@ -370,7 +370,7 @@ void ProjectorAM1OrderRuyten::basicForComplexOnBuffer( complex<double> *rhoj, Pa
         ERROR("This projector can be used only for charge density at the moment.");
     }
 
-    complex<double> e_theta = ( particles.position( 1, ipart ) + Icpx*particles.position( 2, ipart ) )/r;
+    complex<double> e_theta = ( ( double )particles.position( 1, ipart ) + Icpx*( double )particles.position( 2, ipart ) )/r;
     complex<double> C_m = 1.;
     if( imode > 0 ) {
         C_m = 2.;
@@ -686,10 +686,10 @@ void ProjectorAM1OrderRuyten::ionizationCurrentsForTasks( double */*b_Jx*/, doub
 void ProjectorAM1OrderRuyten::currentsAndDensityWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool /*is_spectral*/, int ispec, int /*icell*/, int /*ipart_ref*/ )
 {
 
-    std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
-    std::vector<std::complex<double>> *array_eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
+    dynamics_buffer<int> *iold = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    dynamics_buffer<std::complex<double>> *array_eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
     ElectroMagnAM *emAM = static_cast<ElectroMagnAM *>( EMfields );
 
     for( int ipart=istart ; ipart<iend; ipart++ ) {
@@ -702,10 +702,10 @@ void ProjectorAM1OrderRuyten::currentsAndDensityWrapper( ElectroMagn *EMfields,
 // ---------------------------------------------------------------------------------------------------------------------
 void ProjectorAM1OrderRuyten::currentsAndDensityWrapperOnAMBuffers( ElectroMagn *EMfields, std::complex<double> *b_Jl, std::complex<double> *b_Jr, std::complex<double> *b_Jt, std::complex<double> *b_rhoAM, int bin_shift, int bdim0, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, int /*ipart_ref*/ )
 {
-    std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
-    std::vector<std::complex<double>> *array_eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
+    dynamics_buffer<int> *iold = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    dynamics_buffer<std::complex<double>> *array_eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
     ElectroMagnAM *emAM = static_cast<ElectroMagnAM *>( EMfields );
 
 
@@ -776,7 +776,7 @@ void ProjectorAM1OrderRuyten::currentsForTasks( ElectroMagnAM */*emAM*/, std::co
     // double zp = particles.position( 2, ipart );
     double rp = sqrt( particles.position( 1, ipart )*particles.position( 1, ipart )+particles.position( 2, ipart )*particles.position( 2, ipart ) );
     std::complex<double> theta_old = array_eitheta_old[0];
-    std::complex<double> eitheta = ( particles.position( 1, ipart ) + Icpx * particles.position( 2, ipart ) ) / rp ; //exp(i theta)
+    std::complex<double> eitheta = ( ( double )particles.position( 1, ipart ) + Icpx * ( double )particles.position( 2, ipart ) ) / rp ; //exp(i theta)
     e_bar = 1.;
     // locate the particle on the primal grid at current time-step & calculate coeff. S1
     xpn = particles.position( 0, ipart ) * dl_inv_;
@@ -927,10 +927,10 @@ void ProjectorAM1OrderRuyten::susceptibility( ElectroMagn *EMfields, Particles &
 
     double *Chi_envelope = &( *EMfields->Env_Chi_ )( 0 );
 
-    std::vector<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
-    std::vector<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
+    dynamics_buffer<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
 
 
     double gamma_ponderomotive, gamma0, gamma0_sq;
@@ -1029,10 +1029,10 @@ void ProjectorAM1OrderRuyten::susceptibilityOnBuffer( ElectroMagn */*EMfields*/,
 
     // double *Chi_envelope = &( *EMfields->Env_Chi_ )( 0 );
 
-    std::vector<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
-    std::vector<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
+    dynamics_buffer<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
 
 
     double gamma_ponderomotive, gamma0, gamma0_sq;
@@ -108,7 +108,7 @@ void ProjectorAM2Order::currents(   ElectroMagnAM *emAM,
 
     double rp = sqrt( particles.position( 1, ipart )*particles.position( 1, ipart )+particles.position( 2, ipart )*particles.position( 2, ipart ) );
     std::complex<double> eitheta_old = array_eitheta_old[0];
-    std::complex<double> eitheta = ( particles.position( 1, ipart ) + Icpx * particles.position( 2, ipart ) ) / rp ; //exp(i theta)
+    std::complex<double> eitheta = ( ( double )particles.position( 1, ipart ) + Icpx * ( double )particles.position( 2, ipart ) ) / rp ; //exp(i theta)
     e_bar = 1.;
     // locate the particle on the primal grid at current time-step & calculate coeff. S1
     xpn = particles.position( 0, ipart ) * dl_inv_;
@@ -287,7 +287,7 @@ void ProjectorAM2Order::basicForComplex( complex<double> *rhoj, Particles &parti
         }
     }
 
-    complex<double> e_theta = ( particles.position( 1, ipart ) + Icpx*particles.position( 2, ipart ) )/r;
+    complex<double> e_theta = ( ( double )particles.position( 1, ipart ) + Icpx*( double )particles.position( 2, ipart ) )/r;
     complex<double> C_m = 1.;
     if( imode > 0 ) {
         C_m = 2.;
@@ -364,7 +364,7 @@ void ProjectorAM2Order::basicForComplexOnBuffer( complex<double> *rhoj, Particle
         ERROR("This projector can be used only for charge density at the moment.");
     }
 
-    complex<double> e_theta = ( particles.position( 1, ipart ) + Icpx*particles.position( 2, ipart ) )/r;
+    complex<double> e_theta = ( ( double )particles.position( 1, ipart ) + Icpx*( double )particles.position( 2, ipart ) )/r;
     complex<double> C_m = 1.;
     if( imode > 0 ) {
         C_m = 2.;
@@ -692,10 +692,10 @@ void ProjectorAM2Order::ionizationCurrentsForTasks( double */*b_Jx*/, double */*
 void ProjectorAM2Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, bool /*is_spectral*/, int ispec, int /*icell*/, int /*ipart_ref*/ )
 {
 
-    std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
-    std::vector<std::complex<double>> *array_eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
+    dynamics_buffer<int> *iold = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    dynamics_buffer<std::complex<double>> *array_eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
     ElectroMagnAM *emAM = static_cast<ElectroMagnAM *>( EMfields );
 
     for( int ipart=istart ; ipart<iend; ipart++ ) {
@@ -708,10 +708,10 @@ void ProjectorAM2Order::currentsAndDensityWrapper( ElectroMagn *EMfields, Partic
 // ---------------------------------------------------------------------------------------------------------------------
 void ProjectorAM2Order::currentsAndDensityWrapperOnAMBuffers( ElectroMagn *EMfields, std::complex<double> *b_Jl, std::complex<double> *b_Jr, std::complex<double> *b_Jt, std::complex<double> *b_rhoAM, int bin_shift, int bdim0, Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, bool diag_flag, int /*ipart_ref*/ )
 {
-    std::vector<int> *iold = &( smpi->dynamics_iold[ithread] );
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
-    std::vector<std::complex<double>> *array_eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
+    dynamics_buffer<int> *iold = &( smpi->dynamics_iold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    dynamics_buffer<std::complex<double>> *array_eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
     ElectroMagnAM *emAM = static_cast<ElectroMagnAM *>( EMfields );
 
 
@@ -782,7 +782,7 @@ void ProjectorAM2Order::currentsForTasks( ElectroMagnAM */*emAM*/, std::complex<
     // double zp = particles.position( 2, ipart );
     double rp = sqrt( particles.position( 1, ipart )*particles.position( 1, ipart )+particles.position( 2, ipart )*particles.position( 2, ipart ) );
     std::complex<double> theta_old = array_eitheta_old[0];
-    std::complex<double> eitheta = ( particles.position( 1, ipart ) + Icpx * particles.position( 2, ipart ) ) / rp ; //exp(i theta)
+    std::complex<double> eitheta = ( ( double )particles.position( 1, ipart ) + Icpx * ( double )particles.position( 2, ipart ) ) / rp ; //exp(i theta)
     e_bar = 1.;
     // locate the particle on the primal grid at current time-step & calculate coeff. S1
     xpn = particles.position( 0, ipart ) * dl_inv_;
@@ -933,10 +933,10 @@ void ProjectorAM2Order::susceptibility( ElectroMagn *EMfields, Particles &partic
 
     double *Chi_envelope = &( *EMfields->Env_Chi_ )( 0 );
 
-    std::vector<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
-    std::vector<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
+    dynamics_buffer<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
 
 
     double gamma_ponderomotive, gamma0, gamma0_sq;
@@ -1039,10 +1039,10 @@ void ProjectorAM2Order::susceptibilityOnBuffer( ElectroMagn */*EMfields*/, doubl
 
     // double *Chi_envelope = &( *EMfields->Env_Chi_ )( 0 );
 
-    std::vector<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
-    std::vector<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
+    dynamics_buffer<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread] );
 
 
     double gamma_ponderomotive, gamma0, gamma0_sq;
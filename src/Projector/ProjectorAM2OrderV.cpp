@@ -96,10 +96,10 @@ void ProjectorAM2OrderV::currentsAndDensity( ElectroMagnAM *emAM,
     double *invR_local = &(invR_[jpom2]);
 
     // Pointer for GPU and vectorization on ARM processors
-    double * __restrict__ position_x = particles.getPtrPosition(0);
-    double * __restrict__ position_y = particles.getPtrPosition(1);
-    double * __restrict__ position_z = particles.getPtrPosition(2);
-    double * __restrict__ weight     = particles.getPtrWeight();
+    particle_real * __restrict__ position_x = particles.getPtrPosition(0);
+    particle_real * __restrict__ position_y = particles.getPtrPosition(1);
+    particle_real * __restrict__ position_z = particles.getPtrPosition(2);
+    particle_real * __restrict__ weight     = particles.getPtrWeight();
     short  * __restrict__ charge     = particles.getPtrCharge();
     int * __restrict__ cell_keys  = particles.getPtrCellKeys();
 
@@ -186,7 +186,7 @@ void ProjectorAM2OrderV::basicForComplex( complex<double> *rhoj, Particles &part
         }
     }
 
-    complex<double> e_theta = ( particles.position( 1, ipart ) + Icpx*particles.position( 2, ipart ) )/r;
+    complex<double> e_theta = ( ( double )particles.position( 1, ipart ) + Icpx*( double )particles.position( 2, ipart ) )/r;
     complex<double> C_m = 1.;
     if( imode > 0 ) {
         C_m = 2.;
@@ -488,12 +488,12 @@ void ProjectorAM2OrderV::currents( ElectroMagnAM *emAM,
     double *invRd_local = &(invRd_[jpom2]);
 
     // Pointer for GPU and vectorization on ARM processors
-    double * __restrict__ position_x = particles.getPtrPosition(0);
-    double * __restrict__ position_y = particles.getPtrPosition(1);
-    double * __restrict__ position_z = particles.getPtrPosition(2);
-    double * __restrict__ momentum_y = particles.getPtrMomentum(1);
-    double * __restrict__ momentum_z = particles.getPtrMomentum(2);
-    double * __restrict__ weight     = particles.getPtrWeight();
+    particle_real * __restrict__ position_x = particles.getPtrPosition(0);
+    particle_real * __restrict__ position_y = particles.getPtrPosition(1);
+    particle_real * __restrict__ position_z = particles.getPtrPosition(2);
+    particle_real * __restrict__ momentum_y = particles.getPtrMomentum(1);
+    particle_real * __restrict__ momentum_z = particles.getPtrMomentum(2);
+    particle_real * __restrict__ weight     = particles.getPtrWeight();
     short  * __restrict__ charge     = particles.getPtrCharge();
     int * __restrict__ cell_keys  = particles.getPtrCellKeys();
 
@@ -624,9 +624,9 @@ void ProjectorAM2OrderV::currentsAndDensityWrapper( ElectroMagn *EMfields, Parti
 
     //Independent of cell. Should not be here
     //{
-    std::vector<double> *delta = &( smpi->dynamics_deltaold[ithread] );
-    std::vector<double> *invgf = &( smpi->dynamics_invgf[ithread] );
-    std::vector<std::complex<double>> *array_eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
+    dynamics_buffer<double> *delta = &( smpi->dynamics_deltaold[ithread] );
+    dynamics_buffer<double> *invgf = &( smpi->dynamics_invgf[ithread] );
+    dynamics_buffer<std::complex<double>> *array_eitheta_old = &( smpi->dynamics_eithetaold[ithread] );
     ElectroMagnAM *emAM = static_cast<ElectroMagnAM *>( EMfields );
 
 
@@ -671,9 +671,9 @@ void ProjectorAM2OrderV::susceptibility( ElectroMagn *EMfields, Particles &parti
     int vecSize = 8;
     int bsize = 5*5*vecSize; // Chi has only one mode //*Nmode_;
 
-    std::vector<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
-    std::vector<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Phipart     = &( smpi->dynamics_PHIpart[ithread] );
+    dynamics_buffer<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
     double * __restrict__ inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread][0] );
 
 
@@ -698,13 +698,13 @@ void ProjectorAM2OrderV::susceptibility( ElectroMagn *EMfields, Particles &parti
     // double r_bar[8] __attribute__( ( aligned( 64 ) ) );
 
     // Pointer for GPU and vectorization on ARM processors
-    double * __restrict__ position_x = particles.getPtrPosition(0);
-    double * __restrict__ position_y = particles.getPtrPosition(1);
-    double * __restrict__ position_z = particles.getPtrPosition(2);
-    double * __restrict__ momentum_x = particles.getPtrMomentum(0);
-    double * __restrict__ momentum_y = particles.getPtrMomentum(1);
-    double * __restrict__ momentum_z = particles.getPtrMomentum(2);
-    double * __restrict__ weight     = particles.getPtrWeight();
+    particle_real * __restrict__ position_x = particles.getPtrPosition(0);
+    particle_real * __restrict__ position_y = particles.getPtrPosition(1);
+    particle_real * __restrict__ position_z = particles.getPtrPosition(2);
+    particle_real * __restrict__ momentum_x = particles.getPtrMomentum(0);
+    particle_real * __restrict__ momentum_y = particles.getPtrMomentum(1);
+    particle_real * __restrict__ momentum_z = particles.getPtrMomentum(2);
+    particle_real * __restrict__ weight     = particles.getPtrWeight();
     short  * __restrict__ charge     = particles.getPtrCharge();
     //int * __restrict__ cell_keys  = particles.getPtrCellKeys();
 
@@ -49,9 +49,9 @@ public:
     
 private:
 
-    inline void __attribute__((always_inline)) compute_distances(  double * __restrict__ position_x,
-                                                                   double * __restrict__ position_y,
-                                                                   double * __restrict__ position_z,
+    inline void __attribute__((always_inline)) compute_distances(  particle_real * __restrict__ position_x,
+                                                                   particle_real * __restrict__ position_y,
+                                                                   particle_real * __restrict__ position_z,
                                                                    int * __restrict__,
                                                                    int npart_total, int ipart, int istart, int ipart_ref,
                                                                    double *deltaold, std::complex<double> *array_eitheta_old, int *iold,
@@ -118,7 +118,7 @@ private:
         DSr [4*vecSize+ipart] =                             p1* deltap  ;
 
         r_bar[ipart] = ((jpo + j_domain_begin_ + deltaold[istart+ipart-ipart_ref+npart_total])*dr + rp) * 0.5; // r at t = t0 - dt/2
-        std::complex<double> eitheta = ( position_y[istart+ipart] + Icpx * position_z[istart+ipart] ) / rp ; //exp(i theta)
+        std::complex<double> eitheta = ( ( double )position_y[istart+ipart] + Icpx * ( double )position_z[istart+ipart] ) / rp ; //exp(i theta)
         e_delta_m1[ipart] = std::sqrt(eitheta * (2.*std::real(array_eitheta_old[istart+ipart-ipart_ref]) - array_eitheta_old[istart+ipart-ipart_ref]));
         e_bar[ipart] = array_eitheta_old[istart+ipart-ipart_ref] * e_delta_m1[ipart];
 
@@ -220,8 +220,8 @@ private:
     }
  
     inline void __attribute__((always_inline)) computeJt( int ipart, 
-                                                                   double * __restrict__ momentum_y,
-                                                                   double * __restrict__ momentum_z,
+                                                                   particle_real * __restrict__ momentum_y,
+                                                                   particle_real * __restrict__ momentum_z,
                                                                    double *charge_weight,
                                                                    double *invgf,
                                                                    double *DSl, double *DSr, double *Sl0_buff_vect, double *Sr0_buff_vect,
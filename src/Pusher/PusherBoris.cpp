@@ -22,13 +22,13 @@ PusherBoris::~PusherBoris()
 
 void PusherBoris::operator()( Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, int ipart_buffer_offset )
 {
-    double *const __restrict__ position_x = particles.getPtrPosition( 0 );
-    double *const __restrict__ position_y = nDim_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
-    double *const __restrict__ position_z = nDim_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
+    particle_real *const __restrict__ position_x = particles.getPtrPosition( 0 );
+    particle_real *const __restrict__ position_y = nDim_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
+    particle_real *const __restrict__ position_z = nDim_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
 
-    double *const __restrict__ momentum_x = particles.getPtrMomentum( 0 );
-    double *const __restrict__ momentum_y = particles.getPtrMomentum( 1 );
-    double *const __restrict__ momentum_z = particles.getPtrMomentum( 2 );
+    particle_real *const __restrict__ momentum_x = particles.getPtrMomentum( 0 );
+    particle_real *const __restrict__ momentum_y = particles.getPtrMomentum( 1 );
+    particle_real *const __restrict__ momentum_z = particles.getPtrMomentum( 2 );
 
     const short *const __restrict__ charge = particles.getPtrCharge();
 
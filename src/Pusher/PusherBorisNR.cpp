@@ -20,8 +20,8 @@ PusherBorisNR::~PusherBorisNR()
 
 void PusherBorisNR::operator()( Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, int ipart_buffer_offset )
 {
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
 
     const int nparts = vecto ? Epart->size() / 3 :
                                particles.numberOfParticles(); // particles.size()
@@ -33,13 +33,13 @@ void PusherBorisNR::operator()( Particles &particles, SmileiMPI *smpi, int istar
     const double *const __restrict__ By = &( ( *Bpart )[1*nparts] );
     const double *const __restrict__ Bz = &( ( *Bpart )[2*nparts] );
 
-    double *const __restrict__ position_x = particles.getPtrPosition( 0 );
-    double *const __restrict__ position_y = nDim_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
-    double *const __restrict__ position_z = nDim_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
+    particle_real *const __restrict__ position_x = particles.getPtrPosition( 0 );
+    particle_real *const __restrict__ position_y = nDim_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
+    particle_real *const __restrict__ position_z = nDim_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
 
-    double *const __restrict__ momentum_x = particles.getPtrMomentum( 0 );
-    double *const __restrict__ momentum_y = particles.getPtrMomentum( 1 );
-    double *const __restrict__ momentum_z = particles.getPtrMomentum( 2 );
+    particle_real *const __restrict__ momentum_x = particles.getPtrMomentum( 0 );
+    particle_real *const __restrict__ momentum_y = particles.getPtrMomentum( 1 );
+    particle_real *const __restrict__ momentum_z = particles.getPtrMomentum( 2 );
 
     const short *const __restrict__ charge = particles.getPtrCharge();
 
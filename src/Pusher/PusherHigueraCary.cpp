@@ -31,8 +31,8 @@ PusherHigueraCary::~PusherHigueraCary()
 
 void PusherHigueraCary::operator()( Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, int ipart_buffer_offset )
 {
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
     
     const int nparts = smpi->getBufferSize(ithread);
     const double *const __restrict__ Ex = &( ( *Epart )[0*nparts] );
@@ -44,13 +44,13 @@ void PusherHigueraCary::operator()( Particles &particles, SmileiMPI *smpi, int i
 
     double * __restrict__ invgf = &( smpi->dynamics_invgf[ithread][0] );
 
-    double *const __restrict__ position_x = particles.getPtrPosition( 0 );
-    double *const __restrict__ position_y = nDim_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
-    double *const __restrict__ position_z = nDim_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
+    particle_real *const __restrict__ position_x = particles.getPtrPosition( 0 );
+    particle_real *const __restrict__ position_y = nDim_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
+    particle_real *const __restrict__ position_z = nDim_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
     
-    double *const __restrict__ momentum_x = particles.getPtrMomentum(0);
-    double *const __restrict__ momentum_y = particles.getPtrMomentum(1);
-    double *const __restrict__ momentum_z = particles.getPtrMomentum(2);
+    particle_real *const __restrict__ momentum_x = particles.getPtrMomentum(0);
+    particle_real *const __restrict__ momentum_y = particles.getPtrMomentum(1);
+    particle_real *const __restrict__ momentum_z = particles.getPtrMomentum(2);
 
     short *const __restrict__ charge = particles.getPtrCharge();
     
@@ -33,13 +33,13 @@ void PusherPhoton::operator()( Particles &particles, SmileiMPI *smpi,
     // Inverse normalized energy
     double * __restrict__ invgf = &( smpi->dynamics_invgf[ithread][0] );
 
-    double *const __restrict__ position_x = particles.getPtrPosition( 0 );
-    double *const __restrict__ position_y = nDim_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
-    double *const __restrict__ position_z = nDim_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
+    particle_real *const __restrict__ position_x = particles.getPtrPosition( 0 );
+    particle_real *const __restrict__ position_y = nDim_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
+    particle_real *const __restrict__ position_z = nDim_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
     
-    const double *const __restrict__ momentum_x = particles.getPtrMomentum(0);
-    const double *const __restrict__ momentum_y = particles.getPtrMomentum(1);
-    const double *const __restrict__ momentum_z = particles.getPtrMomentum(2);
+    const particle_real *const __restrict__ momentum_x = particles.getPtrMomentum(0);
+    const particle_real *const __restrict__ momentum_y = particles.getPtrMomentum(1);
+    const particle_real *const __restrict__ momentum_z = particles.getPtrMomentum(2);
 
 #if defined( SMILEI_ACCELERATOR_GPU_OMP )
     const int istart_offset   = istart - ipart_ref;
@@ -23,11 +23,11 @@ PusherPonderomotiveBoris::~PusherPonderomotiveBoris()
 
 void PusherPonderomotiveBoris::operator()( Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, int ipart_buffer_offset )
 {
-    std::vector<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart       = &( smpi->dynamics_Bpart[ithread] );
-    std::vector<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
+    dynamics_buffer<double> *Epart       = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart       = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *GradPhipart = &( smpi->dynamics_GradPHIpart[ithread] );
     double *dynamics_inv_gamma_ponderomotive = &( smpi->dynamics_inv_gamma_ponderomotive[ithread][0] );
-    std::vector<double> *extBpart       = &( smpi->dynamics_external_Bpart[ithread] );
+    dynamics_buffer<double> *extBpart       = &( smpi->dynamics_external_Bpart[ithread] );
 
     double charge_over_mass_dts2, charge_sq_over_mass_sq_dts4;
     double umx, umy, umz, upx, upy, upz;
@@ -36,9 +36,9 @@ void PusherPonderomotiveBoris::operator()( Particles &particles, SmileiMPI *smpi
     double pxsm, pysm, pzsm;
     //double one_ov_gamma_ponderomotive;
     
-    double *const __restrict__ momentum_x = particles.getPtrMomentum(0);
-    double *const __restrict__ momentum_y = particles.getPtrMomentum(1);
-    double *const __restrict__ momentum_z = particles.getPtrMomentum(2);
+    particle_real *const __restrict__ momentum_x = particles.getPtrMomentum(0);
+    particle_real *const __restrict__ momentum_y = particles.getPtrMomentum(1);
+    particle_real *const __restrict__ momentum_z = particles.getPtrMomentum(2);
     
     short *const charge = particles.getPtrCharge();
     
@@ -24,8 +24,8 @@ PusherPonderomotivePositionBoris::~PusherPonderomotivePositionBoris()
 void PusherPonderomotivePositionBoris::operator()( Particles &particles, SmileiMPI *smpi, int istart, int iend, int ithread, int ipart_buffer_offset )
 {
 
-    std::vector<double> *Phi_mpart     = &( smpi->dynamics_PHI_mpart[ithread] );
-    std::vector<double> *GradPhi_mpart = &( smpi->dynamics_GradPHI_mpart[ithread] );
+    dynamics_buffer<double> *Phi_mpart     = &( smpi->dynamics_PHI_mpart[ithread] );
+    dynamics_buffer<double> *GradPhi_mpart = &( smpi->dynamics_GradPHI_mpart[ithread] );
     double *invgf = &( smpi->dynamics_invgf[ithread][0] );
     
     
@@ -33,13 +33,13 @@ void PusherPonderomotivePositionBoris::operator()( Particles &particles, SmileiM
     double gamma0, gamma0_sq, gamma_ponderomotive;
     double pxsm, pysm, pzsm;
     
-    double *const __restrict__ momentum_x = particles.getPtrMomentum(0);
-    double *const __restrict__ momentum_y = particles.getPtrMomentum(1);
-    double *const __restrict__ momentum_z = particles.getPtrMomentum(2);
+    particle_real *const __restrict__ momentum_x = particles.getPtrMomentum(0);
+    particle_real *const __restrict__ momentum_y = particles.getPtrMomentum(1);
+    particle_real *const __restrict__ momentum_z = particles.getPtrMomentum(2);
     
-    double *const __restrict__ position_x = particles.getPtrPosition( 0 );
-    double *const __restrict__ position_y = nDim_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
-    double *const __restrict__ position_z = nDim_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
+    particle_real *const __restrict__ position_x = particles.getPtrPosition( 0 );
+    particle_real *const __restrict__ position_y = nDim_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
+    particle_real *const __restrict__ position_z = nDim_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
     
     const short *const charge = particles.getPtrCharge( ) ;
     
@@ -30,6 +30,18 @@ def _prepare_checkpoint_dir():
                 _mkdir("checkpoint", group_dir)
         else:
             _mkdir("checkpoint", checkpoint_dir)
+    # Node-local tier of the checkpoints: each process prepares its own directory, as
+    # the processes of the other nodes cannot see it
+    if Checkpoints.local_dir and (Checkpoints.dump_step>0 or Checkpoints.dump_minutes>0.):
+        local_dir = Checkpoints.local_dir + os.sep + "checkpoints" + os.sep
+        if Checkpoints.file_grouping:
+            ngroups = int((smilei_mpi_size-1)/Checkpoints.file_grouping + 1)
+            ngroups_chars = int(math.log10(ngroups))+1
+            local_dir += '%0*d'%(ngroups_chars,int(smilei_mpi_rank/Checkpoints.file_grouping))
+        try:
+            os.makedirs(local_dir, exist_ok=True)
+        except:
+            raise Exception("ERROR in the namelist: checkpoint local_dir "+local_dir+" cannot be created")
 
 def _smilei_check():
     """Do checks over the script"""
@@ -52,18 +64,34 @@ def _smilei_check():
     if len(Checkpoints)==1 and Checkpoints.restart_dir:
         if len(Checkpoints.restart_files) == 0 :
             Checkpoints.restart = True
-            pattern = Checkpoints.restart_dir + os.sep + "checkpoints" + os.sep
-            if Checkpoints.file_grouping:
-                pattern += "*"+ os.sep
-            pattern += "dump-*-*.h5"
-            # pick those file that match the mpi rank
-            files = filter(lambda a: smilei_mpi_rank==int(search(r'dump-[0-9]*-([0-9]*).h5$',a).groups()[-1]), glob(pattern))
+            def dump_pattern(dir):
+                pattern = dir + os.sep + "checkpoints" + os.sep
+                if Checkpoints.file_grouping:
+                    pattern += "*"+ os.sep
+                return pattern + "dump-*-*.h5"
+            pattern = dump_pattern(Checkpoints.restart_dir)
+            # The checkpoints may also be found in the node-local tier
+            patterns = [pattern]
+            if Checkpoints.local_dir:
+                patterns += [dump_pattern(Checkpoints.local_dir)]
+            
+            def rank_files(rank):
+                # pick those file that match the mpi rank
+                files = filter(lambda a: rank==int(search(r'dump-[0-9]*-([0-9]*).h5$',a).groups()[-1]), sum([glob(p) for p in patterns], []))
+                
+                if Checkpoints.restart_number is not None:
+                    # pick those file that match the restart_number
+                    files = filter(lambda a: Checkpoints.restart_number==int(search(r'dump-([0-9]*)-[0-9]*.h5$',a).groups()[-1]), files)
+                
+                return list(files)
             
-            if Checkpoints.restart_number is not None:
-                # pick those file that match the restart_number
-                files = filter(lambda a: Checkpoints.restart_number==int(search(r'dump-([0-9]*)-[0-9]*.h5$',a).groups()[-1]), files)
+            Checkpoints.restart_files = rank_files(smilei_mpi_rank)
             
-            Checkpoints.restart_files = list(files)
+            # If the dump was written by fewer processes, start from the files of the first one,
+            # which hold the global data (the patches are then read from the appropriate files).
+            # The choice depends on the number of processes recorded in each dump (see Checkpoint)
+            if smilei_mpi_rank > 0:
+                Checkpoints.restart_files += rank_files(0)
             
             if len(Checkpoints.restart_files) == 0:
                 raise Exception(
@@ -183,6 +211,76 @@ def _keep_python_running():
     # else False
     return False
 
+# Translates a simple function of the particles (e.g. a DiagTrackParticles filter) into
+# an expression that Smilei can evaluate natively, such as "((p.px > 0.1) & (p.x < 10.0))".
+# The bytecode is read because the source code of the namelist is not available.
+# Returns None when the function contains anything else than attributes of its argument,
+# numbers, operators and calls to numpy or math functions.
+def _particle_expression(function):
+    import dis, types, builtins
+    try:
+        code = function.__code__
+        if not isinstance(function, types.FunctionType) or code.co_argcount != 1 \
+          or code.co_kwonlyargcount != 0 or code.co_flags & (0x04|0x08|0x20|0x80|0x100|0x200):
+            return None
+        argument = code.co_varnames[0]
+        closure = dict(zip(code.co_freevars, [c.cell_contents for c in function.__closure__ or []]))
+        binary = {"BINARY_ADD":"+", "BINARY_SUBTRACT":"-", "BINARY_MULTIPLY":"*", "BINARY_TRUE_DIVIDE":"/",
+            "BINARY_FLOOR_DIVIDE":"//", "BINARY_MODULO":"%", "BINARY_POWER":"**",
+            "BINARY_AND":"&", "BINARY_OR":"|", "BINARY_XOR":"^"}
+        unary = {"UNARY_NEGATIVE":"-", "UNARY_POSITIVE":"+", "UNARY_INVERT":"~"}
+        def constant(value):
+            if isinstance(value, types.ModuleType) and value.__name__ in ["numpy", "math"]:
+                return value.__name__
+            if value is abs:
+                return "abs"
+            if type(value) is bool or (isinstance(value, (int, float)) and math.isfinite(value)):
+                return repr(value) if type(value) is bool else repr(float(value))
+            raise ValueError()
+        stack = []
+        for ins in dis.get_instructions(function):
+            op = ins.opname
+            if op in ["RESUME", "NOP", "CACHE", "PRECALL", "PUSH_NULL", "COPY_FREE_VARS", "EXTENDED_ARG"]:
+                continue
+            elif op.startswith("LOAD_FAST"):
+                names = ins.argval if type(ins.argval) is tuple else (ins.argval,)
+                if any([name != argument for name in names]):
+                    return None
+                stack += ["p"] * len(names)
+            elif op in ["LOAD_CONST", "LOAD_SMALL_INT"]:
+                stack += [constant(ins.argval)]
+            elif op in ["LOAD_GLOBAL", "LOAD_NAME"]:
+                if ins.argval in function.__globals__:
+                    stack += [constant(function.__globals__[ins.argval])]
+                else:
+                    stack += [constant(getattr(builtins, ins.argval))]
+            elif op == "LOAD_DEREF":
+                stack += [constant(closure[ins.argval])]
+            elif op in ["LOAD_ATTR", "LOAD_METHOD"]:
+                stack += [stack.pop() + "." + ins.argval]
+            elif op == "COMPARE_OP":
+                b, a = stack.pop(), stack.pop()
+                stack += ["(" + a + " " + str(ins.argval).replace("bool(", "").rstrip(")") + " " + b + ")"]
+            elif op == "BINARY_OP" or op in binary:
+                symbol = binary[op] if op in binary else ins.argrepr
+                if symbol.endswith("=") or "[" in symbol:
+                    return None
+                b, a = stack.pop(), stack.pop()
+                stack += ["(" + a + " " + symbol + " " + b + ")"]
+            elif op in unary:
+                stack += ["(" + unary[op] + stack.pop() + ")"]
+            elif op in ["CALL", "CALL_FUNCTION", "CALL_METHOD"]:
+                arguments = stack[len(stack)-ins.arg:]
+                del stack[len(stack)-ins.arg:]
+                stack += [stack.pop() + "(" + ", ".join(arguments) + ")"]
+            elif op == "RETURN_VALUE":
+                return stack[0] if len(stack) == 1 else None
+            else:
+                return None
+    except Exception:
+        pass
+    return None
+
 # Prevent creating new components (by mistake)
 def _noNewComponents(cls, *args, **kwargs):
     print("Please do not create a new "+cls.__name__)
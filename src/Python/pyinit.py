@@ -169,6 +169,10 @@ class Main(SmileiSingleton):
     custom_oversize = 2
     number_of_patches = None
     patch_arrangement = "hilbertian"
+    particle_exchange = "per_dimension"
+    field_exchange = "per_patch"
+    shared_memory_exchange = False
+    patch_scheduling = "runtime"
     cluster_width = -1
     every_clean_particles_overhead = 100
     timestep = None
@@ -331,6 +335,12 @@ class LoadBalancing(SmileiSingleton):
     initial_balance      = True
     cell_load            = 1.0
     frozen_particle_load = 0.1
+    load_model           = "particles"
+    measured_load_smoothing = 0.5
+    imbalance_threshold  = 0.
+    migration_budget     = 0.
+    hierarchical         = False
+    node_imbalance_tolerance = 0.1
 
 class MultipleDecomposition(SmileiSingleton):
     """Multiple Decomposition parameters"""
@@ -366,6 +376,8 @@ class Checkpoints(SmileiSingleton):
     dump_deflate = 0
     exit_after_dump = True
     file_grouping = 0
+    asynchronous = False
+    local_dir = None
     restart_files = []
 
 class CurrentFilter(SmileiSingleton):
@@ -512,6 +524,9 @@ class DiagProbe(SmileiComponent):
     flush_every = 1
     time_integral = False
     datatype = "double"
+    lossy = None
+    tolerance = 0.
+    deflate = None
 
 class DiagParticleBinning(SmileiComponent):
     """Particle Binning diagnostic"""
@@ -562,6 +577,10 @@ class DiagFields(SmileiComponent):
     subgrid = None
     flush_every = 1
     datatype = "double"
+    lossy = None
+    tolerance = 0.
+    deflate = None
+    asynchronous = False
 
 class DiagTrackParticles(SmileiComponent):
     """Track diagnostic"""
@@ -571,6 +590,8 @@ class DiagTrackParticles(SmileiComponent):
     flush_every = 1
     filter = None
     attributes = ["x", "y", "z", "px", "py", "pz", "w"]
+    layout = "per_iteration"
+    ranks_per_file = 1
 
 class DiagNewParticles(SmileiComponent):
     """Track diagnostic"""
@@ -68,8 +68,8 @@ void Radiation::computeParticlesChi( Particles &particles,
 {
     // _______________________________________________________________
     // Parameters
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
 
     int nparts = smpi->getBufferSize(ithread);
     double *Ex = &( ( *Epart )[0*nparts] );
@@ -89,7 +89,7 @@ void Radiation::computeParticlesChi( Particles &particles,
     double gamma;
 
     // Momentum shortcut
-    double *momentum[3];
+    particle_real *momentum[3];
     for( int i = 0 ; i<3 ; i++ ) {
         momentum[i] =  &( particles.momentum( i, 0 ) );
     }
@@ -98,7 +98,7 @@ void Radiation::computeParticlesChi( Particles &particles,
     short *charge = &( particles.charge( 0 ) );
 
     // Quantum parameter
-    double *chi = &( particles.chi( 0 ) );
+    particle_real *chi = &( particles.chi( 0 ) );
 
     // _______________________________________________________________
     // Computation
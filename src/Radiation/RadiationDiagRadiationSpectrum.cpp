@@ -56,8 +56,8 @@ void RadiationDiagRadiationSpectrum::operator() (
 
     // _______________________________________________________________
     // Parameters
-    std::vector<double> *Epart = &(smpi->dynamics_Epart[ithread]);
-    std::vector<double> *Bpart = &(smpi->dynamics_Bpart[ithread]);
+    dynamics_buffer<double> *Epart = &(smpi->dynamics_Epart[ithread]);
+    dynamics_buffer<double> *Bpart = &(smpi->dynamics_Bpart[ithread]);
     //std::vector<double> *invgf = &(smpi->dynamics_invgf[ithread]);
 
     int nparts = smpi->getBufferSize(ithread);
@@ -78,7 +78,7 @@ void RadiationDiagRadiationSpectrum::operator() (
     double gamma;
 
     // Momentum shortcut
-    double* momentum[3];
+    particle_real* momentum[3];
     for ( int i = 0 ; i<3 ; i++ )
         momentum[i] =  &( particles.momentum(i,0) );
 
@@ -86,7 +86,7 @@ void RadiationDiagRadiationSpectrum::operator() (
     short* charge = &( particles.charge(0) );
 
     // Optical depth for the Monte-Carlo process
-    double* chi = &( particles.chi(0));
+    particle_real* chi = &( particles.chi(0));
 
     // _______________________________________________________________
     // Computation
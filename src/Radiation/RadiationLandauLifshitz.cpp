@@ -58,8 +58,8 @@ void RadiationLandauLifshitz::operator()(
 
     // _______________________________________________________________
     // Parameters
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
     //std::vector<double> *invgf = &(smpi->dynamics_invgf[ithread]);
 
     const int nparts = smpi->getBufferSize(ithread);
@@ -77,18 +77,18 @@ void RadiationLandauLifshitz::operator()(
     const double minimum_chi_continuous = radiation_tables.getMinimumChiContinuous();
 
     // Momentum shortcut
-    double *const __restrict__ momentum_x = particles.getPtrMomentum(0);
-    double *const __restrict__ momentum_y = particles.getPtrMomentum(1);
-    double *const __restrict__ momentum_z = particles.getPtrMomentum(2);
+    particle_real *const __restrict__ momentum_x = particles.getPtrMomentum(0);
+    particle_real *const __restrict__ momentum_y = particles.getPtrMomentum(1);
+    particle_real *const __restrict__ momentum_z = particles.getPtrMomentum(2);
 
     // Charge shortcut
     const short  *const __restrict__ charge = particles.getPtrCharge();
 
     // Weight shortcut
-    const double *const __restrict__ weight = particles.getPtrWeight();
+    const particle_real *const __restrict__ weight = particles.getPtrWeight();
 
     // Optical depth for the Monte-Carlo process
-    double *const __restrict__ chi = particles.getPtrChi();
+    particle_real *const __restrict__ chi = particles.getPtrChi();
 
     // cumulative Radiated energy from istart to iend
     double radiated_energy_loc = 0;
@@ -79,8 +79,8 @@ void RadiationMonteCarlo::operator()(
     // _______________________________________________________________
     // Parameters
 
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
     //std::vector<double> *invgf = &(smpi->dynamics_invgf[ithread]);
 
     // Total number of particles
@@ -126,26 +126,26 @@ void RadiationMonteCarlo::operator()(
     // Particle properties ----------------------------------------------------------------
 
     // Particles position shortcut
-    double *const __restrict__ position_x = particles.getPtrPosition( 0 );
-    double *const __restrict__ position_y = nDim_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
-    double *const __restrict__ position_z = nDim_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
+    particle_real *const __restrict__ position_x = particles.getPtrPosition( 0 );
+    particle_real *const __restrict__ position_y = nDim_ > 1 ? particles.getPtrPosition( 1 ) : nullptr;
+    particle_real *const __restrict__ position_z = nDim_ > 2 ? particles.getPtrPosition( 2 ) : nullptr;
 
     // Particles Momentum shortcut
-    double *const __restrict__ momentum_x = particles.getPtrMomentum(0);
-    double *const __restrict__ momentum_y = particles.getPtrMomentum(1);
-    double *const __restrict__ momentum_z = particles.getPtrMomentum(2);
+    particle_real *const __restrict__ momentum_x = particles.getPtrMomentum(0);
+    particle_real *const __restrict__ momentum_y = particles.getPtrMomentum(1);
+    particle_real *const __restrict__ momentum_z = particles.getPtrMomentum(2);
 
     // Charge shortcut
     const short *const __restrict__ charge = particles.getPtrCharge();
 
     // Weight shortcut
-    const double *const __restrict__ weight = particles.getPtrWeight();
+    const particle_real *const __restrict__ weight = particles.getPtrWeight();
 
     // Optical depth for the Monte-Carlo process
-    double *const __restrict__ tau = particles.getPtrTau();
+    particle_real *const __restrict__ tau = particles.getPtrTau();
 
     // Quantum parameter
-    double *const __restrict__ chi = particles.getPtrChi();
+    particle_real *const __restrict__ chi = particles.getPtrChi();
 
     
     // Photon properties ----------------------------------------------------------------
@@ -179,25 +179,25 @@ void RadiationMonteCarlo::operator()(
     }
 
     // Photon position shortcut
-    double *const __restrict__ photon_position_x = photons ? photons->getPtrPosition( 0 ) : nullptr;
-    double *const __restrict__ photon_position_y = photons ? (nDim_ > 1 ? photons->getPtrPosition( 1 ) : nullptr) : nullptr;
-    double *const __restrict__ photon_position_z = photons ? (nDim_ > 2 ? photons->getPtrPosition( 2 ) : nullptr) : nullptr;
+    particle_real *const __restrict__ photon_position_x = photons ? photons->getPtrPosition( 0 ) : nullptr;
+    particle_real *const __restrict__ photon_position_y = photons ? (nDim_ > 1 ? photons->getPtrPosition( 1 ) : nullptr) : nullptr;
+    particle_real *const __restrict__ photon_position_z = photons ? (nDim_ > 2 ? photons->getPtrPosition( 2 ) : nullptr) : nullptr;
 
     // Particles Momentum shortcut
-    double *const __restrict__ photon_momentum_x = photons ? photons->getPtrMomentum(0) : nullptr;
-    double *const __restrict__ photon_momentum_y = photons ? photons->getPtrMomentum(1) : nullptr;
-    double *const __restrict__ photon_momentum_z = photons ? photons->getPtrMomentum(2) : nullptr;
+    particle_real *const __restrict__ photon_momentum_x = photons ? photons->getPtrMomentum(0) : nullptr;
+    particle_real *const __restrict__ photon_momentum_y = photons ? photons->getPtrMomentum(1) : nullptr;
+    particle_real *const __restrict__ photon_momentum_z = photons ? photons->getPtrMomentum(2) : nullptr;
 
     // Charge shortcut
     short *const __restrict__ photon_charge = photons ? photons->getPtrCharge() : nullptr;
 
     // Weight shortcut
-    double *const __restrict__ photon_weight = photons ? photons->getPtrWeight() : nullptr;
+    particle_real *const __restrict__ photon_weight = photons ? photons->getPtrWeight() : nullptr;
 
     // Quantum Parameter
-    double *const __restrict__ photon_chi_array = photons ? (photons->has_quantum_parameter ? photons->getPtrChi() : nullptr) : nullptr;
+    particle_real *const __restrict__ photon_chi_array = photons ? (photons->has_quantum_parameter ? photons->getPtrChi() : nullptr) : nullptr;
 
-    double *const __restrict__ photon_tau = photons ? (photons->has_Monte_Carlo_process ? photons->getPtrTau() : nullptr) : nullptr;
+    particle_real *const __restrict__ photon_tau = photons ? (photons->has_Monte_Carlo_process ? photons->getPtrTau() : nullptr) : nullptr;
 
 #ifdef SMILEI_ACCELERATOR_GPU_OACC
     // Cell keys as a mask
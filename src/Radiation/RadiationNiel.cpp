@@ -63,8 +63,8 @@ void RadiationNiel::operator()(
 
     // _______________________________________________________________
     // Parameters
-    std::vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-    std::vector<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
+    dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+    dynamics_buffer<double> *Bpart = &( smpi->dynamics_Bpart[ithread] );
 
     const int nparts = smpi->getBufferSize(ithread);
     const double *const __restrict__ Ex = &( ( *Epart )[0*nparts] );
@@ -103,18 +103,18 @@ void RadiationNiel::operator()(
     double * random_numbers = new double [nbparticles];
 
     // Momentum shortcut
-    double*const __restrict__ momentum_x = particles.getPtrMomentum(0);
-    double*const __restrict__ momentum_y = particles.getPtrMomentum(1);
-    double*const __restrict__ momentum_z = particles.getPtrMomentum(2);
+    particle_real*const __restrict__ momentum_x = particles.getPtrMomentum(0);
+    particle_real*const __restrict__ momentum_y = particles.getPtrMomentum(1);
+    particle_real*const __restrict__ momentum_z = particles.getPtrMomentum(2);
 
     // Charge shortcut
     const short*const __restrict__ charge = particles.getPtrCharge();
 
     // Weight shortcut
-    const double*const __restrict__ weight = particles.getPtrWeight();
+    const particle_real*const __restrict__ weight = particles.getPtrWeight();
 
     // Quantum parameter
-    double*const __restrict__ particle_chi = particles.getPtrChi();
+    particle_real*const __restrict__ particle_chi = particles.getPtrChi();
 
     // Niel table
     // double* table = &(RadiationTables.niel_.table_[0]);
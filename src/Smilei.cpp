@@ -205,7 +205,7 @@ int main( int argc, char *argv[] )
     // reading from dumped file the restart values
     if( params.restart ) {
         // smpi.patch_count recomputed in readPatchDistribution
-        checkpoint.readPatchDistribution( &smpi, simWindow );
+        checkpoint.readPatchDistribution( &smpi, simWindow, params );
         // allocate patches according to smpi.patch_count
         PatchesFactory::createVector( vecPatches, params, &smpi, openPMD, &radiation_tables_, checkpoint.this_run_start_step+1, simWindow->getNmoved() );
 
@@ -685,7 +685,7 @@ int main( int argc, char *argv[] )
 
         } //End omp parallel region
 
-        if( params.has_load_balancing && params.load_balancing_time_selection->theTimeIsNow( itime ) ) {
+        if( params.has_load_balancing && vecPatches.loadBalancingNow( params, &smpi, timers, itime ) ) {
 // #if defined( SMILEI_ACCELERATOR_GPU )
 //             ERROR( "Load balancing not tested on GPU !" );
 // #endif
@@ -749,6 +749,9 @@ int main( int argc, char *argv[] )
     
     }//END of the time loop
 
+    // Wait for the checkpoint files written in the background
+    checkpoint.waitDump();
+
     smpi.barrier();
 
     // ------------------------------------------------------------------
@@ -810,7 +813,7 @@ int executeTestMode( VectorPatch &vecPatches,
     int moving_window_movement = 0;
 
     if( params.restart ) {
-        checkpoint.readPatchDistribution( smpi, simWindow );
+        checkpoint.readPatchDistribution( smpi, simWindow, params );
         itime = checkpoint.this_run_start_step+1;
         moving_window_movement = simWindow->getNmoved();
     }
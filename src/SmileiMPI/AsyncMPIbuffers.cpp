@@ -3,7 +3,12 @@
 #include "ParticlesFactory.h"
 #include "Field.h"
 #include "Patch.h"
+#include "cField.h"
+#include "SmileiMPI.h"
+#include "SharedMemoryWindow.h"
 
+#include <algorithm>
+#include <cstring>
 #include <vector>
 using namespace std;
 
@@ -73,6 +78,9 @@ SpeciesMPIbuffers::~SpeciesMPIbuffers()
         delete partSend[i][0];
         delete partSend[i][1];
     }
+    for( size_t i=0 ; i<partSendAll.size() ; i++ ) {
+        delete partSendAll[i];
+    }
 }
 
 
@@ -109,5 +117,287 @@ void SpeciesMPIbuffers::allocate( Params &params, Patch *patch )
             partSend[i][1] = new Particles();
         }
     }
+    
+    // One buffer per surrounding patch (the patch itself, at the center, is skipped)
+    if( params.direct_particle_exchange ) {
+        unsigned int n_all = 1;
+        for( unsigned int i=0 ; i<params.nDim_field ; i++ ) {
+            n_all *= 3;
+        }
+        partSendAll.resize( n_all, nullptr );
+        for( unsigned int k=0 ; k<n_all ; k++ ) {
+            if( k != n_all/2 ) {
+                partSendAll[k] = new Particles();
+            }
+        }
+    }
+}
+
+
+
+const uint64_t AggregatedFieldMPIbuffers::no_offset;
+const int AggregatedFieldMPIbuffers::ack_tag_offset;
+
+AggregatedFieldMPIbuffers::AggregatedFieldMPIbuffers()
+{
+}
+
+
+AggregatedFieldMPIbuffers::~AggregatedFieldMPIbuffers()
+{
+    // Fields may outlive MPI, at the very end of the simulation
+    int finalized = 0;
+    MPI_Finalized( &finalized );
+    if( ! finalized ) {
+        for( size_t i=0 ; i<exchanges_.size() ; i++ ) {
+            waitAcknowledgements( exchanges_[i] );
+            freeRequests( exchanges_[i] );
+        }
+    }
+}
+
+
+void AggregatedFieldMPIbuffers::freeRequests( Exchange &exchange )
+{
+    for( size_t i=0 ; i<exchange.srequest.size() ; i++ ) {
+        if( exchange.srequest[i] != MPI_REQUEST_NULL ) {
+            MPI_Request_free( &exchange.srequest[i] );
+        }
+    }
+    for( size_t i=0 ; i<exchange.rrequest.size() ; i++ ) {
+        if( exchange.rrequest[i] != MPI_REQUEST_NULL ) {
+            MPI_Request_free( &exchange.rrequest[i] );
+        }
+    }
+    exchange.srequest.clear();
+    exchange.rrequest.clear();
+}
+
+
+void AggregatedFieldMPIbuffers::waitAcknowledgements( Exchange &exchange )
+{
+    if( exchange.ack_requests.size() > 0 ) {
+        MPI_Waitall( exchange.ack_requests.size(), exchange.ack_requests.data(), MPI_STATUSES_IGNORE );
+        exchange.ack_requests.clear();
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Sort the ghost regions bound to each neighbouring MPI process along iDim, and create one persistent send and one
+// persistent receive per process. The receiver computes its own offsets from the sizes of its recvFields_, in the
+// same (component, patch, side) order.
+// ---------------------------------------------------------------------------------------------------------------------
+void AggregatedFieldMPIbuffers::build( Exchange &exchange, std::vector<Field *> &fields, std::vector<Patch *> &patches, int iDim, int tag, SmileiMPI *smpi )
+{
+    waitAcknowledgements( exchange );
+    freeRequests( exchange );
+    exchange.send_blocks.clear();
+    exchange.recv_blocks.clear();
+
+    unsigned int nPatches = patches.size();
+    size_t element_size = ( fields.size() > 0 && dynamic_cast<cField *>( fields[0] ) ) ? sizeof( std::complex<double> ) : sizeof( double );
+    for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
+        Patch *patch = patches[ifield%nPatches];
+        for( int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+            if( ! patch->is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+                continue;
+            }
+            // Sent to the neighbour on side iNeighbor, which receives it on its opposite side
+            Block b;
+            b.rank   = patch->MPI_neighbor_[iDim][iNeighbor];
+            b.icomp  = ifield/nPatches;
+            b.ifield = ifield;
+            b.isub   = iDim*2+iNeighbor;
+            b.bytes  = fields[ifield]->sendFields_[b.isub]->size()*element_size;
+            b.data   = nullptr;
+            b.hindex = patch->neighbor_[iDim][iNeighbor];
+            b.side   = ( iNeighbor+1 )%2;
+            exchange.send_blocks.push_back( b );
+            // Received from the same neighbour
+            b.hindex = patch->hindex;
+            b.side   = iNeighbor;
+            exchange.recv_blocks.push_back( b );
+        }
+    }
+    sort( exchange.send_blocks.begin(), exchange.send_blocks.end() );
+    sort( exchange.recv_blocks.begin(), exchange.recv_blocks.end() );
+
+    // One buffer per neighbouring process, or a slot in the shared memory of this process
+    exchange.send_ranks.clear();
+    vector<size_t> send_bytes;
+    for( size_t i=0 ; i<exchange.send_blocks.size() ; i++ ) {
+        if( exchange.send_ranks.empty() || exchange.send_ranks.back() != exchange.send_blocks[i].rank ) {
+            exchange.send_ranks.push_back( exchange.send_blocks[i].rank );
+            send_bytes.push_back( 0 );
+        }
+        send_bytes.back() += exchange.send_blocks[i].bytes;
+    }
+    exchange.window = smpi->shared_field_window_;
+    exchange.comm   = smpi->field_exchange_comm_;
+    exchange.send_buffers.assign( exchange.send_ranks.size(), vector<char>() );
+    exchange.send_data   .assign( exchange.send_ranks.size(), nullptr );
+    exchange.send_offsets.assign( exchange.send_ranks.size(), no_offset );
+    vector<bool> on_node( exchange.send_ranks.size(), false );
+    size_t shared_bytes = 0;
+    for( size_t irank=0 ; irank<exchange.send_ranks.size() ; irank++ ) {
+        on_node[irank] = exchange.window && exchange.window->onNode( exchange.send_ranks[irank] ) && send_bytes[irank] > sizeof( uint64_t );
+        if( on_node[irank] ) {
+            shared_bytes += send_bytes[irank];
+        }
+    }
+    // The slot reserved by a previous layout of this epoch is reused if large enough, so that rebuilding
+    // the layout does not pile up reservations in the segment
+    bool slot_valid = exchange.slot_epoch == smpi->field_exchange_epoch_;
+    if( shared_bytes > 0 && ( ! slot_valid || exchange.slot_bytes < shared_bytes ) ) {
+        size_t slot_offset = 0;
+        slot_valid = exchange.window->reserve( shared_bytes, slot_offset );
+        exchange.slot_offset = slot_offset;
+        exchange.slot_bytes  = slot_valid ? shared_bytes : 0;
+        exchange.slot_epoch  = slot_valid ? smpi->field_exchange_epoch_ : -1;
+    }
+    size_t offset = exchange.slot_offset;
+    for( size_t irank=0 ; irank<exchange.send_ranks.size() ; irank++ ) {
+        if( on_node[irank] && slot_valid ) {
+            exchange.send_offsets[irank] = offset;
+            exchange.send_data[irank] = exchange.window->segment( smpi->smilei_rk ) + offset;
+            offset += send_bytes[irank];
+        } else {
+            exchange.send_buffers[irank].resize( send_bytes[irank] );
+            exchange.send_data[irank] = exchange.send_buffers[irank].data();
+        }
+    }
+    exchange.recv_ranks.clear();
+    exchange.recv_buffers.clear();
+    for( size_t i=0 ; i<exchange.recv_blocks.size() ; i++ ) {
+        if( exchange.recv_ranks.empty() || exchange.recv_ranks.back() != exchange.recv_blocks[i].rank ) {
+            exchange.recv_ranks.push_back( exchange.recv_blocks[i].rank );
+            exchange.recv_buffers.push_back( vector<char>() );
+        }
+        exchange.recv_buffers.back().resize( exchange.recv_buffers.back().size() + exchange.recv_blocks[i].bytes );
+    }
+
+    exchange.srequest.resize( exchange.send_ranks.size(), MPI_REQUEST_NULL );
+    for( size_t irank=0 ; irank<exchange.send_ranks.size() ; irank++ ) {
+        if( exchange.send_offsets[irank] != no_offset ) {
+            // Only the offset of the data in the shared memory
+            MPI_Send_init( &exchange.send_offsets[irank], sizeof( uint64_t ), MPI_BYTE,
+                           exchange.send_ranks[irank], tag, smpi->field_exchange_comm_, &exchange.srequest[irank] );
+        } else {
+            MPI_Send_init( exchange.send_buffers[irank].data(), exchange.send_buffers[irank].size(), MPI_BYTE,
+                           exchange.send_ranks[irank], tag, smpi->field_exchange_comm_, &exchange.srequest[irank] );
+        }
+    }
+    exchange.rrequest.resize( exchange.recv_ranks.size(), MPI_REQUEST_NULL );
+    for( size_t irank=0 ; irank<exchange.recv_ranks.size() ; irank++ ) {
+        MPI_Recv_init( exchange.recv_buffers[irank].data(), exchange.recv_buffers[irank].size(), MPI_BYTE,
+                       exchange.recv_ranks[irank], tag, smpi->field_exchange_comm_, &exchange.rrequest[irank] );
+    }
+
+    exchange.nfields  = fields.size();
+    exchange.npatches = patches.size();
+    exchange.epoch    = smpi->field_exchange_epoch_;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Pack the ghost regions in the messages of the current epoch, and start them
+// ---------------------------------------------------------------------------------------------------------------------
+void AggregatedFieldMPIbuffers::init( std::vector<Field *> &fields, std::vector<Patch *> &patches, int iDim, int tag, SmileiMPI *smpi )
+{
+    // Called at the same point by all processes, so that the shared memory can be reallocated collectively
+    smpi->sharedFieldWindow();
+
+    if( exchanges_.size() <= ( size_t )tag ) {
+        exchanges_.resize( tag+1 );
+    }
+    Exchange &exchange = exchanges_[tag];
+    // The data packed in shared memory by the previous exchange must have been read
+    waitAcknowledgements( exchange );
+    if( exchange.epoch != smpi->field_exchange_epoch_
+        || exchange.nfields != fields.size() || exchange.npatches != patches.size() ) {
+        build( exchange, fields, patches, iDim, tag, smpi );
+    }
+
+    // Sub-fields may be reallocated when a field is exchanged with another ghost size (sum, then exchange):
+    // their addresses are refreshed at each exchange
+    bool is_complex = fields.size() > 0 && dynamic_cast<cField *>( fields[0] );
+    for( size_t i=0 ; i<exchange.recv_blocks.size() ; i++ ) {
+        Field *recv = fields[exchange.recv_blocks[i].ifield]->recvFields_[exchange.recv_blocks[i].isub];
+        exchange.recv_blocks[i].data = is_complex ? reinterpret_cast<char *>( static_cast<cField *>( recv )->cdata_ )
+                                                  : reinterpret_cast<char *>( recv->data_ );
+    }
+    if( exchange.rrequest.size() > 0 ) {
+        MPI_Startall( exchange.rrequest.size(), exchange.rrequest.data() );
+    }
+
+    size_t ib = 0;
+    bool any_shared = false;
+    for( size_t irank=0 ; irank<exchange.send_ranks.size() ; irank++ ) {
+        size_t offset = 0;
+        for( ; ib<exchange.send_blocks.size() && exchange.send_blocks[ib].rank == exchange.send_ranks[irank] ; ib++ ) {
+            Field *send = fields[exchange.send_blocks[ib].ifield]->sendFields_[exchange.send_blocks[ib].isub];
+            const char *data = is_complex ? reinterpret_cast<char *>( static_cast<cField *>( send )->cdata_ )
+                                          : reinterpret_cast<char *>( send->data_ );
+            memcpy( exchange.send_data[irank] + offset, data, exchange.send_blocks[ib].bytes );
+            offset += exchange.send_blocks[ib].bytes;
+        }
+        any_shared = any_shared || exchange.send_offsets[irank] != no_offset;
+    }
+    if( any_shared ) {
+        exchange.window->sync();
+    }
+    if( exchange.srequest.size() > 0 ) {
+        MPI_Startall( exchange.srequest.size(), exchange.srequest.data() );
+    }
+
+    exchange.active = true;
 }
 
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Wait for the messages of the exchange and copy each block in the recvFields_ it belongs to
+// ---------------------------------------------------------------------------------------------------------------------
+void AggregatedFieldMPIbuffers::finalize( int tag )
+{
+    Exchange &exchange = exchanges_[tag];
+
+    vector<MPI_Status> status( exchange.rrequest.size() );
+    MPI_Waitall( exchange.rrequest.size(), exchange.rrequest.data(), status.data() );
+    bool synced = false;
+    size_t ib = 0;
+    for( size_t irank=0 ; irank<exchange.recv_ranks.size() ; irank++ ) {
+        // A message shorter than expected holds the offset of the data in the shared memory of the sender
+        const char *message = exchange.recv_buffers[irank].data();
+        int count;
+        MPI_Get_count( &status[irank], MPI_BYTE, &count );
+        bool shared = ( size_t )count < exchange.recv_buffers[irank].size();
+        if( shared ) {
+            if( ! synced ) {
+                exchange.window->sync();
+                synced = true;
+            }
+            uint64_t offset;
+            memcpy( &offset, message, sizeof( uint64_t ) );
+            message = exchange.window->segment( exchange.recv_ranks[irank] ) + offset;
+        }
+        size_t offset = 0;
+        for( ; ib<exchange.recv_blocks.size() && exchange.recv_blocks[ib].rank == exchange.recv_ranks[irank] ; ib++ ) {
+            memcpy( exchange.recv_blocks[ib].data, message + offset, exchange.recv_blocks[ib].bytes );
+            offset += exchange.recv_blocks[ib].bytes;
+        }
+        if( shared ) {
+            exchange.ack_requests.push_back( MPI_REQUEST_NULL );
+            MPI_Isend( NULL, 0, MPI_BYTE, exchange.recv_ranks[irank], tag+ack_tag_offset, exchange.comm, &exchange.ack_requests.back() );
+        }
+    }
+    MPI_Waitall( exchange.srequest.size(), exchange.srequest.data(), MPI_STATUSES_IGNORE );
+    // Acknowledgements are received in the same order as they are sent, the exchanges being finalized in the
+    // same order by all processes
+    for( size_t irank=0 ; irank<exchange.send_ranks.size() ; irank++ ) {
+        if( exchange.send_offsets[irank] != no_offset ) {
+            exchange.ack_requests.push_back( MPI_REQUEST_NULL );
+            MPI_Irecv( NULL, 0, MPI_BYTE, exchange.send_ranks[irank], tag+ack_tag_offset, exchange.comm, &exchange.ack_requests.back() );
+        }
+    }
+}
@@ -4,12 +4,14 @@
 #include <mpi.h>
 #include <vector>
 #include <complex>
+#include <cstdint>
 
 #include "Particles.h"
 
 class Field;
 class Patch;
 class SmileiMPI;
+class SharedMemoryWindow;
 
 class AsyncMPIbuffers
 {
@@ -45,6 +47,10 @@ public:
     //! ndim vectors of 2 received packets of particles (1 per direction)
     std::vector< std::vector<Particles* > > partSend;
     
+    //! 3^ndim packets of particles sent to all the surrounding patches (faces, edges and corners),
+    //! indexed as Patch::all_neighbor_. Only allocated for Main.particle_exchange="direct"
+    std::vector< Particles* > partSendAll;
+    
     //! ndim vectors of 2 numbers of particles to send (1 per direction)
     std::vector< std::vector< unsigned int > > partSendSize;
     //! ndim vectors of 2 numbers of particles to receive (1 per direction)
@@ -52,5 +58,110 @@ public:
     
 };
 
+//! Per-species state of the direct particle exchange between MPI processes (Main.particle_exchange="direct"):
+//! one message per neighbouring process, holding blocks of particles for each destination patch
+class DirectParticleMPIbuffers
+{
+public:
+    //! Neighbouring MPI processes of the current exchange
+    std::vector<int> ranks;
+    //! One packed message per neighbouring process
+    std::vector< std::vector<char> > send_buffers;
+    std::vector<MPI_Request> srequest;
+    //! Message being unpacked
+    std::vector<char> recv_buffer;
+};
+
+//! Ghost regions of a list of fields exchanged with one message per neighbouring MPI process and
+//! per dimension (Main.field_exchange="aggregated"), instead of one message per patch and per side.
+//! The blocks of a message are ordered by component, destination patch and side on both processes,
+//! so that no header is needed. The messages use persistent requests, created once per topology
+//! epoch (see SmileiMPI::invalidateFieldExchanges) and restarted at each exchange.
+//! With Main.shared_memory_exchange, the message towards a process of the same node is packed in the
+//! shared memory window of the sender and unpacked from there by the receiver: the persistent request
+//! then only carries its offset, and the receiver acknowledges the reading.
+class AggregatedFieldMPIbuffers
+{
+public:
+    AggregatedFieldMPIbuffers();
+    ~AggregatedFieldMPIbuffers();
+    //! The persistent requests are owned by one field: a copied field starts without any
+    AggregatedFieldMPIbuffers( const AggregatedFieldMPIbuffers & ) {}
+    AggregatedFieldMPIbuffers &operator=( const AggregatedFieldMPIbuffers & )
+    {
+        return *this;
+    }
+    
+    //! Pack the sendFields_ prepared along iDim and start one send and one receive per neighbouring process.
+    //! fields[i] belongs to patches[i%patches.size()], its component being i/patches.size().
+    //! The tag identifies the exchange: iDim for the ghost cells exchanges, 3+iDim for the sums
+    void init( std::vector<Field *> &fields, std::vector<Patch *> &patches, int iDim, int tag, SmileiMPI *smpi );
+    //! Wait for the messages of the exchange tag and unpack them in the recvFields_
+    void finalize( int tag );
+    //! True if the list was already exchanged through init with this tag. It is not reset by finalize,
+    //! so that all threads read the same value before the finalizing thread is elected
+    bool active( int tag ) const
+    {
+        return tag < ( int )exchanges_.size() && exchanges_[tag].active;
+    }
+    
+private:
+    struct Block {
+        int rank;
+        unsigned int icomp;
+        unsigned int hindex;
+        int side;
+        //! Field of the list and index of its sub-field
+        unsigned int ifield;
+        int isub;
+        size_t bytes;
+        char *data;
+        bool operator<( const Block &b ) const
+        {
+            if( rank != b.rank ) return rank < b.rank;
+            if( icomp != b.icomp ) return icomp < b.icomp;
+            if( hindex != b.hindex ) return hindex < b.hindex;
+            return side < b.side;
+        }
+    };
+    struct Exchange {
+        bool active = false;
+        //! Topology epoch the blocks and the persistent requests were built for
+        int epoch = -1;
+        size_t nfields = 0;
+        size_t npatches = 0;
+        std::vector<Block> send_blocks, recv_blocks;
+        //! Neighbouring processes, and one message per process
+        std::vector<int> send_ranks, recv_ranks;
+        std::vector< std::vector<char> > send_buffers, recv_buffers;
+        std::vector<MPI_Request> srequest, rrequest;
+        //! Shared memory: where each message is packed (send_buffers or the segment of this process),
+        //! offset in the segment (no_offset if sent as a message)
+        SharedMemoryWindow *window = nullptr;
+        std::vector<char *> send_data;
+        std::vector<uint64_t> send_offsets;
+        //! Slot of the exchange in the segment, holding all its messages packed in shared memory. It is valid
+        //! until the window is reallocated, at the next epoch: a layout rebuilt within the epoch reuses it
+        size_t slot_offset = 0;
+        size_t slot_bytes = 0;
+        int slot_epoch = -1;
+        //! Acknowledgements of the messages read in shared memory, completed before the next exchange
+        std::vector<MPI_Request> ack_requests;
+        MPI_Comm comm = MPI_COMM_NULL;
+    };
+    static const uint64_t no_offset = UINT64_MAX;
+    //! Tag of the acknowledgements, added to the tag of the exchange
+    static const int ack_tag_offset = 8;
+    
+    //! Sort the blocks of the list, allocate the messages and create the persistent requests
+    void build( Exchange &exchange, std::vector<Field *> &fields, std::vector<Patch *> &patches, int iDim, int tag, SmileiMPI *smpi );
+    //! Release the persistent requests of an exchange
+    void freeRequests( Exchange &exchange );
+    //! Wait for the acknowledgements of the previous exchange
+    void waitAcknowledgements( Exchange &exchange );
+    
+    std::vector<Exchange> exchanges_;
+};
+
 #endif
 
@@ -0,0 +1,134 @@
+#include "DynamicsArena.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "Tools.h"
+
+using namespace std;
+
+constexpr double DynamicsArena::growth_factor_;
+constexpr size_t DynamicsArena::alignment_;
+
+DynamicsBufferBase::DynamicsBufferBase( DynamicsBufferBase &&other ) noexcept :
+    data_( other.data_ ), size_( other.size_ ), capacity_( other.capacity_ ), requested_( other.requested_ ),
+    element_size_( other.element_size_ ), arena_( other.arena_ )
+{
+    if( arena_ ) {
+        arena_->replace( &other, this );
+    }
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.capacity_ = 0;
+    other.arena_ = nullptr;
+}
+
+DynamicsBufferBase::~DynamicsBufferBase()
+{
+    if( arena_ ) {
+        arena_->detach( this );
+    }
+}
+
+void DynamicsBufferBase::capacityExceeded( size_t n ) const
+{
+    if( ! arena_ ) {
+        ERROR( "A dynamics buffer is used before being attached to an arena" );
+    }
+    ERROR( "A dynamics buffer is resized to " << n << " elements beyond its capacity " << capacity_
+           << ": the capacities must be reserved with SmileiMPI::reserveDynamicsBuffers" );
+}
+
+
+DynamicsArena::~DynamicsArena()
+{
+    for( unsigned int i = 0; i < buffers_.size(); i++ ) {
+        buffers_[i]->data_ = nullptr;
+        buffers_[i]->size_ = 0;
+        buffers_[i]->capacity_ = 0;
+        buffers_[i]->arena_ = nullptr;
+    }
+    free( block_ );
+}
+
+void DynamicsArena::attach( DynamicsBufferBase *buffer )
+{
+    if( buffer->arena_ == this ) {
+        return;
+    }
+    if( buffer->arena_ ) {
+        buffer->arena_->detach( buffer );
+    }
+    buffer->arena_ = this;
+    buffer->data_ = nullptr;
+    buffer->size_ = 0;
+    buffer->capacity_ = 0;
+    buffers_.push_back( buffer );
+}
+
+void DynamicsArena::detach( DynamicsBufferBase *buffer )
+{
+    vector<DynamicsBufferBase *>::iterator it = find( buffers_.begin(), buffers_.end(), buffer );
+    if( it != buffers_.end() ) {
+        buffers_.erase( it );
+    }
+    buffer->arena_ = nullptr;
+}
+
+void DynamicsArena::replace( DynamicsBufferBase *from, DynamicsBufferBase *to )
+{
+    vector<DynamicsBufferBase *>::iterator it = find( buffers_.begin(), buffers_.end(), from );
+    if( it != buffers_.end() ) {
+        *it = to;
+    }
+}
+
+void DynamicsArena::grow()
+{
+    // New capacity of each buffer: only the buffers that requested more than
+    // their current capacity grow, with some slack to amortize the next requests
+    vector<size_t> capacity( buffers_.size() );
+    bool needs_growth = false;
+    for( unsigned int i = 0; i < buffers_.size(); i++ ) {
+        DynamicsBufferBase *b = buffers_[i];
+        capacity[i] = b->capacity_;
+        if( b->requested_ > b->capacity_ ) {
+            capacity[i] = max( b->requested_, ( size_t )( growth_factor_ * b->capacity_ ) );
+            needs_growth = true;
+        }
+        b->requested_ = 0;
+    }
+    if( ! needs_growth ) {
+        return;
+    }
+
+    // Lay out the sub-spans, each aligned on a cache line
+    vector<size_t> offset( buffers_.size() );
+    size_t total = 0;
+    for( unsigned int i = 0; i < buffers_.size(); i++ ) {
+        offset[i] = total;
+        total += ( ( capacity[i] * buffers_[i]->element_size_ + alignment_ - 1 ) / alignment_ ) * alignment_;
+    }
+
+    void *new_block = nullptr;
+    if( posix_memalign( &new_block, alignment_, max( total, alignment_ ) ) != 0 ) {
+        ERROR( "Could not allocate " << total << " bytes for the dynamics buffers" );
+    }
+    char *block = static_cast<char *>( new_block );
+
+    // Move the contents to the new block
+    for( unsigned int i = 0; i < buffers_.size(); i++ ) {
+        DynamicsBufferBase *b = buffers_[i];
+        if( b->size_ > 0 ) {
+            memcpy( block + offset[i], b->data_, b->size_ * b->element_size_ );
+        }
+        b->data_ = block + offset[i];
+        b->capacity_ = capacity[i];
+    }
+
+    free( block_ );
+    block_ = block;
+    block_bytes_ = total;
+    n_allocations_++;
+}
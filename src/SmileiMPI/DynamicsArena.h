@@ -0,0 +1,226 @@
+#ifndef DYNAMICSARENA_H
+#define DYNAMICSARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+
+class DynamicsArena;
+
+// -----------------------------------------------------------------------------
+//! Untyped part of a buffer whose memory is a sub-span of a DynamicsArena
+// -----------------------------------------------------------------------------
+class DynamicsBufferBase
+{
+    friend class DynamicsArena;
+
+public:
+    DynamicsBufferBase( std::size_t element_size ) :
+        data_( nullptr ), size_( 0 ), capacity_( 0 ), requested_( 0 ),
+        element_size_( element_size ), arena_( nullptr ) {};
+
+    //! The arena follows the buffer when it is moved (e.g. by the std::vector of buffers)
+    DynamicsBufferBase( DynamicsBufferBase &&other ) noexcept;
+    ~DynamicsBufferBase();
+
+    DynamicsBufferBase( const DynamicsBufferBase & ) = delete;
+    DynamicsBufferBase &operator=( const DynamicsBufferBase & ) = delete;
+    DynamicsBufferBase &operator=( DynamicsBufferBase && ) = delete;
+
+    inline std::size_t size() const
+    {
+        return size_;
+    }
+    inline std::size_t capacity() const
+    {
+        return capacity_;
+    }
+    inline bool empty() const
+    {
+        return size_ == 0;
+    }
+    inline void clear()
+    {
+        size_ = 0;
+    }
+
+    //! Announce the size of the next resize, so that the arena can grow
+    //! for all its buffers at once instead of once per buffer
+    inline void request( std::size_t n )
+    {
+        requested_ = std::max( requested_, n );
+    }
+
+protected:
+    //! Error raised by a resize beyond the capacity: only DynamicsArena::grow
+    //! may move the buffers, all at once (see SmileiMPI::reserveDynamicsBuffers)
+    void capacityExceeded( std::size_t n ) const;
+
+    //! Start of the sub-span in the arena block
+    void *data_;
+    //! Number of elements in use
+    std::size_t size_;
+    //! Number of elements available in the sub-span
+    std::size_t capacity_;
+    //! Capacity requested for the next growth of the arena
+    std::size_t requested_;
+    //! sizeof the elements
+    std::size_t element_size_;
+    //! Arena owning the memory (nullptr until the buffer is attached)
+    DynamicsArena *arena_;
+};
+
+// -----------------------------------------------------------------------------
+//! Scratch buffer used by Species::dynamics (interpolated fields, gamma, old
+//! positions, ...). It mimics the subset of the std::vector interface used by
+//! the particle operators, but its memory is handed out by a DynamicsArena:
+//! shrinking never frees memory, and a resize cannot exceed the capacity
+//! reserved beforehand for all the buffers of the arena.
+// -----------------------------------------------------------------------------
+template<typename T>
+class DynamicsBuffer : public DynamicsBufferBase
+{
+public:
+    typedef T value_type;
+    typedef T *iterator;
+    typedef const T *const_iterator;
+
+    DynamicsBuffer() : DynamicsBufferBase( sizeof( T ) ) {};
+    DynamicsBuffer( DynamicsBuffer &&other ) noexcept : DynamicsBufferBase( std::move( other ) ) {};
+
+    inline T &operator[]( std::size_t i )
+    {
+        return static_cast<T *>( data_ )[i];
+    }
+    inline const T &operator[]( std::size_t i ) const
+    {
+        return static_cast<const T *>( data_ )[i];
+    }
+    inline T *data()
+    {
+        return static_cast<T *>( data_ );
+    }
+    inline const T *data() const
+    {
+        return static_cast<const T *>( data_ );
+    }
+    inline T *begin()
+    {
+        return data();
+    }
+    inline T *end()
+    {
+        return data() + size_;
+    }
+
+    //! Same semantics as std::vector::resize (new elements are value-initialized),
+    //! within the capacity
+    void resize( std::size_t n );
+
+    //! Same semantics as std::vector::erase
+    T *erase( T *first, T *last )
+    {
+        std::copy( last, end(), first );
+        size_ -= last - first;
+        return first;
+    }
+};
+
+// -----------------------------------------------------------------------------
+//! Memory arena for the scratch buffers of one dynamics buffer id (one per
+//! OpenMP thread, or one per patch/species/bin when tasks are enabled).
+//!
+//! All the buffers attached to an arena live in a single, cache-line aligned
+//! block, each in its own sub-span. The block is only reallocated when a
+//! buffer outgrows its sub-span; all capacities are then recomputed (with
+//! some slack) and the contents are moved to the new block. The block is never
+//! shrunk during the run, so that it settles to the high-water mark of the
+//! particle number per patch.
+// -----------------------------------------------------------------------------
+class DynamicsArena
+{
+public:
+    DynamicsArena() : block_( nullptr ), block_bytes_( 0 ), n_allocations_( 0 ), n_resizes_( 0 ) {};
+    ~DynamicsArena();
+
+    DynamicsArena( const DynamicsArena & ) = delete;
+    DynamicsArena &operator=( const DynamicsArena & ) = delete;
+
+    //! Host the memory of a buffer in this arena
+    void attach( DynamicsBufferBase *buffer );
+    //! Forget a buffer (its sub-span is reused at the next growth)
+    void detach( DynamicsBufferBase *buffer );
+    //! Update the address of a buffer that has been moved
+    void replace( DynamicsBufferBase *from, DynamicsBufferBase *to );
+
+    //! Grow the block so that every buffer can hold its requested capacity
+    void grow();
+
+    //! Count one resize request (for the statistics)
+    inline void countResize()
+    {
+        n_resizes_++;
+    }
+
+    //! Size of the block in bytes
+    inline std::size_t bytes() const
+    {
+        return block_bytes_;
+    }
+    //! Number of (re)allocations of the block since the beginning
+    inline uint64_t allocations() const
+    {
+        return n_allocations_;
+    }
+    //! Number of resize requests served since the beginning
+    inline uint64_t resizes() const
+    {
+        return n_resizes_;
+    }
+
+private:
+    //! Relative increase of a capacity when a buffer outgrows its sub-span
+    static constexpr double growth_factor_ = 1.25;
+    //! Alignment of each sub-span in the block
+    static constexpr std::size_t alignment_ = 64;
+
+    //! Aligned memory shared by all the buffers
+    char *block_;
+    std::size_t block_bytes_;
+
+    //! Buffers hosted in this arena
+    std::vector<DynamicsBufferBase *> buffers_;
+
+    //! Statistics
+    uint64_t n_allocations_;
+    uint64_t n_resizes_;
+};
+
+template<typename T>
+void DynamicsBuffer<T>::resize( std::size_t n )
+{
+    if( n > capacity_ ) {
+        capacityExceeded( n );
+    }
+    if( arena_ ) {
+        arena_->countResize();
+    }
+    if( n > size_ ) {
+        std::fill( data() + size_, data() + n, T() );
+    }
+    size_ = n;
+}
+
+//! Container used for the dynamics buffers of SmileiMPI. On GPU, the buffers
+//! are mapped individually on the device (see SmileiMPI::resizeDeviceBuffers)
+//! so that they keep their own std::vector storage.
+#if defined( SMILEI_ACCELERATOR_GPU_OMP ) || defined( SMILEI_ACCELERATOR_GPU_OACC )
+template<typename T>
+using dynamics_buffer = std::vector<T>;
+#else
+template<typename T>
+using dynamics_buffer = DynamicsBuffer<T>;
+#endif
+
+#endif
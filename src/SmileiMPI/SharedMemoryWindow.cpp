@@ -0,0 +1,123 @@
+#include "SharedMemoryWindow.h"
+
+#include <algorithm>
+
+#include "Tools.h"
+
+using namespace std;
+
+constexpr size_t SharedMemoryWindow::alignment_;
+constexpr double SharedMemoryWindow::growth_factor_;
+
+SharedMemoryWindow::SharedMemoryWindow() :
+    node_comm_( MPI_COMM_NULL ), win_( MPI_WIN_NULL ), bytes_( 0 ), used_( 0 ), requested_( 0 ), demand_( 0 )
+{
+}
+
+
+SharedMemoryWindow::~SharedMemoryWindow()
+{
+    // Must be released collectively before MPI_Finalize
+    int finalized = 0;
+    MPI_Finalized( &finalized );
+    if( ! finalized ) {
+        release();
+        if( node_comm_ != MPI_COMM_NULL ) {
+            MPI_Comm_free( &node_comm_ );
+        }
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Group the processes of comm which can share memory, and map their ranks in comm to their ranks on the node
+// ---------------------------------------------------------------------------------------------------------------------
+void SharedMemoryWindow::init( MPI_Comm comm )
+{
+    int rank, size;
+    MPI_Comm_rank( comm, &rank );
+    MPI_Comm_size( comm, &size );
+    MPI_Comm_split_type( comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm_ );
+
+    MPI_Group group, node_group;
+    MPI_Comm_group( comm, &group );
+    MPI_Comm_group( node_comm_, &node_group );
+    vector<int> ranks( size );
+    for( int i=0 ; i<size ; i++ ) {
+        ranks[i] = i;
+    }
+    node_rank_.resize( size );
+    MPI_Group_translate_ranks( group, size, ranks.data(), node_group, node_rank_.data() );
+    for( int i=0 ; i<size ; i++ ) {
+        if( node_rank_[i] == MPI_UNDEFINED ) {
+            node_rank_[i] = -1;
+        }
+    }
+    MPI_Group_free( &group );
+    MPI_Group_free( &node_group );
+}
+
+
+void SharedMemoryWindow::release()
+{
+    if( win_ != MPI_WIN_NULL ) {
+        MPI_Win_unlock_all( win_ );
+        MPI_Win_free( &win_ );
+        segments_.clear();
+        bytes_ = 0;
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Replace the window by a new one. MPI_Win_free synchronizes the processes of the node, so that no segment is
+// freed while it is still read
+// ---------------------------------------------------------------------------------------------------------------------
+void SharedMemoryWindow::allocate( size_t bytes )
+{
+    size_t new_bytes = max( bytes, bytes_ );
+    if( demand_ > new_bytes ) {
+        new_bytes = ( size_t )( growth_factor_ * demand_ );
+    }
+    new_bytes = ( ( new_bytes + alignment_ - 1 ) / alignment_ ) * alignment_;
+
+    release();
+
+    MPI_Info info;
+    MPI_Info_create( &info );
+    // Segments are accessed through the addresses returned by MPI_Win_shared_query
+    MPI_Info_set( info, "alloc_shared_noncontig", "true" );
+    char *base;
+    MPI_Win_allocate_shared( new_bytes, 1, info, node_comm_, &base, &win_ );
+    MPI_Info_free( &info );
+    // Passive target epoch: the accesses are synchronized by messages and MPI_Win_sync
+    MPI_Win_lock_all( MPI_MODE_NOCHECK, win_ );
+
+    int node_size;
+    MPI_Comm_size( node_comm_, &node_size );
+    segments_.resize( node_size );
+    for( int i=0 ; i<node_size ; i++ ) {
+        MPI_Aint size;
+        int disp_unit;
+        MPI_Win_shared_query( win_, i, &size, &disp_unit, &segments_[i] );
+    }
+
+    bytes_ = new_bytes;
+    used_ = 0;
+    requested_ = 0;
+    demand_ = 0;
+}
+
+
+bool SharedMemoryWindow::reserve( size_t bytes, size_t &offset )
+{
+    bytes = ( ( bytes + alignment_ - 1 ) / alignment_ ) * alignment_;
+    requested_ += bytes;
+    demand_ = max( demand_, requested_ );
+    if( used_ + bytes > bytes_ ) {
+        return false;
+    }
+    offset = used_;
+    used_ += bytes;
+    return true;
+}
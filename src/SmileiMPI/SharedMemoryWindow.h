@@ -0,0 +1,97 @@
+#ifndef SHAREDMEMORYWINDOW_H
+#define SHAREDMEMORYWINDOW_H
+
+#include <mpi.h>
+#include <cstddef>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+//! MPI-3 shared memory window between the processes of a node
+//! (Main.shared_memory_exchange). Each process owns one segment, in which it
+//! reserves the slots of its outgoing ghost regions or particles; the processes
+//! of the same node read them in place, instead of receiving a copy.
+//!
+//! The window is only (re)allocated collectively over the node, at points of
+//! the time loop reached in the same order by all processes: the reservations
+//! which did not fit are counted, and the segment is grown at the next
+//! allocation.
+// -----------------------------------------------------------------------------
+class SharedMemoryWindow
+{
+public:
+    SharedMemoryWindow();
+    ~SharedMemoryWindow();
+
+    SharedMemoryWindow( const SharedMemoryWindow & ) = delete;
+    SharedMemoryWindow &operator=( const SharedMemoryWindow & ) = delete;
+
+    //! Create the node communicator from the processes of comm (collective over comm)
+    void init( MPI_Comm comm );
+    //! Free the window (collective over the node)
+    void release();
+    //! Allocate the segment of this process, with at least the given size and the
+    //! reservations which did not fit in the previous one (collective over the node)
+    void allocate( std::size_t bytes );
+
+    //! True once the window is allocated
+    inline bool allocated() const
+    {
+        return win_ != MPI_WIN_NULL;
+    }
+    //! True if the process (rank in the communicator given to init) shares memory with this one
+    inline bool onNode( int rank ) const
+    {
+        return rank >= 0 && rank < ( int )node_rank_.size() && node_rank_[rank] >= 0;
+    }
+    //! Start of the segment of a process of the node
+    inline char *segment( int rank ) const
+    {
+        return segments_[node_rank_[rank]];
+    }
+
+    //! Reserve bytes in the segment of this process. Returns false if they do not fit
+    bool reserve( std::size_t bytes, std::size_t &offset );
+    //! Forget all the reservations (the memory of the segment is reused)
+    inline void clearReservations()
+    {
+        used_ = 0;
+        requested_ = 0;
+    }
+
+    //! Memory barrier on the window: to be called after writing a segment, before notifying
+    //! the readers, and after being notified, before reading a segment
+    inline void sync()
+    {
+        MPI_Win_sync( win_ );
+    }
+
+    //! Size of the segment of this process
+    inline std::size_t bytes() const
+    {
+        return bytes_;
+    }
+
+private:
+    //! Alignment of each reservation in a segment
+    static constexpr std::size_t alignment_ = 64;
+    //! Relative increase of the segment when the reservations did not fit
+    static constexpr double growth_factor_ = 1.25;
+
+    MPI_Comm node_comm_;
+    MPI_Win win_;
+    //! Node rank of each process of the initial communicator, -1 if on another node
+    std::vector<int> node_rank_;
+    //! Start of the segment of each process of the node
+    std::vector<char *> segments_;
+
+    //! Size of the segment of this process
+    std::size_t bytes_;
+    //! Bytes reserved since the last clearReservations
+    std::size_t used_;
+    //! Bytes requested since the last clearReservations, including the reservations which did not fit
+    std::size_t requested_;
+    //! Largest number of bytes requested since the last allocation
+    std::size_t demand_;
+};
+
+#endif
@@ -1,6 +1,7 @@
 #include "SmileiMPI.h"
 
 #include <cmath>
+#include <climits>
 #include <cstring>
 #include <algorithm>
 
@@ -41,6 +42,9 @@
 
 using namespace std;
 
+const int SmileiMPI::direct_particle_ack_tag_;
+const size_t SmileiMPI::direct_particle_notice_bytes_;
+
 // ---------------------------------------------------------------------------------------------------------------------
 // SmileiMPI constructor :
 //     - Call MPI_Init_thread, MPI_THREAD_MULTIPLE required
@@ -71,6 +75,13 @@ SmileiMPI::SmileiMPI( int *argc, char ***argv )
 #endif
 
     world_ = MPI_COMM_WORLD;
+    particle_exchange_comm_ = MPI_COMM_NULL;
+    field_exchange_comm_ = MPI_COMM_NULL;
+    field_exchange_epoch_ = 0;
+    shared_field_window_ = NULL;
+    shared_particle_window_ = NULL;
+    max_sum_op_ = MPI_OP_NULL;
+    max_sum_type_ = MPI_DATATYPE_NULL;
     MPI_Comm_size( world_, &smilei_sz );
     MPI_Comm_rank( world_, &smilei_rk );
 
@@ -86,6 +97,29 @@ SmileiMPI::~SmileiMPI()
 {
     delete[]periods_;
 
+    for( unsigned int i=0 ; i<dynamics_arena.size() ; i++ ) {
+        delete dynamics_arena[i];
+    }
+
+    if( particle_exchange_comm_ != MPI_COMM_NULL ) {
+        MPI_Comm_free( &particle_exchange_comm_ );
+    }
+    if( shared_particle_window_ ) {
+        MPI_Waitall( shared_particle_acks_.size(), shared_particle_acks_.data(), MPI_STATUSES_IGNORE );
+        delete shared_particle_window_;
+    }
+    if( shared_field_window_ ) {
+        delete shared_field_window_;
+    }
+
+    if( field_exchange_comm_ != MPI_COMM_NULL ) {
+        MPI_Comm_free( &field_exchange_comm_ );
+    }
+    if( max_sum_op_ != MPI_OP_NULL ) {
+        MPI_Op_free( &max_sum_op_ );
+        MPI_Type_free( &max_sum_type_ );
+    }
+
     MPI_Finalize();
 
 } // END SmileiMPI::~SmileiMPI
@@ -210,6 +244,44 @@ void SmileiMPI::init( Params &params, DomainDecomposition *domain_decomposition
         }
     }
 #endif
+    attachDynamicsBuffers();
+
+    if( params.direct_particle_exchange ) {
+        MPI_Comm_dup( world_, &particle_exchange_comm_ );
+    }
+    if( params.aggregated_field_exchange ) {
+        MPI_Comm_dup( world_, &field_exchange_comm_ );
+    }
+
+    if( params.shared_memory_exchange ) {
+        // Initial segments: the ghost regions of 12 fields around the patches of this process, assumed
+        // to form a compact block. They grow to the actual needs when patches move between processes
+        double patches_per_process = ( double )params.tot_number_of_patches / smilei_sz;
+        double faces = pow( patches_per_process, ( params.nDim_field-1. )/params.nDim_field );
+        double bytes = 0.;
+        for( unsigned int iDim=0 ; iDim<params.nDim_field ; iDim++ ) {
+            double slab = params.oversize[iDim]+1;
+            for( unsigned int jDim=0 ; jDim<params.nDim_field ; jDim++ ) {
+                if( jDim != iDim ) {
+                    slab *= params.patch_size_[jDim] + 1 + 2*params.oversize[jDim];
+                }
+            }
+            bytes += 2. * faces * slab * sizeof( double );
+        }
+        shared_window_bytes_ = ( size_t )( 12. * bytes );
+
+        if( params.aggregated_field_exchange ) {
+            shared_field_window_ = new SharedMemoryWindow();
+            shared_field_window_->init( world_ );
+            shared_field_window_epoch_ = -1;
+        }
+        if( params.direct_particle_exchange ) {
+            shared_particle_window_ = new SharedMemoryWindow();
+            shared_particle_window_->init( world_ );
+            shared_particle_window_epoch_ = -1;
+            last_direct_particle_species_ = INT_MAX;
+        }
+    }
 
     // Set periodicity of the simulated problem
     periods_  = new int[params.nDim_field];
@@ -520,7 +592,47 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
         Lp_right.resize( patch_count[smilei_rk+1] );
     }
 
+    //Particle contribution to the load of each patch, in units of the load of a particle
+    std::vector<double> particles_load( patch_count[smilei_rk], 0. );
+    for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
+        for( unsigned int ispecies = 0; ispecies < tot_species_number; ispecies++ ) {
+            particles_load[ipatch] += vecpatches( ipatch )->vecSpecies[ispecies]->getNbrOfParticles()*( 1+( params.frozen_particle_load-1 )*( time_dual < vecpatches( ipatch )->vecSpecies[ispecies]->time_frozen_ ) ) ;
+        }
+    }
 
+#ifdef __DETAILED_TIMERS
+    //Measured load: replace the particle count by the time measured since the last balancing,
+    //averaged over time and rescaled so that its total matches the particle count of the measured patches
+    if( params.load_model == "measured" ) {
+        double sums_loc[2] = { 0., 0. }, sums[2];
+        for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
+            Patch *patch = vecpatches( ipatch );
+            if( patch->measured_iterations_ > 0 ) {
+                double sample = patch->measured_load_ / patch->measured_iterations_;
+                if( patch->smoothed_load_ < 0. ) {
+                    patch->smoothed_load_ = sample;
+                } else {
+                    patch->smoothed_load_ = params.measured_load_smoothing * sample + ( 1.-params.measured_load_smoothing ) * patch->smoothed_load_;
+                }
+            }
+            patch->measured_load_ = 0.;
+            patch->measured_iterations_ = 0;
+            if( patch->smoothed_load_ >= 0. ) {
+                sums_loc[0] += particles_load[ipatch];
+                sums_loc[1] += patch->smoothed_load_;
+            }
+        }
+        MPI_Allreduce( sums_loc, sums, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+        if( sums[1] > 0. ) {
+            double scale = sums[0] / sums[1];
+            for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
+                if( vecpatches( ipatch )->smoothed_load_ >= 0. ) {
+                    particles_load[ipatch] = scale * vecpatches( ipatch )->smoothed_load_;
+                }
+            }
+        }
+    }
+#endif
 
     while( recompute_tload ) {
 
@@ -532,9 +644,7 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
 
         //Compute particle contribution to Local Loads of each Patch (Lp)
         for( unsigned int ipatch=0; ipatch < ( unsigned int )patch_count[smilei_rk]; ipatch++ ) {
-            for( unsigned int ispecies = 0; ispecies < tot_species_number; ispecies++ ) {
-                Lp[ipatch] += vecpatches( ipatch )->vecSpecies[ispecies]->getNbrOfParticles()*( 1+( params.frozen_particle_load-1 )*( time_dual < vecpatches( ipatch )->vecSpecies[ispecies]->time_frozen_ ) ) ;
-            }
+            Lp[ipatch] += particles_load[ipatch];
             Tload_loc += Lp[ipatch];
         }
 
@@ -560,79 +670,87 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
         }
     }
 
-    //Communicate the detail of the load of each patch to neighbouring MPI ranks
-    if( smilei_rk < smilei_sz-1 ) {
-        MPI_Isend( &( Lp[0] ), patch_count[smilei_rk], MPI_DOUBLE, smilei_rk+1, 0, MPI_COMM_WORLD, &request0 );
-    }
-    if( smilei_rk > 0 ) {
-        MPI_Isend( &( Lp[0] ), patch_count[smilei_rk], MPI_DOUBLE, smilei_rk-1, 1, MPI_COMM_WORLD, &request1 );
-        MPI_Recv( &( Lp_left[0] ), patch_count[smilei_rk-1], MPI_DOUBLE, smilei_rk-1, 0, MPI_COMM_WORLD, &status0 );
-    }
-    if( smilei_rk < smilei_sz-1 ) {
-        MPI_Recv( &( Lp_right[0] ), patch_count[smilei_rk+1], MPI_DOUBLE, smilei_rk+1, 1, MPI_COMM_WORLD, &status1 );
-    }
+    int internode_moves = 0;
+    if( params.hierarchical_load_balancing ) {
+        //Balance the nodes, then the processes inside each node
+        Ncur = node_aware_patch_count( params, Lp, Tload, internode_moves );
+    } else {
+        //Communicate the detail of the load of each patch to neighbouring MPI ranks
+        if( smilei_rk < smilei_sz-1 ) {
+            MPI_Isend( &( Lp[0] ), patch_count[smilei_rk], MPI_DOUBLE, smilei_rk+1, 0, MPI_COMM_WORLD, &request0 );
+        }
+        if( smilei_rk > 0 ) {
+            MPI_Isend( &( Lp[0] ), patch_count[smilei_rk], MPI_DOUBLE, smilei_rk-1, 1, MPI_COMM_WORLD, &request1 );
+            MPI_Recv( &( Lp_left[0] ), patch_count[smilei_rk-1], MPI_DOUBLE, smilei_rk-1, 0, MPI_COMM_WORLD, &status0 );
+        }
+        if( smilei_rk < smilei_sz-1 ) {
+            MPI_Recv( &( Lp_right[0] ), patch_count[smilei_rk+1], MPI_DOUBLE, smilei_rk+1, 1, MPI_COMM_WORLD, &status1 );
+        }
 
 
-    if( smilei_rk > 0 ) {
-        MPI_Wait( &request1, &status );
-    }
-    if( smilei_rk < smilei_sz-1 ) {
-        MPI_Wait( &request0, &status );
-    }
+        if( smilei_rk > 0 ) {
+            MPI_Wait( &request1, &status );
+        }
+        if( smilei_rk < smilei_sz-1 ) {
+            MPI_Wait( &request0, &status );
+        }
 
-    if( smilei_rk > 0 ) {
-        //Tcur is now initialized as the total load currently carried by previous ranks.
-        Tcur = Tscan - Tload_loc;
-        //Check if my rank should start with additional patches from left neighbour.
-        target = smilei_rk*Tload; //target here points at the optimal begining for current rank
-        if( Tcur > target ) {
-            j = Lp_left.size()-1;
-            while( abs( Tcur-target ) > abs( Tcur-Lp_left[j] - target ) && j>0 ) { //Leave at least 1 patch to my neighbour.
-                Tcur -= Lp_left[j];
-                j--;
-                Ncur++;
-            }
-        } else {
-            //  Check if some of my patches should be given to my left neighbour.
-            j = 0;
-            while( ( abs( Tcur-target ) > abs( Tcur+Lp[j]-target ) ) && ( j < ( unsigned int )patch_count[smilei_rk]-1 ) ) { //Keep at least 1 patch from my original set of patches
-                Tcur += Lp[j];
-                j++;
-                Ncur --;
+        if( smilei_rk > 0 ) {
+            //Tcur is now initialized as the total load currently carried by previous ranks.
+            Tcur = Tscan - Tload_loc;
+            //Check if my rank should start with additional patches from left neighbour.
+            target = smilei_rk*Tload; //target here points at the optimal begining for current rank
+            if( Tcur > target ) {
+                j = Lp_left.size()-1;
+                while( abs( Tcur-target ) > abs( Tcur-Lp_left[j] - target ) && j>0 ) { //Leave at least 1 patch to my neighbour.
+                    Tcur -= Lp_left[j];
+                    j--;
+                    Ncur++;
+                }
+            } else {
+                //  Check if some of my patches should be given to my left neighbour.
+                j = 0;
+                while( ( abs( Tcur-target ) > abs( Tcur+Lp[j]-target ) ) && ( j < ( unsigned int )patch_count[smilei_rk]-1 ) ) { //Keep at least 1 patch from my original set of patches
+                    Tcur += Lp[j];
+                    j++;
+                    Ncur --;
+                }
             }
         }
-    }
 
-    if( smilei_rk < smilei_sz-1 ) {
-        //Tcur is now initialized as the total load carried by previous ranks + my load.
-        Tcur = Tscan;
-        target = ( smilei_rk+1 )*Tload;
-
-        //Check if my rank should start with additional patches from right neighbour ...
-        if( Tcur < target ) {
-            j = 0;
-            while( ( abs( Tcur-target ) > abs( Tcur+Lp_right[j] - target ) ) && ( j<( unsigned int )patch_count[smilei_rk+1] - 1 ) ) { //Leave at least 1 patch to my neighbour
-                Tcur += Lp_right[j];
-                j++;
-                Ncur++;
-            }
+        if( smilei_rk < smilei_sz-1 ) {
+            //Tcur is now initialized as the total load carried by previous ranks + my load.
+            Tcur = Tscan;
+            target = ( smilei_rk+1 )*Tload;
+
+            //Check if my rank should start with additional patches from right neighbour ...
+            if( Tcur < target ) {
+                j = 0;
+                while( ( abs( Tcur-target ) > abs( Tcur+Lp_right[j] - target ) ) && ( j<( unsigned int )patch_count[smilei_rk+1] - 1 ) ) { //Leave at least 1 patch to my neighbour
+                    Tcur += Lp_right[j];
+                    j++;
+                    Ncur++;
+                }
 
-        } else {
-            //  Check if some of my patches should be given to my right neighbour.
-            j = patch_count[smilei_rk]-1;
-            while( abs( Tcur-target ) > abs( Tcur-Lp[j]-target ) && j > 0 ) { //Keep at least 1 patch from my original set of patches
-                Tcur -= Lp[j];
-                j--;
-                Ncur --;
+            } else {
+                //  Check if some of my patches should be given to my right neighbour.
+                j = patch_count[smilei_rk]-1;
+                while( abs( Tcur-target ) > abs( Tcur-Lp[j]-target ) && j > 0 ) { //Keep at least 1 patch from my original set of patches
+                    Tcur -= Lp[j];
+                    j--;
+                    Ncur --;
+                }
             }
         }
-    }
 
-    //Ncur is the variation of number of patches owned by current rank.
-    //Stores in Ncur the final patch count of this rank
-    Ncur += patch_count[smilei_rk] ;
+        //Ncur is the variation of number of patches owned by current rank.
+        //Stores in Ncur the final patch count of this rank
+        Ncur += patch_count[smilei_rk] ;
+    }
 
     //Ncur now has to be gathered to all as target_patch_count[smilei_rk]
+    unsigned int first_patch = patch_refHindexes[smilei_rk];
+    unsigned int npatches = patch_count[smilei_rk];
     MPI_Allgather( &Ncur, 1, MPI_INT, &patch_count[0], 1, MPI_INT, MPI_COMM_WORLD );
 
     patch_refHindexes[0] = 0;
@@ -640,9 +758,29 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
         patch_refHindexes[rk] = patch_refHindexes[rk-1] + patch_count[rk-1];
     }
 
+    //Imbalance (largest over average load of the ranks) of the current distribution and of the new one
+    double Tload_max;
+    MPI_Reduce( &Tload_loc, &Tload_max, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD );
+    std::vector<double> new_load_loc( smilei_sz, 0. ), new_load( smilei_sz, 0. );
+    int owner = 0;
+    for( unsigned int ipatch=0; ipatch < npatches; ipatch++ ) {
+        while( owner < smilei_sz-1 && first_patch+ipatch >= ( unsigned int )patch_refHindexes[owner+1] ) {
+            owner++;
+        }
+        new_load_loc[owner] += Lp[ipatch];
+    }
+    MPI_Reduce( &new_load_loc[0], &new_load[0], smilei_sz, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+
     //Write patch_load.txt
     if( smilei_rk==0 ) {
+        double Tload_mean = Tload * Tcapabilities / smilei_sz;
         fout << "\tt = " << time_dual << endl;
+        fout << " imbalance before = " << Tload_max / Tload_mean
+             << " predicted = " << *max_element( new_load.begin(), new_load.end() ) / Tload_mean
+             << " (" << params.load_model << " load)" << endl;
+        if( params.hierarchical_load_balancing ) {
+            fout << " patches moved between nodes = " << internode_moves << endl;
+        }
         for( int irk=0; irk<smilei_sz; irk++ ) {
             fout << " patch_count[" << irk << "] = " << patch_count[irk] << endl;
         }
@@ -652,6 +790,144 @@ void SmileiMPI::recompute_patch_count( Params &params, VectorPatch &vecpatches,
 } // END recompute_patch_count
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Position, between lo and hi, of the boundary whose cumulated load (prefix) is the closest to target
+// ---------------------------------------------------------------------------------------------------------------------
+static int closest_boundary( const std::vector<double> &prefix, double target, int lo, int hi )
+{
+    int i = lower_bound( prefix.begin()+lo, prefix.begin()+hi+1, target ) - prefix.begin();
+    if( i > hi ) {
+        return hi;
+    }
+    if( i > lo && target - prefix[i-1] < prefix[i] - target ) {
+        i--;
+    }
+    return i;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Node-aware patch distribution (LoadBalancing.hierarchical). Returns the new patch count of this rank.
+//   - the processes sharing memory (MPI_Comm_split_type) form a node, which must be a range of consecutive ranks
+//   - level 1: the boundaries between nodes move only if the load of a node is off its target by more than
+//     node_imbalance_tolerance. Each node then owns a single segment of the Hilbert curve
+//   - level 2: the segment of each node is split between its processes, for their load to be equal
+//   - as in the neighbour algorithm, a patch only moves to a neighbour rank and each rank keeps at least one patch
+// ---------------------------------------------------------------------------------------------------------------------
+int SmileiMPI::node_aware_patch_count( Params &params, std::vector<double> &Lp, double Tload, int &internode_moves )
+{
+    // First rank of the node of each rank
+    if( node_first_rank_.empty() ) {
+        MPI_Comm node_comm;
+        MPI_Comm_split_type( world_, MPI_COMM_TYPE_SHARED, smilei_rk, MPI_INFO_NULL, &node_comm );
+        int first_rank;
+        MPI_Allreduce( &smilei_rk, &first_rank, 1, MPI_INT, MPI_MIN, node_comm );
+        MPI_Comm_free( &node_comm );
+        node_first_rank_.resize( smilei_sz );
+        MPI_Allgather( &first_rank, 1, MPI_INT, &node_first_rank_[0], 1, MPI_INT, world_ );
+        for( int rk=1; rk<smilei_sz; rk++ ) {
+            if( node_first_rank_[rk] != rk && node_first_rank_[rk] != node_first_rank_[rk-1] ) {
+                WARNING( "Hierarchical load balancing requires consecutive ranks on each node: all ranks are balanced as a single node" );
+                node_first_rank_.assign( smilei_sz, 0 );
+                break;
+            }
+        }
+    }
+
+    // Load of all patches, and cumulated load before each patch
+    int npatches = patch_refHindexes[smilei_sz-1] + patch_count[smilei_sz-1];
+    std::vector<double> load( npatches ), prefix( npatches+1, 0. );
+    MPI_Allgatherv( &Lp[0], patch_count[smilei_rk], MPI_DOUBLE, &load[0], &patch_count[0], &patch_refHindexes[0], MPI_DOUBLE, world_ );
+    for( int ipatch=0; ipatch<npatches; ipatch++ ) {
+        prefix[ipatch+1] = prefix[ipatch] + load[ipatch];
+    }
+
+    // Current first patch of each rank, and the target one
+    std::vector<int> current( patch_refHindexes ), target( smilei_sz+1 );
+    current.push_back( npatches );
+    target[0] = 0;
+    target[smilei_sz] = npatches;
+
+    // First rank of each node
+    std::vector<int> nodes;
+    for( int rk=0; rk<smilei_sz; rk++ ) {
+        if( node_first_rank_[rk] == rk ) {
+            nodes.push_back( rk );
+        }
+    }
+    nodes.push_back( smilei_sz );
+
+    // Level 1: nodes
+    bool move_nodes = false;
+    for( unsigned int inode=0; inode<nodes.size()-1; inode++ ) {
+        double node_load = prefix[current[nodes[inode+1]]] - prefix[current[nodes[inode]]];
+        double node_target = ( nodes[inode+1]-nodes[inode] ) * Tload;
+        if( abs( node_load/node_target - 1. ) > params.node_imbalance_tolerance ) {
+            move_nodes = true;
+        }
+    }
+    for( unsigned int inode=1; inode<nodes.size()-1; inode++ ) {
+        int rk = nodes[inode];
+        if( move_nodes ) {
+            // Leave at least one patch per rank of the previous and next nodes
+            target[rk] = closest_boundary( prefix, rk*Tload, target[nodes[inode-1]] + rk - nodes[inode-1], npatches - smilei_sz + rk );
+        } else {
+            target[rk] = current[rk];
+        }
+    }
+
+    // Level 2: ranks inside each node
+    for( unsigned int inode=0; inode<nodes.size()-1; inode++ ) {
+        int first = nodes[inode], last = nodes[inode+1];
+        double node_start = prefix[target[first]];
+        double rank_load = ( prefix[target[last]] - node_start ) / ( last-first );
+        for( int rk=first+1; rk<last; rk++ ) {
+            target[rk] = closest_boundary( prefix, node_start + ( rk-first )*rank_load, target[rk-1] + 1, target[last] - last + rk );
+        }
+    }
+
+    // Patches only move to neighbour ranks
+    for( int rk=1; rk<smilei_sz; rk++ ) {
+        target[rk] = min( max( target[rk], current[rk-1]+1 ), current[rk+1]-1 );
+    }
+
+    internode_moves = 0;
+    for( unsigned int inode=1; inode<nodes.size()-1; inode++ ) {
+        internode_moves += abs( target[nodes[inode]] - current[nodes[inode]] );
+    }
+
+    return target[smilei_rk+1] - target[smilei_rk];
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Reduction of pairs (largest value, sum of the values)
+// ---------------------------------------------------------------------------------------------------------------------
+static void reduceMaxAndSum( void *in, void *inout, int *len, MPI_Datatype * )
+{
+    double *a = static_cast<double *>( in );
+    double *b = static_cast<double *>( inout );
+    for( int i=0; i<*len; i++ ) {
+        b[2*i]    = max( a[2*i], b[2*i] );
+        b[2*i+1] += a[2*i+1];
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Largest value and sum of the values over all processes, in a single reduction
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::maxAndSum( double value, double &max, double &sum )
+{
+    if( max_sum_op_ == MPI_OP_NULL ) {
+        MPI_Type_contiguous( 2, MPI_DOUBLE, &max_sum_type_ );
+        MPI_Type_commit( &max_sum_type_ );
+        MPI_Op_create( reduceMaxAndSum, 1, &max_sum_op_ );
+    }
+    double local[2] = { value, value }, global[2];
+    MPI_Allreduce( local, global, 1, max_sum_type_, max_sum_op_, world_ );
+    max = global[0];
+    sum = global[1];
+}
+
+
 // ----------------------------------------------------------------------
 // Returns the rank of the MPI process currently owning patch h.
 // ----------------------------------------------------------------------
@@ -706,7 +982,7 @@ MPI_Datatype SmileiMPI::createMPIparticles( Particles *particles )
     MPI_Datatype partDataType[nbrOfProp];
     // define MPI type of each property, default is DOUBLE
     for( unsigned int i=0 ; i<particles->double_prop_.size() ; i++ ) {
-        partDataType[i] = MPI_DOUBLE;
+        partDataType[i] = SMILEI_MPI_PARTICLE_REAL;
     }
     for( unsigned int iprop=0 ; iprop<particles->short_prop_.size() ; iprop++ ) {
         partDataType[ particles->double_prop_.size()+iprop] = MPI_SHORT;
@@ -724,6 +1000,199 @@ MPI_Datatype SmileiMPI::createMPIparticles( Particles *particles )
 } // END createMPIparticles
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// The window of the aggregated field exchanges is replaced at the first exchange of each topology epoch, when
+// the exchanges of the previous epoch are all finalized. Its segment grows to the reservations of the previous epoch
+// ---------------------------------------------------------------------------------------------------------------------
+SharedMemoryWindow *SmileiMPI::sharedFieldWindow()
+{
+    if( shared_field_window_ && shared_field_window_epoch_ != field_exchange_epoch_ ) {
+        shared_field_window_->allocate( shared_window_bytes_ );
+        shared_field_window_epoch_ = field_exchange_epoch_;
+    }
+    return shared_field_window_;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Direct exchange of particles: pack, for each neighbouring MPI process, the particles of all the local patches
+// leaving towards its patches, and send them in a single message. The message holds:
+//     - the number of blocks
+//     - for each block: the destination hindex, the receive buffer (2*iDim+iNeighbor) and the number of particles
+//     - the particles of each block, packed by Particles::packParticles
+// An empty message is sent to the neighbouring processes receiving nothing, so that each process receives
+// exactly one message from each of its neighbours.
+// With Main.shared_memory_exchange, the message towards a process of the same node is written in the shared
+// memory window, and only a notice (-1, offset, size) is sent. The receiver acknowledges it once read.
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::isendDirectParticles( VectorPatch &vecPatches, int ispec )
+{
+    if( direct_particle_buffers_.size() <= ( size_t )ispec ) {
+        direct_particle_buffers_.resize( ispec+1 );
+    }
+    DirectParticleMPIbuffers &exchange = direct_particle_buffers_[ispec];
+
+    // The species are sent in increasing order: a new round starts once the previous messages are read
+    SharedMemoryWindow *window = shared_particle_window_;
+    if( window ) {
+        if( ispec <= last_direct_particle_species_ ) {
+            MPI_Waitall( shared_particle_acks_.size(), shared_particle_acks_.data(), MPI_STATUSES_IGNORE );
+            shared_particle_acks_.clear();
+            if( shared_particle_window_epoch_ != field_exchange_epoch_ ) {
+                window->allocate( shared_window_bytes_ );
+                shared_particle_window_epoch_ = field_exchange_epoch_;
+            }
+            window->clearReservations();
+        }
+        last_direct_particle_species_ = ispec;
+    }
+
+    // Neighbouring processes (the neighbourhood is symmetric)
+    exchange.ranks.clear();
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        Patch *patch = vecPatches( ipatch );
+        for( unsigned int k=0 ; k<patch->all_MPI_neighbor_.size() ; k++ ) {
+            int rank = patch->all_MPI_neighbor_[k];
+            if( rank != MPI_PROC_NULL && rank != smilei_rk
+                && find( exchange.ranks.begin(), exchange.ranks.end(), rank ) == exchange.ranks.end() ) {
+                exchange.ranks.push_back( rank );
+            }
+        }
+    }
+    unsigned int nranks = exchange.ranks.size();
+    exchange.send_buffers.resize( nranks );
+    exchange.srequest.resize( nranks );
+
+    // Headers, and size of the messages
+    vector<vector<int>> headers( nranks, vector<int>( 1, 0 ) );
+    vector<size_t> bytes( nranks, 0 );
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        Patch *patch = vecPatches( ipatch );
+        SpeciesMPIbuffers &buffer = patch->vecSpecies[ispec]->MPI_buffer_;
+        for( unsigned int k=0 ; k<patch->all_MPI_neighbor_.size() ; k++ ) {
+            int rank = patch->all_MPI_neighbor_[k];
+            if( rank == MPI_PROC_NULL || rank == smilei_rk || buffer.partSendAll[k]->size() == 0 ) {
+                continue;
+            }
+            unsigned int irank = find( exchange.ranks.begin(), exchange.ranks.end(), rank ) - exchange.ranks.begin();
+            unsigned int iDim, iNeighbor;
+            Patch::directRecvBuffer( k, iDim, iNeighbor );
+            headers[irank][0]++;
+            headers[irank].push_back( patch->all_neighbor_[k] );
+            headers[irank].push_back( 2*iDim+iNeighbor );
+            headers[irank].push_back( buffer.partSendAll[k]->size() );
+            bytes[irank] += buffer.partSendAll[k]->packedSize( buffer.partSendAll[k]->size() );
+        }
+    }
+    vector<char *> data( nranks );
+    vector<size_t> offset( nranks, 0 );
+    vector<bool> shared( nranks, false );
+    for( unsigned int irank=0 ; irank<nranks ; irank++ ) {
+        bytes[irank] += headers[irank].size()*sizeof( int );
+        shared[irank] = window && window->onNode( exchange.ranks[irank] ) && bytes[irank] > direct_particle_notice_bytes_
+                        && window->reserve( bytes[irank], offset[irank] );
+        if( shared[irank] ) {
+            data[irank] = window->segment( smilei_rk ) + offset[irank];
+        } else {
+            exchange.send_buffers[irank].resize( bytes[irank] );
+            data[irank] = exchange.send_buffers[irank].data();
+        }
+        memcpy( data[irank], headers[irank].data(), headers[irank].size()*sizeof( int ) );
+        data[irank] += headers[irank].size()*sizeof( int );
+    }
+
+    // Particles, in the same order as the headers
+    for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+        Patch *patch = vecPatches( ipatch );
+        SpeciesMPIbuffers &buffer = patch->vecSpecies[ispec]->MPI_buffer_;
+        for( unsigned int k=0 ; k<patch->all_MPI_neighbor_.size() ; k++ ) {
+            int rank = patch->all_MPI_neighbor_[k];
+            if( rank == MPI_PROC_NULL || rank == smilei_rk || buffer.partSendAll[k]->size() == 0 ) {
+                continue;
+            }
+            unsigned int irank = find( exchange.ranks.begin(), exchange.ranks.end(), rank ) - exchange.ranks.begin();
+            data[irank] = buffer.partSendAll[k]->packParticles( data[irank] );
+        }
+    }
+
+    // Notices of the messages written in shared memory
+    bool any_shared = false;
+    for( unsigned int irank=0 ; irank<nranks ; irank++ ) {
+        if( shared[irank] ) {
+            int notice = -1;
+            uint64_t location[2] = { offset[irank], bytes[irank] };
+            exchange.send_buffers[irank].resize( direct_particle_notice_bytes_ );
+            memcpy( exchange.send_buffers[irank].data(), &notice, sizeof( int ) );
+            memcpy( exchange.send_buffers[irank].data() + sizeof( int ), location, sizeof( location ) );
+            any_shared = true;
+        }
+    }
+    if( any_shared ) {
+        window->sync();
+    }
+
+    for( unsigned int irank=0 ; irank<nranks ; irank++ ) {
+        MPI_Isend( exchange.send_buffers[irank].data(), exchange.send_buffers[irank].size(), MPI_BYTE,
+                   exchange.ranks[irank], ispec, particle_exchange_comm_, &exchange.srequest[irank] );
+        if( shared[irank] ) {
+            shared_particle_acks_.push_back( MPI_REQUEST_NULL );
+            MPI_Irecv( NULL, 0, MPI_BYTE, exchange.ranks[irank], direct_particle_ack_tag_, particle_exchange_comm_, &shared_particle_acks_.back() );
+        }
+    }
+
+} // END isendDirectParticles
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Receive the messages of isendDirectParticles, in their order of arrival, and append each block of particles
+// to the receive buffer of its destination patch
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::recvDirectParticles( VectorPatch &vecPatches, int ispec )
+{
+    DirectParticleMPIbuffers &exchange = direct_particle_buffers_[ispec];
+
+    // The messages are unpacked in a fixed order of the ranks, so that the particle order
+    // does not depend on their arrival times
+    for( unsigned int imessage=0 ; imessage<exchange.ranks.size() ; imessage++ ) {
+        MPI_Status status;
+        MPI_Probe( exchange.ranks[imessage], ispec, particle_exchange_comm_, &status );
+        int size;
+        MPI_Get_count( &status, MPI_BYTE, &size );
+        exchange.recv_buffer.resize( size );
+        MPI_Recv( exchange.recv_buffer.data(), size, MPI_BYTE, status.MPI_SOURCE, ispec, particle_exchange_comm_, MPI_STATUS_IGNORE );
+
+        const char *message = exchange.recv_buffer.data();
+        bool shared = reinterpret_cast<const int *>( message )[0] < 0;
+        if( shared ) {
+            // The message is read in place, in the shared memory of the sender
+            uint64_t location[2];
+            memcpy( location, message + sizeof( int ), sizeof( location ) );
+            shared_particle_window_->sync();
+            message = shared_particle_window_->segment( status.MPI_SOURCE ) + location[0];
+        }
+
+        const int *header = reinterpret_cast<const int *>( message );
+        int nblocks = header[0];
+        const char *data = message + ( 1+3*nblocks )*sizeof( int );
+        for( int iblock=0 ; iblock<nblocks ; iblock++ ) {
+            int hindex    = header[1+3*iblock];
+            int direction = header[2+3*iblock];
+            int npart     = header[3+3*iblock];
+            SpeciesMPIbuffers &buffer = vecPatches( hindex - vecPatches.refHindex_ )->vecSpecies[ispec]->MPI_buffer_;
+            data = buffer.partRecv[direction/2][direction%2]->unpackParticles( data, npart );
+        }
+
+        if( shared ) {
+            shared_particle_acks_.push_back( MPI_REQUEST_NULL );
+            MPI_Isend( NULL, 0, MPI_BYTE, status.MPI_SOURCE, direct_particle_ack_tag_, particle_exchange_comm_, &shared_particle_acks_.back() );
+        }
+    }
+
+    MPI_Waitall( exchange.srequest.size(), exchange.srequest.data(), MPI_STATUSES_IGNORE );
+
+} // END recvDirectParticles
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 // -----------------------------------------       PATCH SEND / RECV METHODS        ------------------------------------
@@ -2272,7 +2741,7 @@ void SmileiMPI::isend( ProbeParticles *probe, int to, int tag, unsigned int nDim
     // send particles
     if( nPart>0 )
         for( unsigned int i=0; i<nDim_particles; i++ ) {
-            MPI_Isend( &( probe->particles.Position[i][0] ), nPart, MPI_DOUBLE, to, tag+1+i, MPI_COMM_WORLD, &request );
+            MPI_Isend( &( probe->particles.Position[i][0] ), nPart, SMILEI_MPI_PARTICLE_REAL, to, tag+1+i, MPI_COMM_WORLD, &request );
         }
 
 } // End isend ( probes )
@@ -2291,7 +2760,7 @@ void SmileiMPI::recv( ProbeParticles *probe, int from, int tag, unsigned int nDi
     // receive particles
     if( nPart>0 )
         for( unsigned int i=0; i<nDim_particles; i++ ) {
-            MPI_Recv( &( probe->particles.Position[i][0] ), nPart, MPI_DOUBLE, from, tag+1+i, MPI_COMM_WORLD, &status );
+            MPI_Recv( &( probe->particles.Position[i][0] ), nPart, SMILEI_MPI_PARTICLE_REAL, from, tag+1+i, MPI_COMM_WORLD, &status );
         }
 
 } // End recv ( probes )
@@ -2473,6 +2942,91 @@ void SmileiMPI::computeGlobalDiags(DiagnosticRadiationSpectrum* diagRad, int iti
 // Buffer management
 // ---------------------------------------------------------------------------------------------------------------------
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Arenas of the dynamics buffers: each buffer id owns one arena, in which all its buffers are sub-spans
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::attachDynamicsBuffers()
+{
+#if !defined( SMILEI_ACCELERATOR_GPU_OMP ) && !defined( SMILEI_ACCELERATOR_GPU_OACC )
+    unsigned int n_buffers = dynamics_Epart.size();
+    // Arenas are kept when the number of buffers decreases, to be reused later
+    for( unsigned int i=dynamics_arena.size() ; i<n_buffers ; i++ ) {
+        dynamics_arena.push_back( new DynamicsArena() );
+    }
+    for( unsigned int i=0 ; i<n_buffers ; i++ ) {
+        DynamicsArena *arena = dynamics_arena[i];
+        arena->attach( &dynamics_Epart[i] );
+        arena->attach( &dynamics_Bpart[i] );
+        arena->attach( &dynamics_external_Bpart[i] );
+        arena->attach( &dynamics_invgf[i] );
+        arena->attach( &dynamics_iold[i] );
+        arena->attach( &dynamics_deltaold[i] );
+        if( i < dynamics_Bpart_yBTIS3.size() ) {
+            arena->attach( &dynamics_Bpart_yBTIS3[i] );
+            arena->attach( &dynamics_Bpart_zBTIS3[i] );
+        }
+        if( i < dynamics_eithetaold.size() ) {
+            arena->attach( &dynamics_eithetaold[i] );
+        }
+        if( i < dynamics_GradPHIpart.size() ) {
+            arena->attach( &dynamics_GradPHIpart[i] );
+            arena->attach( &dynamics_GradPHI_mpart[i] );
+            arena->attach( &dynamics_PHIpart[i] );
+            arena->attach( &dynamics_PHI_mpart[i] );
+            arena->attach( &dynamics_inv_gamma_ponderomotive[i] );
+        }
+        if( i < dynamics_EnvEabs_part.size() ) {
+            arena->attach( &dynamics_EnvEabs_part[i] );
+            arena->attach( &dynamics_EnvExabs_part[i] );
+        }
+    }
+#endif
+}
+
+void SmileiMPI::reserveDynamicsBuffers( int ithread, int ndim_field, int npart, bool isAM )
+{
+#if !defined( SMILEI_ACCELERATOR_GPU_OMP ) && !defined( SMILEI_ACCELERATOR_GPU_OACC )
+    // Only the capacities are requested here: the arena grows at most once
+    dynamics_Epart[ithread].request( 3*npart );
+    dynamics_Bpart[ithread].request( 3*npart );
+    dynamics_external_Bpart[ithread].request( 3*npart );
+    dynamics_invgf[ithread].request( npart );
+    dynamics_iold[ithread].request( ndim_field*npart );
+    dynamics_deltaold[ithread].request( ndim_field*npart );
+    if( use_BTIS3 ) {
+        dynamics_Bpart_yBTIS3[ithread].request( npart );
+        dynamics_Bpart_zBTIS3[ithread].request( npart );
+    }
+    if( isAM ) {
+        dynamics_eithetaold[ithread].request( npart );
+    }
+    if( dynamics_GradPHIpart.size() > 0 ) {
+        dynamics_GradPHIpart[ithread].request( 3*npart );
+        dynamics_GradPHI_mpart[ithread].request( 3*npart );
+        dynamics_PHIpart[ithread].request( npart );
+        dynamics_PHI_mpart[ithread].request( npart );
+        dynamics_inv_gamma_ponderomotive[ithread].request( npart );
+        if( dynamics_EnvEabs_part.size() > 0 ) {
+            dynamics_EnvEabs_part[ithread].request( npart );
+            dynamics_EnvExabs_part[ithread].request( npart );
+        }
+    }
+    dynamics_arena[ithread]->grow();
+#endif
+}
+
+void SmileiMPI::getDynamicsArenaStatistics( double &bytes, double &allocations, double &resizes )
+{
+    bytes = 0.;
+    allocations = 0.;
+    resizes = 0.;
+    for( unsigned int i=0 ; i<dynamics_arena.size() ; i++ ) {
+        bytes       += ( double ) dynamics_arena[i]->bytes();
+        allocations += ( double ) dynamics_arena[i]->allocations();
+        resizes     += ( double ) dynamics_arena[i]->resizes();
+    }
+}
+
 //! Erase Particles from istart ot the end in the buffers of thread ithread
 void SmileiMPI::eraseBufferParticleTrail( const int ndim, const int istart, const int ithread, bool isAM )
 {
@@ -10,6 +10,9 @@
 #include "Particles.h"
 #include "Tools.h"
 #include "gpu.h"
+#include "DynamicsArena.h"
+#include "AsyncMPIbuffers.h"
+#include "SharedMemoryWindow.h"
 
 class Params;
 class Species;
@@ -36,9 +39,11 @@ class SmileiMPI
     friend class VectorPatch;
     friend class SimWindow;
     friend class AsyncMPIbuffers;
+    friend class AggregatedFieldMPIbuffers;
 
 public:
-    SmileiMPI() {};
+    SmileiMPI() : particle_exchange_comm_( MPI_COMM_NULL ), field_exchange_comm_( MPI_COMM_NULL ), field_exchange_epoch_( 0 ),
+        shared_field_window_( NULL ), shared_particle_window_( NULL ), max_sum_op_( MPI_OP_NULL ), max_sum_type_( MPI_DATATYPE_NULL ) {};
     //! Create intial MPI environment
     SmileiMPI( int *argc, char ***argv );
     //! Destructor for SmileiMPI
@@ -58,12 +63,40 @@ public:
 
     // Recompute the patch_count vector. Browse patches and redistribute them in order to balance the load between MPI processes.
     void recompute_patch_count( Params &params, VectorPatch &vecpatches, double time_dual );
+    // Node-aware version of the patch distribution computed by recompute_patch_count (LoadBalancing.hierarchical)
+    int node_aware_patch_count( Params &params, std::vector<double> &Lp, double Tload, int &internode_moves );
     // Returns the rank of the MPI process currently owning patch h.
     int hrank( int h );
+    //! Largest value and sum of the values over all processes, in a single reduction
+    void maxAndSum( double value, double &max, double &sum );
 
     // Create MPI type to exchange all particles properties of particles
     MPI_Datatype createMPIparticles( Particles *particles );
 
+    // Direct exchange of particles (Main.particle_exchange="direct"):
+    //     - one message per neighbouring MPI process, counts included
+    // -----------------------------------
+    //! Pack the particles leaving towards other MPI processes and send them
+    void isendDirectParticles( VectorPatch &vecPatches, int ispec );
+    //! Receive the particles from the neighbouring MPI processes into the patches receive buffers
+    void recvDirectParticles( VectorPatch &vecPatches, int ispec );
+
+    //! True if the ghost regions of the fields are exchanged with one message per neighbouring MPI process
+    //! (Main.field_exchange="aggregated"), see AggregatedFieldMPIbuffers
+    inline bool aggregatedFieldExchange() const
+    {
+        return field_exchange_comm_ != MPI_COMM_NULL;
+    }
+    //! Start a new topology epoch: the persistent requests of the aggregated field exchanges are rebuilt
+    //! at their next use. To be called whenever patches move between processes (load balancing, moving window)
+    inline void invalidateFieldExchanges()
+    {
+        field_exchange_epoch_++;
+    }
+    //! Shared memory of the aggregated field exchanges (Main.shared_memory_exchange), NULL if not used.
+    //! Reallocated at the first call of each topology epoch: all processes must call it at the same point
+    SharedMemoryWindow *sharedFieldWindow();
+
 
     // PATCH SEND / RECV METHODS
     //     - during load balancing process
@@ -209,37 +242,53 @@ public:
     // Global buffers for vectorization of Species::dynamics
     // -----------------------------------------------------
 
+    //! One memory arena per dynamics buffer id, hosting all the buffers below.
+    //! Growing the arena moves all the buffers of its id: it only happens in
+    //! reserveDynamicsBuffers (called by resizeBuffers), which invalidates any pointer
+    //! into these buffers. A resize beyond the reserved capacity is an error.
+    std::vector<DynamicsArena *> dynamics_arena;
+
     //! value of the Efield
-    std::vector<std::vector<double>> dynamics_Epart;
+    std::vector<dynamics_buffer<double>> dynamics_Epart;
     //! value of the Bfield
-    std::vector<std::vector<double>> dynamics_Bpart;
+    std::vector<dynamics_buffer<double>> dynamics_Bpart;
     //! value of the ExtBfield
-    std::vector<std::vector<double>> dynamics_external_Bpart;
+    std::vector<dynamics_buffer<double>> dynamics_external_Bpart;
     //! gamma factor
-    std::vector<std::vector<double>> dynamics_invgf;
+    std::vector<dynamics_buffer<double>> dynamics_invgf;
     //! iold_pos
-    std::vector<std::vector<int>> dynamics_iold;
+    std::vector<dynamics_buffer<int>> dynamics_iold;
     //! delta_old_pos
-    std::vector<std::vector<double>> dynamics_deltaold;
+    std::vector<dynamics_buffer<double>> dynamics_deltaold;
     //! theta old
-    std::vector<std::vector<std::complex<double>>> dynamics_eithetaold;
+    std::vector<dynamics_buffer<std::complex<double>>> dynamics_eithetaold;
     //! value of the By field for BTIS3
-    std::vector<std::vector<double>> dynamics_Bpart_yBTIS3;
+    std::vector<dynamics_buffer<double>> dynamics_Bpart_yBTIS3;
     //! value of the Bz field for BTIS3
-    std::vector<std::vector<double>> dynamics_Bpart_zBTIS3;
+    std::vector<dynamics_buffer<double>> dynamics_Bpart_zBTIS3;
 
     //! value of the grad(AA*) at itime and itime-1
-    std::vector<std::vector<double>> dynamics_GradPHIpart;
-    std::vector<std::vector<double>> dynamics_GradPHI_mpart;
+    std::vector<dynamics_buffer<double>> dynamics_GradPHIpart;
+    std::vector<dynamics_buffer<double>> dynamics_GradPHI_mpart;
     //! value of the AA* at itime and itime-1
-    std::vector<std::vector<double>> dynamics_PHIpart;
-    std::vector<std::vector<double>> dynamics_PHI_mpart;
+    std::vector<dynamics_buffer<double>> dynamics_PHIpart;
+    std::vector<dynamics_buffer<double>> dynamics_PHI_mpart;
     //! inverse of the ponderomotive gamma, used in susceptibility and ponderomotive momentum Pusher
-    std::vector<std::vector<double>> dynamics_inv_gamma_ponderomotive;
+    std::vector<dynamics_buffer<double>> dynamics_inv_gamma_ponderomotive;
     //! value of the EnvEabs used for envelope ionization
-    std::vector<std::vector<double>> dynamics_EnvEabs_part;
+    std::vector<dynamics_buffer<double>> dynamics_EnvEabs_part;
     //! value of the EnvEabs used for envelope ionization
-    std::vector<std::vector<double>> dynamics_EnvExabs_part;
+    std::vector<dynamics_buffer<double>> dynamics_EnvExabs_part;
+
+    //! Host the dynamics buffers of each buffer id in its arena (after the
+    //! vectors of buffers have been resized)
+    void attachDynamicsBuffers();
+
+    //! Grow the arena of buffer ithread once for all the buffers resized by resizeBuffers
+    void reserveDynamicsBuffers( int ithread, int ndim_field, int npart, bool isAM );
+
+    //! Sum the statistics of all the arenas of this process
+    void getDynamicsArenaStatistics( double &bytes, double &allocations, double &resizes );
 
     //! Return buffer size in thread ithread
     inline int __attribute__((always_inline)) getBufferSize(const int ithread)
@@ -273,6 +322,7 @@ public:
 
     inline void resizeBuffers( int ithread, int ndim_field, int npart, bool isAM = false )
     {
+        reserveDynamicsBuffers( ithread, ndim_field, npart, isAM );
         dynamics_Epart[ithread].resize( 3*npart );
         dynamics_Bpart[ithread].resize( 3*npart );
         dynamics_external_Bpart[ithread].resize( 3*npart );
@@ -329,11 +379,13 @@ public:
                 dynamics_EnvExabs_part.resize( n_buffers );
             }
         }
+        attachDynamicsBuffers();
     }
 
     // Resize buffers to avoid memory leak with tasks
     inline void reduceDynamicsBufferSize( int buffer_id, bool isAM = false )
     {
+        reserveDynamicsBuffers( buffer_id, 1, 1, isAM );
         dynamics_Epart[buffer_id].resize( 1 );
         dynamics_Bpart[buffer_id].resize( 1 );
         dynamics_external_Bpart[buffer_id].resize( 1 );
@@ -364,6 +416,7 @@ public:
     // Resize buffers for old properties only
     inline void resizeOldPropertiesBuffer( int ithread, int ndim_field, int npart, bool isAM = false )
     {
+        reserveDynamicsBuffers( ithread, ndim_field, npart, isAM );
         dynamics_iold[ithread].resize( ndim_field*npart );
         dynamics_deltaold[ithread].resize( ndim_field*npart );
         if( isAM ) {
@@ -412,6 +465,39 @@ public:
 protected:
     //! Global MPI Communicator
     MPI_Comm world_;
+    //! Communicator of the direct particle exchange, duplicated from world_ so that
+    //! its messages (tagged by species) never match the patch exchanges
+    MPI_Comm particle_exchange_comm_;
+    //! Buffers of the direct particle exchange, one per species
+    std::vector<DirectParticleMPIbuffers> direct_particle_buffers_;
+    //! Communicator of the aggregated field exchanges, duplicated from world_ so that
+    //! its messages (tagged by dimension) never match the per-patch exchanges
+    MPI_Comm field_exchange_comm_;
+    //! Topology epoch of the aggregated field exchanges
+    int field_exchange_epoch_;
+
+    //! Shared memory windows between the processes of a node (Main.shared_memory_exchange)
+    //!     - for the aggregated field exchanges, allocated for one topology epoch
+    SharedMemoryWindow *shared_field_window_;
+    int shared_field_window_epoch_;
+    //!     - for the direct particle exchange, reused at each exchange round (all species)
+    SharedMemoryWindow *shared_particle_window_;
+    int shared_particle_window_epoch_;
+    //! Initial size of the segments, from the size of the ghost regions
+    std::size_t shared_window_bytes_;
+    //! Last species sent by isendDirectParticles: a lower or equal one starts a new round
+    int last_direct_particle_species_;
+    //! Notifications that the particles written in shared memory were read (received), or that
+    //! the particles of the other processes were read (sent). Completed at the next round
+    std::vector<MPI_Request> shared_particle_acks_;
+    //! Tag of these notifications
+    static const int direct_particle_ack_tag_ = 32767;
+    //! Size of the notice sent instead of a message written in shared memory: -1, offset, size
+    static const std::size_t direct_particle_notice_bytes_ = sizeof( int ) + 2*sizeof( uint64_t );
+
+    //! Reduction of maxAndSum, on pairs of doubles (created at first use)
+    MPI_Op max_sum_op_;
+    MPI_Datatype max_sum_type_;
 
     //! Number of MPI process in the current communicator
     int smilei_sz;
@@ -432,6 +518,8 @@ protected:
     //Number of patches owned by each mpi process.
     std::vector<int>  patch_count, capabilities, patch_refHindexes;
     int Tcapabilities; //Default = smilei_sz (1 per MPI rank)
+    //! First rank of the node of each rank, for the hierarchical load balancing
+    std::vector<int> node_first_rank_;
 };
 
 
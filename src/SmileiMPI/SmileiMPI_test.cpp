@@ -118,6 +118,7 @@ void SmileiMPI_test::init( Params &params, DomainDecomposition *domain_decomposi
     dynamics_invgf.resize( 1 );
     dynamics_iold.resize( 1 );
     dynamics_deltaold.resize( 1 );
+    attachDynamicsBuffers();
 
     // Set periodicity of the simulated problem
     periods_  = new int[params.nDim_field];
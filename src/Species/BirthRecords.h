@@ -12,7 +12,6 @@ struct BirthRecords
 {
     BirthRecords( Particles &source_particles ) {
         p_.initialize( 0, source_particles );
-        p_.double_prop_.push_back( &birth_time_ ); // the birth time is the last property
     };
     void clear() {
         birth_time_.resize( 0 );
@@ -29,6 +28,7 @@ struct BirthRecords
         }
     }
     
+    //! Kept in double precision, out of the particle properties, whatever particle_real
     std::vector<double> birth_time_;
     Particles p_;
 };
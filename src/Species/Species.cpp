@@ -25,6 +25,7 @@
 #include "PartWall.h"
 #include "ParticleCreator.h"
 #include "ParticlesFactory.h"
+#include "ParticleExpression.h"
 #include "Patch.h"
 #include "Profile.h"
 #include "Projector.h"
@@ -49,6 +50,7 @@ using namespace std;
 Species::Species( Params &params, Patch *patch ) :
     c_part_max_( 1 ),
     ionization_rate_( Py_None ),
+    ionization_rate_expression_( NULL ),
     pusher_name_( "boris" ),
     radiation_model_( "none" ),
     time_frozen_( 0 ),
@@ -381,6 +383,11 @@ void Species::initOperators( Params &params, Patch *patch )
             MPI_buffer_.partSend[iDim][iNeighbor]->initialize( 0, ( *particles ) );
         }
     }
+    for( unsigned int k=0 ; k<MPI_buffer_.partSendAll.size() ; k++ ) {
+        if( MPI_buffer_.partSendAll[k] ) {
+            MPI_buffer_.partSendAll[k]->initialize( 0, ( *particles ) );
+        }
+    }
     typePartSend.resize( nDim_field*2, MPI_DATATYPE_NULL );
     typePartRecv.resize( nDim_field*2, MPI_DATATYPE_NULL );
     exchangePatch = MPI_DATATYPE_NULL;
@@ -416,6 +423,7 @@ Species::~Species()
     if( ionization_rate_!=Py_None ) {
         Py_DECREF( ionization_rate_ );
     }
+    delete ionization_rate_expression_;
     delete radiated_photons_;
     for (int k=0 ; k<2 ; k++) {
         delete mBW_pair_particles_[k];
@@ -1134,7 +1142,7 @@ void Species::dynamicsTasks( double time_dual, unsigned int ispec,
                     bJz         = NULL;
                 }
 
-                vector<double> *Epart = &( smpi->dynamics_Epart[buffer_id] );
+                dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[buffer_id] );
                 Ionize->ionizationTunnelWithTasks( particles, particles->first_index[ibin], particles->last_index[ibin], Epart, patch, Proj, ibin, ibin*cluster_width_, bJx, bJy, bJz );
                 smpi->traceEventIfDiagTracing(diag_PartEventTracing, Tools::getOMPThreadNum(),1,5);
 
@@ -2214,20 +2222,20 @@ void Species::compress(SmileiMPI *smpi, int ithread, bool compute_cell_keys) {
 
 #ifdef SMILEI_ACCELERATOR_GPU_OACC
 
-    double *const __restrict__ weight =  particles->getPtrWeight();
+    particle_real *const __restrict__ weight =  particles->getPtrWeight();
 
-    double *const __restrict__ position_x = particles->getPtrPosition( 0 );
-    double *const __restrict__ position_y = nDim_particle > 1 ? particles->getPtrPosition( 1 ) : nullptr;
-    double *const __restrict__ position_z = nDim_particle > 2 ? particles->getPtrPosition( 2 ) : nullptr;
+    particle_real *const __restrict__ position_x = particles->getPtrPosition( 0 );
+    particle_real *const __restrict__ position_y = nDim_particle > 1 ? particles->getPtrPosition( 1 ) : nullptr;
+    particle_real *const __restrict__ position_z = nDim_particle > 2 ? particles->getPtrPosition( 2 ) : nullptr;
 
-    double *const __restrict__ momentum_x = particles->getPtrMomentum(0);
-    double *const __restrict__ momentum_y = particles->getPtrMomentum(1);
-    double *const __restrict__ momentum_z = particles->getPtrMomentum(2);
+    particle_real *const __restrict__ momentum_x = particles->getPtrMomentum(0);
+    particle_real *const __restrict__ momentum_y = particles->getPtrMomentum(1);
+    particle_real *const __restrict__ momentum_z = particles->getPtrMomentum(2);
 
     short *const __restrict__ charge = particles->getPtrCharge();
 
-    double *const __restrict__ chi = particles->getPtrChi();
-    double *const __restrict__ tau = particles->getPtrTau();
+    particle_real *const __restrict__ chi = particles->getPtrChi();
+    particle_real *const __restrict__ tau = particles->getPtrTau();
 #endif
 
     double *const __restrict__ Ex = &( ( smpi->dynamics_Epart[ithread] )[0*nparts] );
@@ -2433,21 +2441,21 @@ void Species::removeTaggedParticlesPerBin(
     const int nparts = smpi->getBufferSize(ithread);
 
     // Weight shortcut
-    double *const __restrict__ weight =  particles->getPtrWeight();
+    particle_real *const __restrict__ weight =  particles->getPtrWeight();
 
 #ifdef SMILEI_ACCELERATOR_GPU_OACC
-    double *const __restrict__ position_x = particles->getPtrPosition( 0 );
-    double *const __restrict__ position_y = nDim_particle > 1 ? particles->getPtrPosition( 1 ) : nullptr;
-    double *const __restrict__ position_z = nDim_particle > 2 ? particles->getPtrPosition( 2 ) : nullptr;
+    particle_real *const __restrict__ position_x = particles->getPtrPosition( 0 );
+    particle_real *const __restrict__ position_y = nDim_particle > 1 ? particles->getPtrPosition( 1 ) : nullptr;
+    particle_real *const __restrict__ position_z = nDim_particle > 2 ? particles->getPtrPosition( 2 ) : nullptr;
 
-    double *const __restrict__ momentum_x = particles->getPtrMomentum(0);
-    double *const __restrict__ momentum_y = particles->getPtrMomentum(1);
-    double *const __restrict__ momentum_z = particles->getPtrMomentum(2);
+    particle_real *const __restrict__ momentum_x = particles->getPtrMomentum(0);
+    particle_real *const __restrict__ momentum_y = particles->getPtrMomentum(1);
+    particle_real *const __restrict__ momentum_z = particles->getPtrMomentum(2);
 
     short *const __restrict__ charge = particles->getPtrCharge();
 
-    double *const __restrict__ chi = particles->getPtrChi();
-    double *const __restrict__ tau = particles->getPtrTau();
+    particle_real *const __restrict__ chi = particles->getPtrChi();
+    particle_real *const __restrict__ tau = particles->getPtrTau();
 #endif
 
     // Total number of bins / cells
@@ -2593,20 +2601,20 @@ void Species::removeTaggedParticles(
     const int nparts_thetaold = nparts * (thetaold ? 1: 0);
 
     // Weight shortcut
-    double *const __restrict__ weight =  particles->getPtrWeight();
+    particle_real *const __restrict__ weight =  particles->getPtrWeight();
 
-    double *const __restrict__ position_x = particles->getPtrPosition( 0 );
-    double *const __restrict__ position_y = nDim_particle > 1 ? particles->getPtrPosition( 1 ) : nullptr;
-    double *const __restrict__ position_z = nDim_particle > 2 ? particles->getPtrPosition( 2 ) : nullptr;
+    particle_real *const __restrict__ position_x = particles->getPtrPosition( 0 );
+    particle_real *const __restrict__ position_y = nDim_particle > 1 ? particles->getPtrPosition( 1 ) : nullptr;
+    particle_real *const __restrict__ position_z = nDim_particle > 2 ? particles->getPtrPosition( 2 ) : nullptr;
 
-    double *const __restrict__ momentum_x = particles->getPtrMomentum(0);
-    double *const __restrict__ momentum_y = particles->getPtrMomentum(1);
-    double *const __restrict__ momentum_z = particles->getPtrMomentum(2);
+    particle_real *const __restrict__ momentum_x = particles->getPtrMomentum(0);
+    particle_real *const __restrict__ momentum_y = particles->getPtrMomentum(1);
+    particle_real *const __restrict__ momentum_z = particles->getPtrMomentum(2);
 
     short *const __restrict__ charge = particles->getPtrCharge();
 
-    double *const __restrict__ chi = particles->has_quantum_parameter ? particles->getPtrChi() : nullptr;
-    double *const __restrict__ tau = particles->has_Monte_Carlo_process ? particles->getPtrTau() : nullptr;
+    particle_real *const __restrict__ chi = particles->has_quantum_parameter ? particles->getPtrChi() : nullptr;
+    particle_real *const __restrict__ tau = particles->has_Monte_Carlo_process ? particles->getPtrTau() : nullptr;
 
     // Only if there are particles
     if( nparts > 0 ) {
@@ -2840,10 +2848,10 @@ void Species::ponderomotiveUpdateSusceptibilityAndMomentum( double time_dual,
 #endif
 
                 smpi->traceEventIfDiagTracing(diag_PartEventTracing, Tools::getOMPThreadNum(),0,5);
-                vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-                vector<double> *EnvEabs_part = &( smpi->dynamics_EnvEabs_part[ithread] );
-                vector<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
-                vector<double> *Phipart = &( smpi->dynamics_PHIpart[ithread] );
+                dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+                dynamics_buffer<double> *EnvEabs_part = &( smpi->dynamics_EnvEabs_part[ithread] );
+                dynamics_buffer<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
+                dynamics_buffer<double> *Phipart = &( smpi->dynamics_PHIpart[ithread] );
                 Interp->envelopeFieldForIonization( EMfields, *particles, smpi, &( particles->first_index[ibin] ), &( particles->last_index[ibin] ), ithread );
                 Ionize->envelopeIonization( particles, particles->first_index[ibin], particles->last_index[ibin], Epart, EnvEabs_part, EnvExabs_part, Phipart, patch, Proj );
                 smpi->traceEventIfDiagTracing(diag_PartEventTracing, Tools::getOMPThreadNum(),1,5);
@@ -2968,10 +2976,10 @@ void Species::ponderomotiveUpdateSusceptibilityAndMomentumTasks( double time_dua
 #endif
 
                 smpi->traceEventIfDiagTracing(diag_PartEventTracing, Tools::getOMPThreadNum(),0,5);
-                vector<double> *Epart = &( smpi->dynamics_Epart[buffer_id] );
-                vector<double> *EnvEabs_part = &( smpi->dynamics_EnvEabs_part[buffer_id] );
-                vector<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[buffer_id] );
-                vector<double> *Phipart = &( smpi->dynamics_PHIpart[buffer_id] );
+                dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[buffer_id] );
+                dynamics_buffer<double> *EnvEabs_part = &( smpi->dynamics_EnvEabs_part[buffer_id] );
+                dynamics_buffer<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[buffer_id] );
+                dynamics_buffer<double> *Phipart = &( smpi->dynamics_PHIpart[buffer_id] );
                 Interp->envelopeFieldForIonization( EMfields, *particles, smpi, &( particles->first_index[ibin] ), &( particles->last_index[ibin] ), buffer_id );
                 Ionize->envelopeIonization( particles, particles->first_index[ibin], particles->last_index[ibin], Epart, EnvEabs_part, EnvExabs_part, Phipart, patch, Proj, 0 );
                 smpi->traceEventIfDiagTracing(diag_PartEventTracing, Tools::getOMPThreadNum(),0,5);
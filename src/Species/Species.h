@@ -37,6 +37,7 @@ class SimWindow;
 class Radiation;
 class Merging;
 class PartCompTime;
+class ParticleExpression;
 
 
 //! class Species
@@ -82,6 +83,9 @@ public:
     //! user defined ionization rate profile
     PyObject *ionization_rate_;
 
+    //! native version of the ionization rate (NULL if it must be evaluated by python)
+    ParticleExpression *ionization_rate_expression_;
+
     //! thermalizing temperature for thermalizing BCs [\f$m_e c^2\f$]
     std::vector<double> thermal_boundary_temperature_;
     //! mean velocity used when thermalizing BCs are used [\f$c\f$]
@@ -540,7 +544,7 @@ public:
             speciesSize += sizeof ( unsigned int );*/
         //speciesSize *= getNbrOfParticles();
         std::size_t speciesSize = 0;
-        speciesSize += particles->double_prop_.size()*sizeof( double );
+        speciesSize += particles->double_prop_.size()*sizeof( particle_real );
         speciesSize += particles->short_prop_.size()*sizeof( short );
         speciesSize += particles->uint64_prop_.size()*sizeof( uint64_t );
         speciesSize *= getParticlesCapacity();
@@ -26,6 +26,7 @@
 #include "Patch.h"
 
 #include "ParticleData.h"
+#include "ParticleExpression.h"
 
 #include "ParticleCreator.h"
 
@@ -971,6 +972,11 @@ public:
             LINK_NAMELIST + std::string("#species") );
         }
 
+        // A simple ionization rate is evaluated natively, without python
+        if( this_species->ionization_rate_ != Py_None ) {
+            this_species->ionization_rate_expression_ = ParticleExpression::create( this_species->ionization_rate_, params.nDim_particle, this_species->particles, false, "ionization_rate" );
+        }
+
         return this_species;
     } // End Species* create()
 
@@ -1033,6 +1039,9 @@ public:
         if( new_species->ionization_rate_!=Py_None ) {
             Py_INCREF( new_species->ionization_rate_ );
         }
+        if( species->ionization_rate_expression_ ) {
+            new_species->ionization_rate_expression_ = new ParticleExpression( *species->ionization_rate_expression_ );
+        }
         new_species->ionization_model_                        = species->ionization_model_;
         new_species->geometry                                 = species->geometry;
         new_species->Nbins                                    = species->Nbins;
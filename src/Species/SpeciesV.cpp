@@ -49,6 +49,7 @@ SpeciesV::SpeciesV( Params &params, Patch *patch ) :
     initCluster( params, patch );
     npack_ = 0 ;
     packsize_ = 0;
+    in_place_known_ = false;
 
     for (unsigned int idim=0; idim < params.nDim_field; idim++){
         distance[idim] = &Species::cartesian_distance;
@@ -115,6 +116,8 @@ void SpeciesV::initCluster( Params &params, Patch *patch )
     particles->last_index.resize( ncells, 0 );
     particles->first_index.resize( ncells, 0 );
     count.resize( ncells, 0 );
+    in_place_start_.resize( ncells, -1 );
+    in_place_end_.resize( ncells, -1 );
 
     //Size in each dimension of the buffers on which each bin are projected
     //In 1D the particles of a given bin can be projected on 6 different nodes at the second order (oversize = 2)
@@ -275,6 +278,8 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
     int tid( 0 );
     std::vector<double> nrj_lost_per_thd( 1, 0. );
 
+    in_place_known_ = false;
+
     // -------------------------------
     // calculate the particle dynamics
     // -------------------------------
@@ -282,7 +287,7 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
 
         //Point to local thread dedicated buffers
         //Still needed for ionization
-        vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+        dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
 
         // Prepare particles buffers for multiphoton Breit-Wheeler
         if( Multiphoton_Breit_Wheeler_process ) {
@@ -583,6 +588,8 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
                                      &count[0],
                                      particles->first_index[ipack*packsize_],
                                      particles->last_index[ipack*packsize_+packsize_-1] );
+            // Particles which stayed in their cell will not be scanned by the sort
+            findParticlesInPlace( ipack*packsize_, ( ipack+1 )*packsize_ );
             smpi->traceEventIfDiagTracing(diag_PartEventTracing, ithread,1,11);
             //START EXCHANGE PARTICLES OF THE CURRENT BIN ?
 
@@ -617,6 +624,8 @@ void SpeciesV::dynamics( double time_dual, unsigned int ispec,
                 nrj_bc_lost += nrj_lost_per_thd[tid];
             }
         } // End loop on packs
+
+        in_place_known_ = ( time_dual>time_frozen_ );
     } //End if moving or ionized particles
 
     if(time_dual <= time_frozen_ && diag_flag &&( !particles->is_test ) ) { //immobile particle (at the moment only project density)
@@ -809,7 +818,7 @@ void SpeciesV::dynamicsTasks( double time_dual, unsigned int ispec,
                     bJz         = NULL;
                 }
 
-                vector<double> *Epart = &( smpi->dynamics_Epart[buffer_id] );
+                dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[buffer_id] );
 
                 // Loop over scell is not performed since ionization operator is not vectorized
                 // Instead, it is applied to all particles in the cells pertaining to ibin
@@ -1401,6 +1410,20 @@ void SpeciesV::sortParticles( Params &params )
     //New total number of particles is stored as last element of particles->last_index
     particles->last_index[ncell-1] = particles->last_index[ncell-2] + count.back() ;
 
+    //Particles which did not change cell during the push, and which are still in the new range
+    //of their cell, are already sorted: they are never moved and the scans below skip them.
+    //Without this information, the whole range of each cell is scanned.
+    for( unsigned int ic=0; ic < ncell; ic++ ) {
+        if( in_place_known_ ) {
+            in_place_start_[ic] = max( in_place_start_[ic], particles->first_index[ic] );
+            in_place_end_[ic]   = min( in_place_end_[ic], particles->last_index[ic] );
+        }
+        if( !in_place_known_ || in_place_start_[ic] >= in_place_end_[ic] ) {
+            in_place_start_[ic] = -1;
+            in_place_end_[ic]   = -1;
+        }
+    }
+
     //Now proceed to the cycle sort
 
     if( MPI_buffer_.partRecv[0][0]->size() == 0 ) {
@@ -1421,19 +1444,13 @@ void SpeciesV::sortParticles( Params &params )
             for( unsigned int ip=0; ip < MPI_buffer_.partRecv[idim][ineighbor]->size(); ip++ ) {
                 cycle.resize( 1 );
                 cell_target = buf_cell_keys[idim][ineighbor][ip];
-                ip_dest = particles->first_index[cell_target];
-                while( particles->cell_keys[ip_dest] == cell_target ) {
-                    ip_dest++;
-                }
+                ip_dest = nextFreeSlot( cell_target, particles->first_index[cell_target] );
                 particles->first_index[cell_target] = ip_dest + 1 ;
                 cycle[0] = ip_dest;
                 cell_target = particles->cell_keys[ip_dest];
                 //As long as the particle is not erased, we can build up the cycle.
                 while( cell_target >= 0 ) {
-                    ip_dest = particles->first_index[cell_target];
-                    while( particles->cell_keys[ip_dest] == cell_target ) {
-                        ip_dest++;
-                    }
+                    ip_dest = nextFreeSlot( cell_target, particles->first_index[cell_target] );
                     particles->first_index[cell_target] = ip_dest + 1 ;
                     cycle.push_back( ip_dest );
                     cell_target = particles->cell_keys[ip_dest];
@@ -1459,11 +1476,7 @@ void SpeciesV::sortParticles( Params &params )
         //As long as the particle is not erased, we can build up the cycle.
         while( cell_target >= 0 ) {
 
-            ip_dest = particles->first_index[cell_target];
-
-            while( particles->cell_keys[ip_dest] == cell_target ) {
-                ip_dest++;
-            }
+            ip_dest = nextFreeSlot( cell_target, particles->first_index[cell_target] );
             particles->first_index[cell_target] = ip_dest + 1 ;
             cycle.push_back( ip_dest );
             cell_target = particles->cell_keys[ip_dest];
@@ -1481,6 +1494,13 @@ void SpeciesV::sortParticles( Params &params )
     //Loop over all cells
     for( int icell = 0 ; icell < ( int )ncell; icell++ ) {
         for( unsigned int ip=( unsigned int )particles->first_index[icell]; ip < ( unsigned int )particles->last_index[icell] ; ip++ ) {
+            //skip the particles which did not change cell
+            if( ( int )ip == in_place_start_[icell] ) {
+                ip = in_place_end_[icell];
+                if( ip == ( unsigned int )particles->last_index[icell] ) {
+                    break;
+                }
+            }
             //update value of current cell 'icell' if necessary
             //if particle changes cell, build a cycle of exchange as long as possible. Treats all particles
             if( particles->cell_keys[ip] != icell ) {
@@ -1490,10 +1510,7 @@ void SpeciesV::sortParticles( Params &params )
                 //While the destination particle is not going out of the patch or back to the initial cell, keep building the cycle.
                 while( particles->cell_keys[ip_src] != icell ) {
                     //Scan the next cell destination
-                    ip_dest = particles->first_index[particles->cell_keys[ip_src]];
-                    while( particles->cell_keys[ip_dest] == particles->cell_keys[ip_src] ) {
-                        ip_dest++;
-                    }
+                    ip_dest = nextFreeSlot( particles->cell_keys[ip_src], particles->first_index[particles->cell_keys[ip_src]] );
                     //In the destination cell, if a particle is going out of this cell, add it to the cycle.
                     particles->first_index[particles->cell_keys[ip_src]] = ip_dest + 1 ;
                     cycle.push_back( ip_dest );
@@ -1509,6 +1526,23 @@ void SpeciesV::sortParticles( Params &params )
     for( unsigned int ic=1; ic < ncell; ic++ ) {
         particles->first_index[ic] = particles->last_index[ic-1];
     }
+
+    in_place_known_ = false;
+}
+
+// Find, for each cell, the leading particles which are still in this cell after the push
+// (same cell keys as the cell index). Called right after the computation of the cell keys
+// of a pack, while they are in cache.
+void SpeciesV::findParticlesInPlace( unsigned int icell_start, unsigned int icell_end )
+{
+    for( unsigned int ic = icell_start; ic < icell_end; ic++ ) {
+        int ip = particles->first_index[ic];
+        while( ip < particles->last_index[ic] && particles->cell_keys[ip] == ( int )ic ) {
+            ip++;
+        }
+        in_place_start_[ic] = particles->first_index[ic];
+        in_place_end_[ic]   = ip;
+    }
 }
 
 // Compute particle cell_keys from istart to iend
@@ -1524,9 +1558,9 @@ void SpeciesV::computeParticleCellKeys( Params    & params,
 
     if (params.geometry == "AMcylindrical"){
 
-        const double *const __restrict__ position_x = particles->getPtrPosition(0);
-        const double *const __restrict__ position_y = particles->getPtrPosition(1);
-        const double *const __restrict__ position_z = particles->getPtrPosition(2);
+        const particle_real *const __restrict__ position_x = particles->getPtrPosition(0);
+        const particle_real *const __restrict__ position_y = particles->getPtrPosition(1);
+        const particle_real *const __restrict__ position_z = particles->getPtrPosition(2);
 
         double min_loc_l = std::round(min_loc_vec[0]*dx_inv_[0]);
         double min_loc_r = std::round(min_loc_vec[1]*dx_inv_[1]);
@@ -1543,9 +1577,9 @@ void SpeciesV::computeParticleCellKeys( Params    & params,
 
     } else if (nDim_field == 3) {
 
-        const double *const __restrict__ position_x = particles->getPtrPosition(0);
-        const double *const __restrict__ position_y = particles->getPtrPosition(1);
-        const double *const __restrict__ position_z = particles->getPtrPosition(2);
+        const particle_real *const __restrict__ position_x = particles->getPtrPosition(0);
+        const particle_real *const __restrict__ position_y = particles->getPtrPosition(1);
+        const particle_real *const __restrict__ position_z = particles->getPtrPosition(2);
 
         double min_loc_x = std::round (min_loc_vec[0] * dx_inv_[0]);
         double min_loc_y = std::round (min_loc_vec[1] * dx_inv_[1]);
@@ -1565,8 +1599,8 @@ void SpeciesV::computeParticleCellKeys( Params    & params,
 
     } else if (nDim_field == 2) {
 
-        const double *const __restrict__ position_x = particles->getPtrPosition(0);
-        const double *const __restrict__ position_y = particles->getPtrPosition(1);
+        const particle_real *const __restrict__ position_x = particles->getPtrPosition(0);
+        const particle_real *const __restrict__ position_y = particles->getPtrPosition(1);
 
         double min_loc_x = std::round (min_loc_vec[0] * dx_inv_[0]);
         double min_loc_y = std::round (min_loc_vec[1] * dx_inv_[1]);
@@ -1583,7 +1617,7 @@ void SpeciesV::computeParticleCellKeys( Params    & params,
         }
     } else if (nDim_field == 1) {
 
-        const double *const __restrict__ position_x = particles->getPtrPosition(0);
+        const particle_real *const __restrict__ position_x = particles->getPtrPosition(0);
 
         double min_loc_x = round (min_loc_vec[0] * dx_inv_[0]);
 
@@ -1618,6 +1652,9 @@ void SpeciesV::computeParticleCellKeys( Params &params )
 
     int * __restrict__ cell_keys  = particles->getPtrCellKeys();
 
+    // All the cell keys are recomputed: the particles in place are unknown
+    in_place_known_ = false;
+
     // Reinitialize count to 0
     for( unsigned int ic=0; ic < count.size() ; ic++ ) {
         count[ic] = 0 ;
@@ -1931,10 +1968,10 @@ void SpeciesV::ponderomotiveUpdateSusceptibilityAndMomentum( double time_dual,
 #ifdef  __DETAILED_TIMERS
                 timer = MPI_Wtime();
 #endif
-                vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-                vector<double> *EnvEabs_part  = &( smpi->dynamics_EnvEabs_part[ithread] );
-                vector<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
-                vector<double> *Phipart = &( smpi->dynamics_PHIpart[ithread] );
+                dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+                dynamics_buffer<double> *EnvEabs_part  = &( smpi->dynamics_EnvEabs_part[ithread] );
+                dynamics_buffer<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
+                dynamics_buffer<double> *Phipart = &( smpi->dynamics_PHIpart[ithread] );
 
                 smpi->traceEventIfDiagTracing(diag_PartEventTracing, ithread,0,5);
                 for( unsigned int scell = 0 ; scell < packsize_ ; scell++ ) {
@@ -2068,10 +2105,10 @@ void SpeciesV::ponderomotiveUpdateSusceptibilityAndMomentumTasks( double time_du
                 ithread = Tools::getOMPThreadNum();
                 timer = MPI_Wtime();
 #endif
-                vector<double> *Epart = &( smpi->dynamics_Epart[buffer_id] );
-                vector<double> *EnvEabs_part = &( smpi->dynamics_EnvEabs_part[buffer_id] );
-                vector<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[buffer_id] );
-                vector<double> *Phipart = &( smpi->dynamics_PHIpart[buffer_id] );
+                dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[buffer_id] );
+                dynamics_buffer<double> *EnvEabs_part = &( smpi->dynamics_EnvEabs_part[buffer_id] );
+                dynamics_buffer<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[buffer_id] );
+                dynamics_buffer<double> *Phipart = &( smpi->dynamics_PHIpart[buffer_id] );
 
                 smpi->traceEventIfDiagTracing(diag_PartEventTracing, Tools::getOMPThreadNum(),0,5);
                 Interp->envelopeFieldForIonization( EMfields, *particles, smpi, &( particles->first_index[first_cell_of_bin[ibin]] ), &( particles->last_index[last_cell_of_bin[ibin]] ), buffer_id );
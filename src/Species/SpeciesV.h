@@ -123,6 +123,31 @@ private:
     //! Size of the pack in number of particles
     unsigned int packsize_;
 
+    //! For each cell, range of slots [in_place_start_, in_place_end_) holding particles
+    //! which did not change cell during the last push (empty range when unknown).
+    //! sortParticles skips these slots instead of scanning their cell keys.
+    std::vector<int> in_place_start_;
+    std::vector<int> in_place_end_;
+    //! True between the computation of the cell keys in dynamics and the next sort
+    bool in_place_known_;
+
+    //! Find the leading particles of the cells icell_start to icell_end-1 which did not change cell
+    void findParticlesInPlace( unsigned int icell_start, unsigned int icell_end );
+
+    //! First slot from ip, in the range of cell icell, which does not hold a particle of this cell
+    inline int nextFreeSlot( int icell, int ip ) const
+    {
+        while( true ) {
+            if( ip == in_place_start_[icell] ) {
+                ip = in_place_end_[icell];
+            }
+            if( particles->cell_keys[ip] != icell ) {
+                return ip;
+            }
+            ip++;
+        }
+    }
+
     
     
 
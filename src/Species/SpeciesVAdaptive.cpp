@@ -95,7 +95,7 @@ void SpeciesVAdaptive::scalarDynamics( double time_dual, unsigned int ispec,
 
         //Point to local thread dedicated buffers
         //Still needed for ionization
-        vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+        dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
 
         //Prepare for sorting
         for( unsigned int i=0; i<count.size(); i++ ) {
@@ -503,7 +503,7 @@ void SpeciesVAdaptive::scalarDynamicsTasks( double time_dual, unsigned int ispec
                     bJz         = NULL;
                 }
 
-                vector<double> *Epart = &( smpi->dynamics_Epart[buffer_id] );
+                dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[buffer_id] );
 
                 // Loop over scell is not performed since ionization operator is not vectorized
                 // Instead, it is applied to all particles in the cells pertaining to ibin
@@ -1181,10 +1181,10 @@ void SpeciesVAdaptive::scalarPonderomotiveUpdateSusceptibilityAndMomentum( doubl
 #ifdef  __DETAILED_TIMERS
             timer = MPI_Wtime();
 #endif
-            vector<double> *Epart = &( smpi->dynamics_Epart[ithread] );
-            vector<double> *EnvEabs_part  = &( smpi->dynamics_EnvEabs_part[ithread] );
-            vector<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
-            vector<double> *Phipart = &( smpi->dynamics_PHIpart[ithread] );
+            dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[ithread] );
+            dynamics_buffer<double> *EnvEabs_part  = &( smpi->dynamics_EnvEabs_part[ithread] );
+            dynamics_buffer<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[ithread] );
+            dynamics_buffer<double> *Phipart = &( smpi->dynamics_PHIpart[ithread] );
 
             smpi->traceEventIfDiagTracing(diag_PartEventTracing, Tools::getOMPThreadNum(),0,5);
             Interp->envelopeFieldForIonization( EMfields, *particles, smpi, &( particles->first_index[0] ), &( particles->last_index[particles->last_index.size()-1] ), ithread );
@@ -1306,10 +1306,10 @@ void SpeciesVAdaptive::scalarPonderomotiveUpdateSusceptibilityAndMomentumTasks(
                 ithread = Tools::getOMPThreadNum();
                 timer = MPI_Wtime();
 #endif
-                vector<double> *Epart = &( smpi->dynamics_Epart[buffer_id] );
-                vector<double> *EnvEabs_part = &( smpi->dynamics_EnvEabs_part[buffer_id] );
-                vector<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[buffer_id] );
-                vector<double> *Phipart = &( smpi->dynamics_PHIpart[buffer_id] );
+                dynamics_buffer<double> *Epart = &( smpi->dynamics_Epart[buffer_id] );
+                dynamics_buffer<double> *EnvEabs_part = &( smpi->dynamics_EnvEabs_part[buffer_id] );
+                dynamics_buffer<double> *EnvExabs_part = &( smpi->dynamics_EnvExabs_part[buffer_id] );
+                dynamics_buffer<double> *Phipart = &( smpi->dynamics_PHIpart[buffer_id] );
 
                 smpi->traceEventIfDiagTracing(diag_PartEventTracing, Tools::getOMPThreadNum(),0,5);
                 Interp->envelopeFieldForIonization( EMfields, *particles, smpi, &( particles->first_index[first_cell_of_bin[ibin]] ), &( particles->last_index[last_cell_of_bin[ibin]] ), buffer_id );
@@ -1,13 +1,16 @@
 #include "H5.h"
+#include "PyTools.h"
 #include <iomanip>
+#include <cmath>
+#include <cstring>
 
 //! Open HDF5 file + location
-H5::H5( std::string file, unsigned access, MPI_Comm * comm, bool _raise )
+H5::H5( std::string file, unsigned access, MPI_Comm * comm, bool _raise, bool in_memory )
 {
-    init( file, access, comm, _raise );
+    init( file, access, comm, _raise, in_memory );
 }
 
-void H5::init( std::string file, unsigned access, MPI_Comm * comm, bool _raise )
+void H5::init( std::string file, unsigned access, MPI_Comm * comm, bool _raise, bool in_memory )
 {
     
     // Analyse file string : separate file name and tree inside hdf5 file
@@ -40,6 +43,9 @@ void H5::init( std::string file, unsigned access, MPI_Comm * comm, bool _raise )
     hid_t fapl = H5Pcreate( H5P_FILE_ACCESS );
     if( comm ) {
         H5Pset_fapl_mpio( fapl, *comm, MPI_INFO_NULL );
+    } else if( in_memory ) {
+        // Grows by blocks of 16 MB, without backing store
+        H5Pset_fapl_core( fapl, 16777216, 0 );
     }
     if( access == H5F_ACC_RDWR ) {
         fid_ = H5Fcreate( filepath_.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl );
@@ -168,3 +174,121 @@ H5Space::H5Space( std::vector<hsize_t> size, std::vector<hsize_t> offset, std::v
     }
     chunk_ = chunk;
 }
+
+
+H5Lossy::H5Lossy( std::string component, int icomponent, std::vector<std::string> names )
+    : relative_( false ), tolerance_( names.size(), 0. ), deflate_( 0 ), raw_bytes_( 0 ), stored_bytes_( 0 ), time_( 0. )
+{
+    std::string lossy = "";
+    bool has_lossy = PyTools::extractOrNone( "lossy", lossy, component, icomponent );
+    if( has_lossy ) {
+        if( lossy == "relative" ) {
+            relative_ = true;
+        } else if( lossy != "absolute" ) {
+            ERROR( component << "#" << icomponent << ": `lossy` should be None, \"relative\" or \"absolute\"" );
+        }
+        
+        // The tolerance is either a number, or a dictionary giving a number for some fields
+        PyObject *py_tolerance = PyTools::extract_py( "tolerance", component, icomponent );
+        if( PyDict_Check( py_tolerance ) ) {
+            PyObject *key, *value;
+            Py_ssize_t pos = 0;
+            while( PyDict_Next( py_tolerance, &pos, &key, &value ) ) {
+                std::string name;
+                if( ! PyTools::py2scalar( key, name ) ) {
+                    ERROR( component << "#" << icomponent << ": `tolerance` keys should be field names" );
+                }
+                std::vector<std::string>::iterator it = std::find( names.begin(), names.end(), name );
+                if( it == names.end() ) {
+                    ERROR( component << "#" << icomponent << ": `tolerance` for unknown field `" << name << "`" );
+                }
+                if( ! PyTools::py2scalar( value, tolerance_[it-names.begin()] ) ) {
+                    ERROR( component << "#" << icomponent << ": `tolerance` of `" << name << "` should be a float" );
+                }
+            }
+        } else {
+            double tolerance;
+            if( ! PyTools::py2scalar( py_tolerance, tolerance ) ) {
+                ERROR( component << "#" << icomponent << ": `tolerance` should be a float or a dict" );
+            }
+            tolerance_.assign( names.size(), tolerance );
+        }
+        Py_DECREF( py_tolerance );
+        for( unsigned int i=0; i<tolerance_.size(); i++ ) {
+            if( tolerance_[i] < 0. ) {
+                ERROR( component << "#" << icomponent << ": `tolerance` should be positive" );
+            }
+        }
+        
+        // Lossy rounding is only useful with a compression filter
+        deflate_ = 4;
+    }
+    PyTools::extractOrNone( "deflate", deflate_, component, icomponent );
+    deflate_ = std::min( std::max( deflate_, 0 ), 9 );
+    if( deflate_ > 0 && ( H5Zfilter_avail( H5Z_FILTER_DEFLATE ) <= 0 || H5Zfilter_avail( H5Z_FILTER_SHUFFLE ) <= 0 ) ) {
+        WARNING( component << "#" << icomponent << ": HDF5 has no deflate filter, data will not be compressed" );
+        deflate_ = 0;
+    }
+}
+
+// Rounding keeps a standard IEEE representation, but with many trailing zero bits
+void H5Lossy::round( double *v, size_t n, unsigned int i )
+{
+    double t0 = MPI_Wtime();
+    double tolerance = tolerance_[i];
+    if( tolerance > 0. && relative_ ) {
+        // Keep enough mantissa bits so that the relative error is below the tolerance
+        int keep = std::max( 0, ( int ) std::ceil( -std::log2( tolerance ) ) - 1 );
+        if( keep < 52 ) {
+            const uint64_t exponent = 0x7ff0000000000000ULL;
+            uint64_t drop = 52 - keep;
+            uint64_t half = ( uint64_t ) 1 << ( drop - 1 );
+            uint64_t mask = ~( ( ( uint64_t ) 1 << drop ) - 1 );
+            for( size_t j=0; j<n; j++ ) {
+                uint64_t u;
+                std::memcpy( &u, &v[j], sizeof( u ) );
+                if( ( u & exponent ) != exponent ) {
+                    u = ( u + half ) & mask;
+                }
+                std::memcpy( &v[j], &u, sizeof( u ) );
+            }
+        }
+    } else if( tolerance > 0. ) {
+        // Quantise to a power of two so that the absolute error is below the tolerance
+        double q = std::ldexp( 1., ( int ) std::floor( std::log2( 2. * tolerance ) ) );
+        double q_inv = 1. / q;
+        for( size_t j=0; j<n; j++ ) {
+            v[j] = q * std::nearbyint( v[j] * q_inv );
+        }
+    }
+    time_ += MPI_Wtime() - t0;
+}
+
+std::vector<hsize_t> H5Lossy::chunks( std::vector<hsize_t> dims )
+{
+    const hsize_t max_size = 1048576;
+    std::vector<hsize_t> chunk = dims;
+    hsize_t size = 1;
+    for( unsigned int i=0; i<chunk.size(); i++ ) {
+        chunk[i] = std::max( chunk[i], ( hsize_t ) 1 );
+        size *= chunk[i];
+    }
+    // Split the slowest dimensions first
+    for( unsigned int i=0; i<chunk.size() && size > max_size; i++ ) {
+        hsize_t others = size / chunk[i];
+        chunk[i] = std::max( max_size / others, ( hsize_t ) 1 );
+        size = others * chunk[i];
+    }
+    return chunk;
+}
+
+std::string H5Lossy::summary()
+{
+    std::ostringstream s;
+    s << std::setprecision( 3 ) << raw_bytes_/1048576. << " MB compressed to " << stored_bytes_/1048576. << " MB";
+    if( stored_bytes_ > 0 ) {
+        s << " (ratio " << ( double ) raw_bytes_ / stored_bytes_ << ")";
+    }
+    s << " in " << time_ << " s";
+    return s.str();
+}
@@ -5,6 +5,8 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <algorithm>
+#include <cstdint>
 #include "Tools.h"
 
 #if ! H5_HAVE_PARALLEL == 1
@@ -59,6 +61,45 @@ public:
     
 };
 
+//! Opt-in lossy compression of datasets. The data is first rounded within a tolerance,
+//! which makes the standard shuffle and deflate filters efficient. No plugin is needed to read it.
+class H5Lossy
+{
+public:
+    //! Read the options `lossy`, `tolerance` and `deflate` of a diagnostic, for its list of fields
+    H5Lossy( std::string component, int icomponent, std::vector<std::string> names );
+    
+    //! True if the datasets go through the filters
+    bool active() const
+    {
+        return deflate_ > 0;
+    }
+    
+    //! Round n values in place, to the tolerance of the field i
+    void round( double *v, size_t n, unsigned int i );
+    
+    //! Chunks of at most about 1M points, for a dataset without chunks
+    static std::vector<hsize_t> chunks( std::vector<hsize_t> dims );
+    
+    //! Summary of the total compression for this process
+    std::string summary();
+    
+    //! True for a relative tolerance (bit-rounding), false for an absolute one (quantisation)
+    bool relative_;
+    
+    //! Tolerance of each field (0 = lossless)
+    std::vector<double> tolerance_;
+    
+    //! Level of the deflate filter (0 = no compression)
+    int deflate_;
+    
+    //! Total size of the datasets before and after compression
+    uint64_t raw_bytes_, stored_bytes_;
+    
+    //! Time spent rounding and writing compressed datasets
+    double time_;
+};
+
 class H5
 {
 public:
@@ -71,11 +112,11 @@ public:
     };
     
     //! Open HDF5 file + location
-    H5( std::string file, unsigned access, MPI_Comm * comm, bool _raise );
+    H5( std::string file, unsigned access, MPI_Comm * comm, bool _raise, bool in_memory = false );
     
     ~H5();
     
-    void init( std::string file, unsigned access, MPI_Comm * comm, bool _raise );
+    void init( std::string file, unsigned access, MPI_Comm * comm, bool _raise, bool in_memory = false );
     
     bool valid() {
         return id_ >= 0;
@@ -132,19 +173,32 @@ public:
     H5Write( std::string file, MPI_Comm * comm = NULL, bool _raise = true )
      : H5( file, H5F_ACC_RDWR, comm, _raise ) {};
     
+    //! Create a file in memory, which HDF5 never writes to disk (see image)
+    H5Write( std::string file, MPI_Comm * comm, bool _raise, bool in_memory )
+     : H5( file, H5F_ACC_RDWR, comm, _raise, in_memory ) {};
+    
     //! Create group inside the given H5Write location
     H5Write( H5Write *loc, std::string group_name )
      : H5( loc->newGroupId( group_name ), loc->dcr_, loc->dxpl_ ) {};
     
     //! Create or open (not write) a dataset inside the given H5Write location
-    H5Write( H5Write *loc, std::string name, hid_t type, H5Space *filespace )
+    //! (with the shuffle and deflate filters if `lossy` is given)
+    H5Write( H5Write *loc, std::string name, hid_t type, H5Space *filespace, H5Lossy *lossy = NULL )
      : H5( -1, loc->dcr_, loc->dxpl_ )
     {
         H5D_layout_t layout = H5Pget_layout( dcr_ );
         if( ! filespace->chunk_.empty() ) {
             H5Pset_chunk( dcr_, filespace->chunk_.size(), &filespace->chunk_[0] );
         }
-        if( H5Lexists( loc->id_, name.c_str(), H5P_DEFAULT ) == 0 ) {
+        if( H5Lexists( loc->id_, name.c_str(), H5P_DEFAULT ) == 0 && lossy ) {
+            std::vector<hsize_t> chunk = filespace->chunk_.empty() ? H5Lossy::chunks( filespace->dims_ ) : filespace->chunk_;
+            hid_t dcr = H5Pcopy( dcr_ );
+            H5Pset_chunk( dcr, chunk.size(), &chunk[0] );
+            H5Pset_shuffle( dcr );
+            H5Pset_deflate( dcr, lossy->deflate_ );
+            id_  = H5Dcreate( loc->id_, name.c_str(), type, filespace->sid_, H5P_DEFAULT, dcr, H5P_DEFAULT );
+            H5Pclose( dcr );
+        } else if( H5Lexists( loc->id_, name.c_str(), H5P_DEFAULT ) == 0 ) {
             id_  = H5Dcreate( loc->id_, name.c_str(), type, filespace->sid_, H5P_DEFAULT, dcr_, H5P_DEFAULT );
         } else {
             hid_t pid = H5Pcreate( H5P_DATASET_ACCESS );
@@ -159,6 +213,17 @@ public:
     
     ~H5Write() {};
     
+    //! Copy the content of the file (created in memory) in a buffer, which may be written to disk as is
+    void image( std::vector<char> &buffer )
+    {
+        H5Fflush( fid_, H5F_SCOPE_GLOBAL );
+        ssize_t size = H5Fget_file_image( fid_, NULL, 0 );
+        buffer.resize( size > 0 ? size : 0 );
+        if( size <= 0 || H5Fget_file_image( fid_, &buffer[0], size ) != size ) {
+            ERROR( "Cannot get the image of file " << filepath_ );
+        }
+    }
+    
     //! Make or open a group
     H5Write group( std::string group_name )
     {
@@ -295,6 +360,12 @@ public:
         return vect( name, v[0], v.size(), H5T_NATIVE_DOUBLE, offset, npoints );
     }
     
+    //! write a vector<float>
+    H5Write vect( std::string name, std::vector<float> v, hsize_t offset=0, hsize_t npoints=0 )
+    {
+        return vect( name, v[0], v.size(), H5T_NATIVE_FLOAT, offset, npoints );
+    }
+    
     //! write any vector
     template<class T>
     H5Write vect( std::string name, std::vector<T> v, hid_t type, hsize_t offset=0, hsize_t npoints=0 )
@@ -336,10 +407,40 @@ public:
         return H5Write( did, dcr_, dxpl_ );
     }
     
+    //! Allow the file format of HDF5 1.10, where datasets made of a single chunk
+    //! are indexed without a B-tree (much smaller for the many per-patch datasets)
+    void allowFormatV110()
+    {
+#if H5_VERS_MAJOR > 1 || ( H5_VERS_MAJOR == 1 && ( H5_VERS_MINOR > 10 || ( H5_VERS_MINOR == 10 && H5_VERS_RELEASE >= 2 ) ) )
+        H5Fset_libver_bounds( fid_, H5F_LIBVER_V110, H5F_LIBVER_LATEST );
+#endif
+    }
+    
+    //! Write a vector compressed by the shuffle and deflate filters (size > 0)
+    template<class T>
+    H5Write compressedVect( std::string name, T &v, hsize_t size, hid_t type, int deflate )
+    {
+        // Below 1 kB, the filters cannot save more than the chunk metadata they require
+        if( size * H5Tget_size( type ) < 1024 ) {
+            return vect( name, v, ( int ) size, type );
+        }
+        hsize_t chunk = std::min( size, ( hsize_t ) 1048576 );
+        hid_t dcr = H5Pcopy( dcr_ );
+        H5Pset_chunk( dcr, 1, &chunk );
+        H5Pset_shuffle( dcr );
+        H5Pset_deflate( dcr, deflate );
+        hid_t filespace = H5Screate_simple( 1, &size, NULL );
+        hid_t did = H5Dcreate( id_, name.c_str(), type, filespace, H5P_DEFAULT, dcr, H5P_DEFAULT );
+        H5Dwrite( did, type, H5S_ALL, H5S_ALL, dxpl_, &v );
+        H5Sclose( filespace );
+        H5Pclose( dcr );
+        return H5Write( did, dcr_, dxpl_ );
+    }
+    
     //! Create or open (not write) a dataset
-    H5Write dataset( std::string name, hid_t type, H5Space *filespace )
+    H5Write dataset( std::string name, hid_t type, H5Space *filespace, H5Lossy *lossy = NULL )
     {
-        return H5Write( this, name, type, filespace );
+        return H5Write( this, name, type, filespace, lossy );
     }
     
     // Write to an open dataset
@@ -397,20 +498,33 @@ public:
     }
     
     //! Write a multi-dimensional array of doubles
-    H5Write array( std::string name, double &v, H5Space *filespace, H5Space *memspace, bool independent = false, hid_t file_type = -1 )
+    H5Write array( std::string name, double &v, H5Space *filespace, H5Space *memspace, bool independent = false, hid_t file_type = -1, H5Lossy *lossy = NULL )
     {
-        return array( name, v, H5T_NATIVE_DOUBLE, filespace, memspace, independent, file_type );
+        return array( name, v, H5T_NATIVE_DOUBLE, filespace, memspace, independent, file_type, lossy );
     }
     
-    //! Write a multi-dimensional array
+    //! Write a multi-dimensional array.
+    //! With an active `lossy`, the data (rounded beforehand) goes through the shuffle and deflate
+    //! filters, always collectively, and the sizes are stored as attributes.
     template<class T>
-    H5Write array( std::string name, T &v, hid_t mem_type, H5Space *filespace, H5Space *memspace, bool independent = false, hid_t file_type = -1 )
+    H5Write array( std::string name, T &v, hid_t mem_type, H5Space *filespace, H5Space *memspace, bool independent = false, hid_t file_type = -1, H5Lossy *lossy = NULL )
     {
         if( file_type < 0 ) {
             file_type = mem_type;
         }
-        H5Write d = dataset( name, file_type, filespace );
-        d.write( v, mem_type, filespace, memspace, independent );
+        bool compressed = lossy && lossy->active();
+        double t0 = compressed ? MPI_Wtime() : 0.;
+        H5Write d = dataset( name, file_type, filespace, compressed ? lossy : NULL );
+        d.write( v, mem_type, filespace, memspace, independent && ! compressed );
+        if( compressed ) {
+            uint64_t raw_bytes = filespace->global_ * H5Tget_size( file_type );
+            uint64_t stored_bytes = H5Dget_storage_size( d.id_ );
+            d.attr( "uncompressed_bytes", raw_bytes, H5T_NATIVE_UINT64 );
+            d.attr( "compressed_bytes", stored_bytes, H5T_NATIVE_UINT64 );
+            lossy->raw_bytes_ += raw_bytes;
+            lossy->stored_bytes_ += stored_bytes;
+            lossy->time_ += MPI_Wtime() - t0;
+        }
         return d;
     }
     
@@ -551,6 +665,12 @@ public:
         vect( vect_name, v, H5T_NATIVE_DOUBLE, resizeVect, offset, npoints );
     }
     
+    //! retrieve a float vector
+    void vect( std::string vect_name,  std::vector<float> &v, bool resizeVect=false, hsize_t offset=0, hsize_t npoints=0 )
+    {
+        vect( vect_name, v, H5T_NATIVE_FLOAT, resizeVect, offset, npoints );
+    }
+    
     //! retrieve an unsigned int vector
     void vect( std::string vect_name,  std::vector<unsigned int> &v, bool resizeVect=false, hsize_t offset=0, hsize_t npoints=0 )
     {
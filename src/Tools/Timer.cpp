@@ -57,6 +57,16 @@ void Timer::updateInTask( bool store )
     }
 }
 
+//! Accumulate a time measured outside of this timer
+void Timer::add( double time, bool store )
+{
+    time_acc_ += time;
+    if( store )
+    {
+        register_timers.push_back( time_acc_ );
+    }
+}
+
 
 #ifdef __DETAILED_TIMERS
 //!Accumulate time couting from last init/restart using patch detailed timers
@@ -70,6 +80,8 @@ void Timer::update( VectorPatch &vecPatches, bool store )
         for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ )
         {
             time_tmp += vecPatches( ipatch )->patch_timers_[this->patch_timer_id];
+            // Also accumulated per patch, for the measured load balancing
+            vecPatches( ipatch )->measured_load_ += vecPatches( ipatch )->patch_timers_[this->patch_timer_id];
             vecPatches( ipatch )->patch_timers_[this->patch_timer_id] = 0;
         }
         
@@ -113,6 +125,7 @@ void Timer::updateThreaded( VectorPatch &vecPatches, bool store )
             // Loop over the values stored in each thread
             for (int ithread = 0 ; ithread < vecPatches( ipatch )->number_of_threads_ ; ithread++) {
                 time_tmp += vecPatches( ipatch )->patch_timers_[this->patch_timer_id*vecPatches( ipatch )->number_of_threads_ + ithread];
+                vecPatches( ipatch )->measured_load_ += vecPatches( ipatch )->patch_timers_[this->patch_timer_id*vecPatches( ipatch )->number_of_threads_ + ithread];
                 vecPatches( ipatch )->patch_timers_[this->patch_timer_id*vecPatches( ipatch )->number_of_threads_ + ithread] = 0;
             }
         }
@@ -25,6 +25,9 @@ public:
     //! Accumulate time couting from last init/restart without omp master for tasking
     void updateInTask( bool store = false );
 
+    //! Accumulate a time measured outside of this timer
+    void add( double time, bool store = false );
+
     
 #ifdef __DETAILED_TIMERS
     //! Accumulate time couting from last init/restart using patch detailed timers
@@ -28,7 +28,8 @@ Timers::Timers( SmileiMPI *smpi ) :
     envelope( "Envelope" ),
     susceptibility( "Sync_Susceptibility" ),
     grids("Grids"),
-    densitiesCorrection("Dens Correction")
+    densitiesCorrection("Dens Correction"),
+    threadIdle( "Thread idle" )             // Part of Particles waited by the threads for each other
 #ifdef __DETAILED_TIMERS
     // Details of Dynamic
     , interpolator( "Interpolator" ),
@@ -52,6 +53,7 @@ Timers::Timers( SmileiMPI *smpi ) :
     timers.resize( 0 );
     timers.push_back( &global );
     timers.push_back( &particles );
+    timers.push_back( &threadIdle );
     timers.push_back( &maxwell );
     timers.push_back( &maxwellBC );
     timers.push_back( &diags );
@@ -140,7 +142,10 @@ void Timers::profile( SmileiMPI *smpi )
         // Computation of the coverage: it only takes into account
         // the main timers (14)
         for( unsigned int i=1 ; i<patch_timer_id_start+1 ; i++ ) {
-            coverage += timers[i]->getTime();
+            // The idle time of the threads is already included in Particles
+            if( timers[i] != &threadIdle ) {
+                coverage += timers[i]->getTime();
+            }
         }
         
         MESSAGE( "Time_in_time_loop\t" << global.getTime() << "\t"<<coverage/global.getTime()*100.<< "% coverage" );
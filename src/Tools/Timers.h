@@ -39,6 +39,7 @@ public:
     Timer susceptibility ;
     Timer grids ;
     Timer densitiesCorrection ;
+    Timer threadIdle ;
 #ifdef __DETAILED_TIMERS
     Timer interpolator  ;
     Timer pusher  ;